@@ -1,5 +1,5 @@
 aclocal
 autoconf
 automake --add-missing
-./configure
+./configure "$@"
 make all && make check
@@ -11,10 +11,11 @@
 namespace redgiant {
 
 template <typename DocTraits>
-BaseIndexImpl<DocTraits>::BaseIndexImpl(size_t initial_buckets)
+BaseIndexImpl<DocTraits>::BaseIndexImpl(size_t initial_buckets, FactorySelector factory_selector)
 : index_(1),
   // factory_ is for creating the wrapped posting list
-  factory_(new BTreePostingListFactory<DocId, TermWeight>()) {
+  factory_(new BTreePostingListFactory<DocId, TermWeight>()), factory_selector_(std::move(factory_selector)),
+  generation_(0) {
   // setting max_load_factor cause unorderd_map shrinks.
   // see https://gcc.gnu.org/bugzilla/show_bug.cgi?id=61667
   // so we have to call rehash() after called max_load_factor().
@@ -24,10 +25,11 @@ BaseIndexImpl<DocTraits>::BaseIndexImpl(size_t initial_buckets)
 
 template <typename DocTraits>
 template <typename Loader>
-BaseIndexImpl<DocTraits>::BaseIndexImpl(size_t initial_buckets, Loader&& loader)
+BaseIndexImpl<DocTraits>::BaseIndexImpl(size_t initial_buckets, Loader&& loader, FactorySelector factory_selector)
 : index_(1),
   // factory_ is for creating the wrapped posting list
-  factory_(new BTreePostingListFactory<DocId, TermWeight>()) {
+  factory_(new BTreePostingListFactory<DocId, TermWeight>()), factory_selector_(std::move(factory_selector)),
+  generation_(0) {
   // setting max_load_factor cause unorderd_map shrinks.
   // see https://gcc.gnu.org/bugzilla/show_bug.cgi?id=61667
   // so we have to call rehash() after called max_load_factor().
@@ -42,9 +44,11 @@ BaseIndexImpl<DocTraits>::BaseIndexImpl(size_t initial_buckets, Loader&& loader)
     TermId term_id;
     loader.load(term_id);
     // create a reader from the snapshot, and then create the posting list from the reader
-    index_[term_id] = factory_->create_posting_list(
+    const PListFactory& factory = get_factory(term_id);
+    std::shared_ptr<PList> plist = factory.create_posting_list(
         std::unique_ptr<PostingListReader<DocId, TermWeight>>(
             new SnapshotReader<DocId, TermWeight>(loader)));
+    index_[term_id] = factory.freeze_posting_list(std::move(plist));
   }
 }
 
@@ -81,6 +85,29 @@ auto BaseIndexImpl<DocTraits>::peek(TermId term_id) const
   return nullptr;
 }
 
+template <typename DocTraits>
+auto BaseIndexImpl<DocTraits>::batch_peek(const std::vector<TermId>& term_ids) const
+-> std::vector<std::unique_ptr<RawReader>> {
+  std::vector<std::shared_ptr<PList>> plists(term_ids.size());
+  {
+    shared_lock<shared_mutex> lock_query(query_mutex_);
+    for (size_t i = 0; i < term_ids.size(); ++i) {
+      auto iter = index_.find(term_ids[i]);
+      if (iter != index_.end()) {
+        plists[i] = iter->second;
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<RawReader>> readers(term_ids.size());
+  for (size_t i = 0; i < plists.size(); ++i) {
+    if (plists[i]) {
+      readers[i] = create_reader_shared(std::move(plists[i]));
+    }
+  }
+  return readers;
+}
+
 template <typename DocTraits>
 template <typename Score>
 auto BaseIndexImpl<DocTraits>::query(TermId term_id, const Query<Score>& query) const
@@ -121,18 +148,50 @@ auto BaseIndexImpl<DocTraits>::batch_query(const std::vector<QueryPair<Score>>&
   }
 
   // second, create query from the found terms
-  for (const auto& term: terms) {
+  // a term may have several readers if its posting list is split into tiers,
+  // and the scores of the tiers are added up as if they were different terms.
+  for (auto& term: terms) {
     // term.first->first: the term id
     // term.first->second: the query
     // term.second the posting list
-    std::unique_ptr<RawReader> reader = create_reader_shared(std::move(term.second));
-    if (reader) {
+    PList* plist = term.second.get();
+    for (auto& reader: plist->create_tier_readers(std::move(term.second))) {
       readers.emplace_back(term.first->first, term.first->second->query(std::move(reader)));
     }
   }
   return readers;
 }
 
+template <typename DocTraits>
+template <typename Score>
+auto BaseIndexImpl<DocTraits>::batch_query(const std::vector<QueryPair<Score>>& queries, size_t copies) const
+-> std::vector<std::vector<ReaderPair<Score>>>
+{
+  std::vector<std::vector<ReaderPair<Score>>> readers(copies);
+  std::vector<std::pair<const QueryPair<Score>*, std::shared_ptr<PList>>> terms;
+  terms.reserve(queries.size());
+
+  {
+    shared_lock<shared_mutex> lock_query(query_mutex_);
+    for (const auto& query: queries) {
+      auto iter = index_.find(query.first);
+      if (iter != index_.end()) {
+        terms.emplace_back(&query, iter->second);
+      }
+    }
+  }
+
+  for (auto& copy: readers) {
+    copy.reserve(queries.size());
+    for (auto& term: terms) {
+      for (auto& reader: term.second->create_tier_readers(term.second)) {
+        copy.emplace_back(term.first->first, term.first->second->query(std::move(reader)));
+      }
+    }
+  }
+  return readers;
+}
+
 template <typename DocTraits>
 auto BaseIndexImpl<DocTraits>::query_internal(TermId term_id)
 -> std::shared_ptr<PList> {
@@ -160,13 +219,13 @@ auto BaseIndexImpl<DocTraits>::change_internal(TermId term_id, bool create)
     if (plist) {
       // create from existing posting list
       std::shared_ptr<FreezablePList> fplist =
-          std::make_shared<FreezablePList>(*factory_, create_reader_shared(std::move(plist)));
+          std::make_shared<FreezablePList>(get_factory(term_id), create_reader_shared(std::move(plist)));
       changed_index_.insert(iter_changed, std::make_pair(term_id, fplist));
       return fplist;
     } else if (create) {
       // create an empty posting list
       std::shared_ptr<FreezablePList> fplist =
-          std::make_shared<FreezablePList>(*factory_);
+          std::make_shared<FreezablePList>(get_factory(term_id));
       changed_index_.insert(iter_changed, std::make_pair(term_id, fplist));
       return fplist;
     } else {
@@ -211,6 +270,10 @@ template <typename DocTraits>
 int BaseIndexImpl<DocTraits>::apply_internal() {
   int ret = 0;
   if (!changed_index_.empty()) {
+    // freeze before locking, since preparing the posting lists for reading may take a while
+    for (const auto& changed_pair: changed_index_) {
+      changed_pair.second->freeze();
+    }
     std::unique_lock<shared_mutex> wlock_query(query_mutex_);
     for (const auto& changed_pair: changed_index_) {
       auto iter = index_.find(changed_pair.first);
@@ -221,17 +284,16 @@ int BaseIndexImpl<DocTraits>::apply_internal() {
         }
         // update target
         else {
-          changed_pair.second->freeze();
           iter->second = changed_pair.second->get_instance();
         }
       }
       // target not found, need to add a new entry
       else {
-        changed_pair.second->freeze();
         index_.insert(iter, std::make_pair(changed_pair.first, changed_pair.second->get_instance()));
       }
       ++ret;
     }
+    generation_.fetch_add(1, std::memory_order_release);
   }
   changed_index_.clear();
   return ret;
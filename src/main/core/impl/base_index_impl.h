@@ -1,6 +1,9 @@
 #ifndef SRC_MAIN_CORE_IMPL_BASE_INDEX_IMPL_H_
 #define SRC_MAIN_CORE_IMPL_BASE_INDEX_IMPL_H_
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <utility>
@@ -37,6 +40,10 @@ public:
   typedef typename DocTraits::DocIdHash DocIdHash;
   typedef typename DocTraits::TermIdHash TermIdHash;
   typedef PostingListReader<DocId, const TermWeight&> RawReader;
+  typedef PostingListFactory<DocId, TermWeight> PListFactory;
+  // selects the factory creating the posting list of a term, returns null for the default one.
+  // the selected factory should live as long as the index.
+  typedef std::function<const PListFactory* (TermId)> FactorySelector;
 
   template <typename Score>
   using Query = PostingListQuery<DocId, Score, const TermWeight&>;
@@ -49,13 +56,13 @@ public:
   template <typename Score>
   using Results = std::vector<std::pair<DocId, Score>>;
 
-  BaseIndexImpl(size_t initial_buckets);
+  BaseIndexImpl(size_t initial_buckets, FactorySelector factory_selector = FactorySelector());
 
   // create from snapshot
   // may throw exception: std::ios_base::failure
   // Loader&& accepts both lvalues and rvalues (for temporarily constructed loader)
   template <typename Loader>
-  BaseIndexImpl(size_t initial_buckets, Loader&& loader);
+  BaseIndexImpl(size_t initial_buckets, Loader&& loader, FactorySelector factory_selector = FactorySelector());
 
   // g++ has bug with =default destructor for extern declared templates.
   ~BaseIndexImpl() { }
@@ -66,18 +73,37 @@ public:
 
   float get_load_factor() const;
 
+  // increased every time changes are applied, so that anything derived from
+  // the index content could tell whether it is still up to date.
+  uint64_t get_generation() const {
+    return generation_.load(std::memory_order_acquire);
+  }
+
   std::unique_ptr<RawReader> peek(TermId term_id) const;
 
+  // peek the terms from the same version of the index, null for the terms not found.
+  std::vector<std::unique_ptr<RawReader>> batch_peek(const std::vector<TermId>& term_ids) const;
+
   template <typename Score>
   std::unique_ptr<Reader<Score>> query(TermId term_id, const Query<Score>& query) const;
 
   template <typename Score>
   std::vector<ReaderPair<Score>> batch_query(const std::vector<QueryPair<Score>>& queries) const;
 
+  // query the terms for several times from the same posting lists, so that the readers of all copies
+  // read the same content, e.g. to be read by several threads.
+  template <typename Score>
+  std::vector<std::vector<ReaderPair<Score>>> batch_query(const std::vector<QueryPair<Score>>& queries,
+      size_t copies) const;
+
 protected:
   typedef PostingList<DocId, TermWeight> PList;
   typedef FreezablePostingList<DocId, TermWeight> FreezablePList;
-  typedef PostingListFactory<DocId, TermWeight> PListFactory;
+
+  const PListFactory& get_factory(TermId term_id) const {
+    const PListFactory* factory = factory_selector_ ? factory_selector_(term_id) : nullptr;
+    return factory ? *factory : *factory_;
+  }
 
   std::shared_ptr<PList> query_internal(TermId term_id);
 
@@ -105,6 +131,9 @@ protected:
   // protected by change_mutex_
   std::unordered_map<TermId, std::shared_ptr<FreezablePList>> changed_index_;
   std::unique_ptr<PListFactory> factory_;
+  FactorySelector factory_selector_;
+  // changed with query_mutex_ locked
+  std::atomic<uint64_t> generation_;
 };
 
 } /* namespace redgiant */
@@ -57,6 +57,13 @@ public:
     return expire_table_.size();
   }
 
+  /*
+   * -  Return the greatest doc_id in the expire table, or an invalid doc_id if empty
+   */
+  DocId max_doc_id() const {
+    return expire_map_.empty() ? DocId() : expire_map_.rbegin()->first;
+  }
+
   /*
    * -  Insert or update the specified doc_id with the specified expire_time.
    * -  Return 1 if update successfully. (normally shall return 1)
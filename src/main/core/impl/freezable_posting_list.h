@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "core/index/posting_list.h"
 #include "core/reader/posting_list_reader.h"
@@ -27,26 +28,26 @@ public:
   typedef typename Factory::ReaderByVal ReaderByVal;
   typedef typename Factory::ReaderByRef ReaderByRef;
 
-  // Create from the factory of internal posting list.
+  // Create from the factory of internal posting list. The factory should live as long as this object.
   FreezablePostingList(const Factory& factory, bool frozen = false)
-  : instance_(factory.create_posting_list()), frozen_(frozen) {
+  : instance_(factory.create_posting_list()), factory_(&factory), frozen_(frozen) {
   }
 
   // Create from the factory of internal posting list and an external reader.
   FreezablePostingList(const Factory& factory, std::unique_ptr<ReaderByVal> reader,
       bool frozen = false)
-  : instance_(factory.create_posting_list(std::move(reader))), frozen_(frozen)  {
+  : instance_(factory.create_posting_list(std::move(reader))), factory_(&factory), frozen_(frozen)  {
   }
 
   // Create from the factory of internal posting list and an external reader.
   FreezablePostingList(const Factory& factory, std::unique_ptr<ReaderByRef> reader,
       bool frozen = false)
-  : instance_(factory.create_posting_list(std::move(reader))), frozen_(frozen)  {
+  : instance_(factory.create_posting_list(std::move(reader))), factory_(&factory), frozen_(frozen)  {
   }
 
   // Create from a passed-in posting list.
   FreezablePostingList(std::shared_ptr<PList> plist, bool frozen = false)
-  : instance_(std::move(plist)), frozen_(frozen)  {
+  : instance_(std::move(plist)), factory_(nullptr), frozen_(frozen)  {
   }
 
   virtual ~FreezablePostingList() = default;
@@ -85,9 +86,26 @@ public:
     return create_reader_shared(instance_);
   }
 
+  // need external read lock, and the input shared_list is ignored.
+  virtual std::vector<std::unique_ptr<Reader>> create_tier_readers(std::shared_ptr<PList> shared_list) const {
+    (void) shared_list;
+    if (!frozen_) {
+      return std::vector<std::unique_ptr<Reader>>();
+    }
+    return instance_->create_tier_readers(instance_);
+  }
+
   // need external write lock
-  void freeze() {
-    frozen_ = true;
+  // the factory creating the wrapped posting list may convert it into another form for reading.
+  virtual void freeze() {
+    if (!frozen_) {
+      if (factory_) {
+        instance_ = factory_->freeze_posting_list(std::move(instance_));
+      } else {
+        instance_->freeze();
+      }
+      frozen_ = true;
+    }
   }
 
   // need external read lock
@@ -106,6 +124,8 @@ public:
 
 private:
   std::shared_ptr<PList> instance_;
+  // the factories live as long as the index
+  const Factory* factory_;
   bool frozen_;
 };
 } /* namespace redgiant */
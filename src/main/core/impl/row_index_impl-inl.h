@@ -7,8 +7,9 @@ namespace redgiant {
 
 template <typename DocTraits>
 template <typename Loader>
-RowIndexImpl<DocTraits>::RowIndexImpl(size_t initial_buckets, size_t max_size, Loader&& loader)
-: Base(initial_buckets, loader), max_size_(max_size), expire_(loader) {
+RowIndexImpl<DocTraits>::RowIndexImpl(size_t initial_buckets, size_t max_size, Loader&& loader,
+    FactorySelector factory_selector)
+: Base(initial_buckets, loader, std::move(factory_selector)), max_size_(max_size), expire_(loader) {
 
   load_docterm_internal(loader);
 }
@@ -19,6 +20,13 @@ size_t RowIndexImpl<DocTraits>::get_expire_table_size() const {
   return expire_.size();
 }
 
+template <typename DocTraits>
+auto RowIndexImpl<DocTraits>::get_max_doc_id() const
+-> DocId {
+  std::unique_lock<std::mutex> lock_change(change_mutex_);
+  return expire_.max_doc_id();
+}
+
 template <typename DocTraits>
 int RowIndexImpl<DocTraits>::update(DocId doc_id, const DocTerms& terms, ExpireTime expire_time) {
   int ret = 0;
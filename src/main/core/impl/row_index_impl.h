@@ -35,21 +35,25 @@ public:
   typedef std::pair<TermId, TermWeight> TermPair;
   typedef std::vector<TermPair> DocTerms;
   typedef std::tuple<DocId, DocTerms, ExpireTime> RowTuple;
+  typedef typename Base::FactorySelector FactorySelector;
 
-  RowIndexImpl(size_t initial_buckets, size_t max_size)
-  : Base(initial_buckets), max_size_(max_size) {
+  RowIndexImpl(size_t initial_buckets, size_t max_size, FactorySelector factory_selector = FactorySelector())
+  : Base(initial_buckets, std::move(factory_selector)), max_size_(max_size) {
   }
 
   // create from snapshot
   // may throw exception: std::ios_base::failure
   template <typename Loader>
-  RowIndexImpl(size_t initial_buckets, size_t max_size, Loader&& loader);
+  RowIndexImpl(size_t initial_buckets, size_t max_size, Loader&& loader,
+      FactorySelector factory_selector = FactorySelector());
 
   // gcc has bug with =default
   ~RowIndexImpl() { }
 
   size_t get_expire_table_size() const;
 
+  DocId get_max_doc_id() const;
+
   int update(DocId doc_id, const DocTerms& terms, ExpireTime expire_time);
 
   int batch_update(const std::vector<RowTuple>& batch);
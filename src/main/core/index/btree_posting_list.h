@@ -3,7 +3,9 @@
 
 #include <memory>
 #include <utility>
+#include "core/index/posting_head.h"
 #include "core/index/posting_list.h"
+#include "core/index/top_weights.h"
 #include "core/reader/algorithms.h"
 #include "core/reader/posting_list_reader.h"
 #include "core/reader/reader_utils.h"
@@ -52,6 +54,8 @@ public:
     }
     posting_[doc_id] = weight;
     merger_(upper_bound_, weight);
+    top_weights_.clear();
+    head_.clear();
     return 1;
   }
 
@@ -59,28 +63,39 @@ public:
     auto iter = posting_.find(doc_id);
     if (iter != posting_.end()) {
       posting_.erase(iter);
+      top_weights_.clear();
+      head_.clear();
       return 1;
     }
     return 0;
   }
 
+  virtual void freeze() {
+    top_weights_.build(posting_.begin(), posting_.end(), [] (const PostingPair& pair) { return pair.second; });
+    head_.build(posting_.begin(), posting_.end(), posting_.size());
+  }
+
   virtual std::unique_ptr<Reader> create_reader(std::shared_ptr<PList> shared_list) const;
 
 private:
   PostingMap posting_;
   Weight upper_bound_;
   WeightMerger merger_;
+  TopWeights<Weight> top_weights_;
+  PostingHead<DocId, Weight> head_;
 };
 
 template <typename DocId, typename Weight>
-class BTreePostingListReader: public PostingListReader<DocId, const Weight&> {
+class BTreePostingListReader final : public PostingListReader<DocId, const Weight&> {
 public:
   typedef PostingList<DocId, Weight> PList;
   typedef std::pair<DocId, Weight> PostingPair;
   typedef btree::btree_map<DocId, Weight> PostingMap;
 
-  BTreePostingListReader(const PostingMap& posting, const Weight& upper_bound, std::shared_ptr<PList> ref)
-  : ref_(std::move(ref)), posting_(&posting), upper_bound_(&upper_bound), iter_(posting_->begin()) {
+  BTreePostingListReader(const PostingMap& posting, const Weight& upper_bound, const TopWeights<Weight>& top_weights,
+      const PostingHead<DocId, Weight>& head, std::shared_ptr<PList> ref)
+  : ref_(std::move(ref)), posting_(&posting), upper_bound_(&upper_bound), top_weights_(&top_weights),
+    head_(&head), iter_(posting_->begin()) {
   }
 
   virtual ~BTreePostingListReader() = default;
@@ -98,6 +113,27 @@ public:
     return iter_->second;
   }
 
+  virtual size_t next_block(DocId current, DocId* doc_ids, Weight* weights, size_t max) {
+    if (max == 0 || !next(current)) {
+      return 0;
+    }
+    // walk along the leaves directly, and stop at the last item read.
+    size_t n = 0;
+    for (;;) {
+      doc_ids[n] = iter_->first;
+      weights[n] = iter_->second;
+      if (++n == max) {
+        break;
+      }
+      auto following = iter_;
+      if (++following == posting_->end()) {
+        break;
+      }
+      iter_ = following;
+    }
+    return n;
+  }
+
   virtual const Weight& upper_bound() {
     return *upper_bound_;
   }
@@ -106,11 +142,30 @@ public:
     return posting_->size();
   }
 
+  virtual bool estimate_kth_weight(size_t k, Weight& weight) {
+    if (k > 0 && k <= head_->size()) {
+      // exactly the k-th weight
+      weight = head_->data()[k - 1].second;
+      return true;
+    }
+    return top_weights_->get(k, weight);
+  }
+
+  virtual bool read_head(size_t k, std::vector<PostingPair>& head) {
+    if (k == 0 || k > head_->size()) {
+      return false;
+    }
+    head.assign(head_->data(), head_->data() + k);
+    return true;
+  }
+
 private:
   // Shared the lifetime with PostingList, make sure these values are always valid as long as reader valid.
   std::shared_ptr<PList> ref_;
   const PostingMap* posting_;
   const Weight* upper_bound_;
+  const TopWeights<Weight>* top_weights_;
+  const PostingHead<DocId, Weight>* head_;
   typename PostingMap::const_iterator iter_;
 };
 
@@ -120,7 +175,7 @@ auto BTreePostingList<DocId, Weight, WeightMerger>::create_reader(std::shared_pt
   // the parameters of reader constructor are pointers to the internal vector and upper bound weight,
   // these pointers shares the life time with posting_list so that they are always valid as long as the reader valid.
   return std::unique_ptr<Reader>(new BTreePostingListReader<DocId, Weight>(posting_, upper_bound_,
-      std::move(shared_list)));
+      top_weights_, head_, std::move(shared_list)));
 }
 
 template <typename DocId, typename Weight, typename WeightMerger = MaxWeight<Weight>>
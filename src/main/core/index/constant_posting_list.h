@@ -0,0 +1,194 @@
+#ifndef SRC_MAIN_CORE_INDEX_CONSTANT_POSTING_LIST_H_
+#define SRC_MAIN_CORE_INDEX_CONSTANT_POSTING_LIST_H_
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "core/index/doc_id_blocks.h"
+#include "core/index/posting_list.h"
+#include "core/index/sequential_posting_list.h"
+#include "core/reader/posting_list_reader.h"
+#include "core/reader/reader_utils.h"
+
+namespace redgiant {
+/*
+ * - A read-only posting list of which all postings have the same weight, e.g. features without weights.
+ * - Only the doc ids are stored, searched by blocks, see DocIdBlocks. The weight is stored once, which is
+ *   also the upper bound.
+ */
+template <typename DocId, typename Weight>
+class ConstantPostingList: public PostingList<DocId, Weight> {
+public:
+  typedef PostingList<DocId, Weight> Base;
+  typedef typename Base::PList PList;
+  typedef typename Base::Reader Reader;
+
+  ConstantPostingList()
+  : weight_() {
+  }
+
+  ConstantPostingList(std::vector<DocId> doc_ids, const Weight& weight)
+  : doc_ids_(std::move(doc_ids)), weight_(weight) {
+  }
+
+  virtual ~ConstantPostingList() = default;
+
+  virtual bool empty() const {
+    return doc_ids_.empty();
+  }
+
+  virtual int update(DocId doc_id, const Weight& weight) {
+    (void) doc_id;
+    (void) weight;
+    return 0;
+  }
+
+  virtual int remove(DocId doc_id) {
+    (void) doc_id;
+    return 0;
+  }
+
+  virtual std::unique_ptr<Reader> create_reader(std::shared_ptr<PList> shared_list) const;
+
+private:
+  DocIdBlocks<DocId> doc_ids_;
+  Weight weight_;
+};
+
+template <typename DocId, typename Weight>
+class ConstantPostingListReader final : public PostingListReader<DocId, const Weight&> {
+public:
+  typedef PostingList<DocId, Weight> PList;
+  typedef std::pair<DocId, Weight> PostingPair;
+
+  ConstantPostingListReader(const DocIdBlocks<DocId>& doc_ids, const Weight& weight, std::shared_ptr<PList> ref)
+  : ref_(std::move(ref)), doc_ids_(&doc_ids), weight_(&weight), pos_(0) {
+  }
+
+  virtual ~ConstantPostingListReader() = default;
+
+  virtual DocId next(DocId current) {
+    pos_ = doc_ids_->seek(pos_, current);
+    if (pos_ < doc_ids_->size()) {
+      return (*doc_ids_)[pos_];
+    }
+    return DocId(); // invalid
+  }
+
+  virtual const Weight& read() {
+    return *weight_;
+  }
+
+  virtual const Weight& upper_bound() {
+    return *weight_;
+  }
+
+  virtual size_t size() const {
+    return doc_ids_->size();
+  }
+
+  virtual size_t next_block(DocId current, DocId* doc_ids, Weight* weights, size_t max) {
+    if (max == 0 || !next(current)) {
+      return 0;
+    }
+    size_t n = std::min(max, doc_ids_->size() - pos_);
+    std::copy(doc_ids_->data() + pos_, doc_ids_->data() + (pos_ + n), doc_ids);
+    std::fill(weights, weights + n, *weight_);
+    pos_ += n - 1;
+    return n;
+  }
+
+  virtual bool estimate_kth_weight(size_t k, Weight& weight) {
+    if (k == 0 || k > doc_ids_->size()) {
+      return false;
+    }
+    // exactly the k-th weight
+    weight = *weight_;
+    return true;
+  }
+
+  // the earliest documents, the same as the head of other posting lists when the weights tie.
+  virtual bool read_head(size_t k, std::vector<PostingPair>& head) {
+    if (k == 0 || k > doc_ids_->size()) {
+      return false;
+    }
+    head.clear();
+    head.reserve(k);
+    for (size_t i = 0; i < k; ++i) {
+      head.emplace_back((*doc_ids_)[i], *weight_);
+    }
+    return true;
+  }
+
+private:
+  // Shared the lifetime with PostingList, make sure these values are always valid as long as reader valid.
+  std::shared_ptr<PList> ref_;
+  const DocIdBlocks<DocId>* doc_ids_;
+  const Weight* weight_;
+  size_t pos_;
+};
+
+template <typename DocId, typename Weight>
+auto ConstantPostingList<DocId, Weight>::create_reader(std::shared_ptr<PList> shared_list) const
+-> std::unique_ptr<Reader> {
+  return std::unique_ptr<Reader>(new ConstantPostingListReader<DocId, Weight>(doc_ids_, weight_,
+      std::move(shared_list)));
+}
+
+/*
+ * - Creates the posting lists by another factory, and converts them into constant posting lists when frozen
+ *   if all the postings have the same weight, or sequential posting lists otherwise.
+ * - See SequentialFreezingFactory for the changes after frozen.
+ */
+template <typename DocId, typename Weight>
+class ConstantFreezingFactory: public PostingListFactory<DocId, Weight> {
+public:
+  typedef PostingListFactory<DocId, Weight> Base;
+  typedef typename Base::PList PList;
+  typedef typename Base::ReaderByVal ReaderByVal;
+  typedef typename Base::ReaderByRef ReaderByRef;
+
+  explicit ConstantFreezingFactory(std::unique_ptr<Base> change_factory)
+  : change_factory_(std::move(change_factory)) {
+  }
+
+  virtual ~ConstantFreezingFactory() = default;
+
+  virtual std::shared_ptr<PList> create_posting_list() const {
+    return change_factory_->create_posting_list();
+  }
+
+  virtual std::shared_ptr<PList> create_posting_list(std::unique_ptr<ReaderByVal> reader) const {
+    return change_factory_->create_posting_list(std::move(reader));
+  }
+
+  virtual std::shared_ptr<PList> create_posting_list(std::unique_ptr<ReaderByRef> reader) const {
+    return change_factory_->create_posting_list(std::move(reader));
+  }
+
+  virtual std::shared_ptr<PList> freeze_posting_list(std::shared_ptr<PList> plist) const {
+    auto reader = create_reader_shared(plist);
+    if (!reader) {
+      return Base::freeze_posting_list(std::move(plist));
+    }
+    std::vector<DocId> doc_ids;
+    doc_ids.reserve(reader->size());
+    Weight weight = Weight();
+    for (DocId doc_id = reader->next(DocId()); !!doc_id; doc_id = reader->next(doc_id)) {
+      if (doc_ids.empty()) {
+        weight = reader->read();
+      } else if (!(reader->read() == weight)) {
+        return std::make_shared<SequentialPostingList<DocId, Weight>>(*create_reader_shared(plist));
+      }
+      doc_ids.push_back(doc_id);
+    }
+    return std::make_shared<ConstantPostingList<DocId, Weight>>(std::move(doc_ids), weight);
+  }
+
+private:
+  std::unique_ptr<Base> change_factory_;
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_CORE_INDEX_CONSTANT_POSTING_LIST_H_ */
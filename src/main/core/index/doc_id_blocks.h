@@ -0,0 +1,74 @@
+#ifndef SRC_MAIN_CORE_INDEX_DOC_ID_BLOCKS_H_
+#define SRC_MAIN_CORE_INDEX_DOC_ID_BLOCKS_H_
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "core/reader/algorithms.h"
+
+namespace redgiant {
+/*
+ * - The doc ids of a read-only posting list in an array, sorted in ascending order.
+ * - The doc ids are sampled every kSampleInterval postings. A search looks up the samples for the block of
+ *   the target first, then compares the doc ids of the block without branches.
+ */
+template <typename DocId>
+class DocIdBlocks {
+public:
+  // number of postings of a block, between two samples
+  static constexpr size_t kSampleInterval = 64;
+
+  DocIdBlocks() = default;
+
+  explicit DocIdBlocks(std::vector<DocId> doc_ids)
+  : doc_ids_(std::move(doc_ids)) {
+    doc_ids_.shrink_to_fit();
+    samples_.reserve(doc_ids_.size() / kSampleInterval + 1);
+    for (size_t i = 0; i < doc_ids_.size(); i += kSampleInterval) {
+      samples_.push_back(doc_ids_[i]);
+    }
+  }
+
+  bool empty() const {
+    return doc_ids_.empty();
+  }
+
+  size_t size() const {
+    return doc_ids_.size();
+  }
+
+  const DocId& operator[] (size_t pos) const {
+    return doc_ids_[pos];
+  }
+
+  const DocId* data() const {
+    return doc_ids_.data();
+  }
+
+  // the position of the first doc id greater than current, not before pos.
+  size_t seek(size_t pos, const DocId& current) const {
+    if (pos >= doc_ids_.size() || doc_ids_[pos] > current) {
+      // mostly the cursor itself, or the next posting
+      return pos;
+    }
+    // the block following the one of the target
+    size_t block = pos / kSampleInterval + 1;
+    if (block < samples_.size() && !(current < samples_[block])) {
+      block = std::upper_bound(samples_.begin() + block, samples_.end(), current) - samples_.begin();
+      pos = (block - 1) * kSampleInterval;
+    }
+    size_t end = std::min(doc_ids_.size(), block * kSampleInterval);
+    return pos + count_not_greater(doc_ids_.data() + pos, end - pos, current);
+  }
+
+private:
+  std::vector<DocId> doc_ids_;
+  // the first doc id of each block
+  std::vector<DocId> samples_;
+};
+
+template <typename DocId>
+constexpr size_t DocIdBlocks<DocId>::kSampleInterval;
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_CORE_INDEX_DOC_ID_BLOCKS_H_ */
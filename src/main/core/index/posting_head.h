@@ -0,0 +1,92 @@
+#ifndef SRC_MAIN_CORE_INDEX_POSTING_HEAD_H_
+#define SRC_MAIN_CORE_INDEX_POSTING_HEAD_H_
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace redgiant {
+/*
+ * The postings with the greatest weights of a posting list, sorted by weight in descending order,
+ * so that the top k postings are read without iterating the whole posting list.
+ * It is only kept for long posting lists, short ones are cheap enough to iterate.
+ * Weights which are not arithmetic types have no head.
+ */
+template <typename DocId, typename Weight, bool = std::is_arithmetic<Weight>::value>
+class PostingHead {
+public:
+  typedef std::pair<DocId, Weight> PostingPair;
+
+  template <typename Iterator>
+  void build(Iterator begin, Iterator end, size_t size) {
+    (void) begin;
+    (void) end;
+    (void) size;
+  }
+
+  void clear() {
+  }
+
+  size_t size() const {
+    return 0;
+  }
+
+  const PostingPair* data() const {
+    return nullptr;
+  }
+};
+
+template <typename DocId, typename Weight>
+class PostingHead<DocId, Weight, true> {
+public:
+  typedef std::pair<DocId, Weight> PostingPair;
+
+  // number of postings in the head
+  static constexpr size_t kHeadSize = 128;
+  // the least size of posting lists which keep a head
+  static constexpr size_t kMinListSize = 1024;
+
+  // build from the postings in [begin, end), sorted by doc id.
+  template <typename Iterator>
+  void build(Iterator begin, Iterator end, size_t size) {
+    if (size < kMinListSize) {
+      clear();
+      return;
+    }
+    std::vector<PostingPair> postings(begin, end);
+    // the earlier documents go first if weights tie
+    auto greater = [] (const PostingPair& lhs, const PostingPair& rhs) {
+      return lhs.second > rhs.second || (!(rhs.second > lhs.second) && lhs.first < rhs.first);
+    };
+    size_t head_size = std::min(postings.size(), kHeadSize);
+    std::partial_sort(postings.begin(), postings.begin() + head_size, postings.end(), greater);
+    postings.resize(head_size);
+    postings.shrink_to_fit();
+    head_.swap(postings);
+  }
+
+  void clear() {
+    std::vector<PostingPair>().swap(head_);
+  }
+
+  size_t size() const {
+    return head_.size();
+  }
+
+  const PostingPair* data() const {
+    return head_.data();
+  }
+
+private:
+  std::vector<PostingPair> head_;
+};
+
+template <typename DocId, typename Weight>
+constexpr size_t PostingHead<DocId, Weight, true>::kHeadSize;
+
+template <typename DocId, typename Weight>
+constexpr size_t PostingHead<DocId, Weight, true>::kMinListSize;
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_CORE_INDEX_POSTING_HEAD_H_ */
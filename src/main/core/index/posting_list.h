@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 #include "core/reader/posting_list_reader.h"
 
 namespace redgiant {
@@ -36,6 +37,14 @@ public:
    */
   virtual int remove(DocId doc_id) = 0;
 
+  /*
+   * -  Called when no more changes are expected, so that the posting list could prepare for reading, e.g. build
+   *    the estimations of weights. The default implementation does nothing.
+   * -  Changes are still allowed, but the prepared data may be dropped.
+   */
+  virtual void freeze() {
+  }
+
   /*
    * -  Create a PostingListReader class iterates over the contents of this object.
    * -  The PostingListReader hold pointers to contents of this object with a shared life time with the input
@@ -43,6 +52,21 @@ public:
    * -  It may also return null if the internal status is not ready to create a reader.
    */
   virtual std::unique_ptr<Reader> create_reader(std::shared_ptr<PList> shared_list) const = 0;
+
+  /*
+   * -  Create PostingListReader classes over the tiers of this object, if the postings are split into tiers by
+   *    weights. Each posting is read by exactly one of the readers, and each reader has its own upper bound, so
+   *    that the readers of low tiers could be skipped once they could not contribute enough.
+   * -  The same as create_reader() for the shared_list. By default there is only one tier read by create_reader().
+   */
+  virtual std::vector<std::unique_ptr<Reader>> create_tier_readers(std::shared_ptr<PList> shared_list) const {
+    std::vector<std::unique_ptr<Reader>> readers;
+    std::unique_ptr<Reader> reader = create_reader(std::move(shared_list));
+    if (reader) {
+      readers.push_back(std::move(reader));
+    }
+    return readers;
+  }
 };
 
 template <typename DocId, typename Weight>
@@ -70,6 +94,16 @@ public:
    * -  Create a posting list from the given by-ref reader and return by shared_ptr.
    */
   virtual std::shared_ptr<PList> create_posting_list(std::unique_ptr<ReaderByRef> reader) const = 0;
+
+  /*
+   * -  Freeze the posting list created by this factory, and return the posting list to read from then on. It may
+   *    be converted into another form for reading, since a frozen posting list is no longer changed.
+   * -  The default implementation freezes the posting list itself and returns it.
+   */
+  virtual std::shared_ptr<PList> freeze_posting_list(std::shared_ptr<PList> plist) const {
+    plist->freeze();
+    return plist;
+  }
 };
 } /* namespace redgiant */
 
@@ -0,0 +1,265 @@
+#ifndef SRC_MAIN_CORE_INDEX_QUANTIZED_POSTING_LIST_H_
+#define SRC_MAIN_CORE_INDEX_QUANTIZED_POSTING_LIST_H_
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "core/index/doc_id_blocks.h"
+#include "core/index/posting_head.h"
+#include "core/index/posting_list.h"
+#include "core/index/top_weights.h"
+#include "core/reader/posting_list_reader.h"
+#include "core/reader/reader_utils.h"
+
+namespace redgiant {
+/*
+ * - A read-only posting list of which the weights are quantized into integer codes, e.g. 8 or 16 bits, with a
+ *   scale for each posting list: weight = offset + code * scale, where scale is the least power of 2 by which
+ *   the range of the weights fits in the codes, and offset is the least weight rounded down to a multiple of scale.
+ * - The weights read are always the decoded ones, including the upper bound and the estimations, so that the
+ *   bounds are consistent with the scores. The doc ids are searched by blocks, see DocIdBlocks.
+ * - Changes start from the decoded weights, since the exact ones are not kept. The decoded weights are on the
+ *   grid of every finer scale, and the grids of coarser scales are nested, so quantizing them again does not
+ *   compound the errors: a weight is always within one scale (the greatest it has been quantized by) of the exact.
+ */
+template <typename DocId, typename Weight, typename Code>
+class QuantizedPostingList: public PostingList<DocId, Weight> {
+  static_assert(std::is_arithmetic<Weight>::value, "the weights must be arithmetic to be quantized");
+  static_assert(std::is_unsigned<Code>::value, "the codes must be unsigned integers");
+
+public:
+  typedef PostingList<DocId, Weight> Base;
+  typedef typename Base::PList PList;
+  typedef typename Base::Reader Reader;
+
+  QuantizedPostingList()
+  : offset_(), scale_(), upper_bound_() {
+  }
+
+  template <typename InputWeight>
+  explicit QuantizedPostingList(PostingListReader<DocId, InputWeight>& reader)
+  : offset_(), scale_(), upper_bound_() {
+    auto posting = read_all(reader);
+    if (posting.empty()) {
+      return;
+    }
+    auto less_weight = [] (const std::pair<DocId, Weight>& lhs, const std::pair<DocId, Weight>& rhs) {
+      return lhs.second < rhs.second;
+    };
+    Weight min_weight = std::min_element(posting.begin(), posting.end(), less_weight)->second;
+    Weight max_weight = std::max_element(posting.begin(), posting.end(), less_weight)->second;
+    set_scale(min_weight, max_weight);
+
+    std::vector<DocId> doc_ids;
+    doc_ids.reserve(posting.size());
+    codes_.reserve(posting.size());
+    for (auto& pair: posting) {
+      doc_ids.push_back(pair.first);
+      codes_.push_back(encode(pair.second));
+      // the decoded weights from now on
+      pair.second = decode(codes_.back());
+    }
+    doc_ids_ = DocIdBlocks<DocId>(std::move(doc_ids));
+    upper_bound_ = std::max_element(posting.begin(), posting.end(), less_weight)->second;
+    top_weights_.build(posting.begin(), posting.end(),
+        [] (const std::pair<DocId, Weight>& pair) { return pair.second; });
+    head_.build(posting.begin(), posting.end(), posting.size());
+  }
+
+  virtual ~QuantizedPostingList() = default;
+
+  virtual bool empty() const {
+    return doc_ids_.empty();
+  }
+
+  virtual int update(DocId doc_id, const Weight& weight) {
+    (void) doc_id;
+    (void) weight;
+    return 0;
+  }
+
+  virtual int remove(DocId doc_id) {
+    (void) doc_id;
+    return 0;
+  }
+
+  virtual std::unique_ptr<Reader> create_reader(std::shared_ptr<PList> shared_list) const;
+
+private:
+  void set_scale(const Weight& min_weight, const Weight& max_weight) {
+    if (!(max_weight > min_weight)) {
+      // all weights are exactly the offset
+      offset_ = min_weight;
+      scale_ = Weight();
+      return;
+    }
+    const double max_code = std::numeric_limits<Code>::max();
+    double scale = std::ldexp(1.0, (int)std::ceil(std::log2((max_weight - min_weight) / max_code)));
+    double offset = std::floor(min_weight / scale) * scale;
+    if ((max_weight - offset) / scale > max_code) {
+      // lost by rounding the offset down
+      scale *= 2;
+      offset = std::floor(min_weight / scale) * scale;
+    }
+    offset_ = offset;
+    scale_ = scale;
+  }
+
+  Code encode(const Weight& weight) const {
+    if (!(scale_ > 0)) {
+      return 0;
+    }
+    double code = std::round((weight - offset_) / scale_);
+    return (Code)std::min(std::max(code, 0.0), (double)std::numeric_limits<Code>::max());
+  }
+
+  Weight decode(Code code) const {
+    return offset_ + code * scale_;
+  }
+
+  DocIdBlocks<DocId> doc_ids_;
+  std::vector<Code> codes_;
+  Weight offset_;
+  Weight scale_;
+  Weight upper_bound_;
+  TopWeights<Weight> top_weights_;
+  PostingHead<DocId, Weight> head_;
+};
+
+template <typename DocId, typename Weight, typename Code>
+class QuantizedPostingListReader final : public PostingListReader<DocId, const Weight&> {
+public:
+  typedef PostingList<DocId, Weight> PList;
+  typedef std::pair<DocId, Weight> PostingPair;
+
+  QuantizedPostingListReader(const DocIdBlocks<DocId>& doc_ids, const std::vector<Code>& codes,
+      const Weight& offset, const Weight& scale, const Weight& upper_bound, const TopWeights<Weight>& top_weights,
+      const PostingHead<DocId, Weight>& head, std::shared_ptr<PList> ref)
+  : ref_(std::move(ref)), doc_ids_(&doc_ids), codes_(&codes), offset_(offset), scale_(scale),
+    upper_bound_(&upper_bound), top_weights_(&top_weights), head_(&head), pos_(0), weight_() {
+  }
+
+  virtual ~QuantizedPostingListReader() = default;
+
+  virtual DocId next(DocId current) {
+    pos_ = doc_ids_->seek(pos_, current);
+    if (pos_ < doc_ids_->size()) {
+      return (*doc_ids_)[pos_];
+    }
+    return DocId(); // invalid
+  }
+
+  // decoded into the reader, valid until the next read.
+  virtual const Weight& read() {
+    weight_ = offset_ + (*codes_)[pos_] * scale_;
+    return weight_;
+  }
+
+  virtual const Weight& upper_bound() {
+    return *upper_bound_;
+  }
+
+  virtual size_t size() const {
+    return doc_ids_->size();
+  }
+
+  virtual size_t next_block(DocId current, DocId* doc_ids, Weight* weights, size_t max) {
+    if (max == 0 || !next(current)) {
+      return 0;
+    }
+    size_t n = std::min(max, doc_ids_->size() - pos_);
+    std::copy(doc_ids_->data() + pos_, doc_ids_->data() + (pos_ + n), doc_ids);
+    const Code* codes = codes_->data() + pos_;
+    for (size_t i = 0; i < n; ++i) {
+      weights[i] = offset_ + codes[i] * scale_;
+    }
+    pos_ += n - 1;
+    return n;
+  }
+
+  virtual bool estimate_kth_weight(size_t k, Weight& weight) {
+    if (k > 0 && k <= head_->size()) {
+      // exactly the k-th weight
+      weight = head_->data()[k - 1].second;
+      return true;
+    }
+    return top_weights_->get(k, weight);
+  }
+
+  virtual bool read_head(size_t k, std::vector<PostingPair>& head) {
+    if (k == 0 || k > head_->size()) {
+      return false;
+    }
+    head.assign(head_->data(), head_->data() + k);
+    return true;
+  }
+
+private:
+  // Shared the lifetime with PostingList, make sure these values are always valid as long as reader valid.
+  std::shared_ptr<PList> ref_;
+  const DocIdBlocks<DocId>* doc_ids_;
+  const std::vector<Code>* codes_;
+  Weight offset_;
+  Weight scale_;
+  const Weight* upper_bound_;
+  const TopWeights<Weight>* top_weights_;
+  const PostingHead<DocId, Weight>* head_;
+  size_t pos_;
+  Weight weight_;
+};
+
+template <typename DocId, typename Weight, typename Code>
+auto QuantizedPostingList<DocId, Weight, Code>::create_reader(std::shared_ptr<PList> shared_list) const
+-> std::unique_ptr<Reader> {
+  return std::unique_ptr<Reader>(new QuantizedPostingListReader<DocId, Weight, Code>(doc_ids_, codes_, offset_,
+      scale_, upper_bound_, top_weights_, head_, std::move(shared_list)));
+}
+
+/*
+ * - Creates the posting lists by another factory, and converts them into quantized posting lists when frozen.
+ * - See SequentialFreezingFactory for the changes after frozen.
+ */
+template <typename DocId, typename Weight, typename Code>
+class QuantizedFreezingFactory: public PostingListFactory<DocId, Weight> {
+public:
+  typedef PostingListFactory<DocId, Weight> Base;
+  typedef typename Base::PList PList;
+  typedef typename Base::ReaderByVal ReaderByVal;
+  typedef typename Base::ReaderByRef ReaderByRef;
+
+  explicit QuantizedFreezingFactory(std::unique_ptr<Base> change_factory)
+  : change_factory_(std::move(change_factory)) {
+  }
+
+  virtual ~QuantizedFreezingFactory() = default;
+
+  virtual std::shared_ptr<PList> create_posting_list() const {
+    return change_factory_->create_posting_list();
+  }
+
+  virtual std::shared_ptr<PList> create_posting_list(std::unique_ptr<ReaderByVal> reader) const {
+    return change_factory_->create_posting_list(std::move(reader));
+  }
+
+  virtual std::shared_ptr<PList> create_posting_list(std::unique_ptr<ReaderByRef> reader) const {
+    return change_factory_->create_posting_list(std::move(reader));
+  }
+
+  virtual std::shared_ptr<PList> freeze_posting_list(std::shared_ptr<PList> plist) const {
+    auto reader = create_reader_shared(plist);
+    if (!reader) {
+      return Base::freeze_posting_list(std::move(plist));
+    }
+    return std::make_shared<QuantizedPostingList<DocId, Weight, Code>>(*reader);
+  }
+
+private:
+  std::unique_ptr<Base> change_factory_;
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_CORE_INDEX_QUANTIZED_POSTING_LIST_H_ */
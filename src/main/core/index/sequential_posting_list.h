@@ -1,14 +1,23 @@
-#ifndef SRC_MAIN_CORE_INDEX_STATIC_POSTING_LIST_H_
+#ifndef SRC_MAIN_CORE_INDEX_SEQUENTIAL_POSTING_LIST_H_
 #define SRC_MAIN_CORE_INDEX_SEQUENTIAL_POSTING_LIST_H_
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
+#include "core/index/doc_id_blocks.h"
+#include "core/index/posting_head.h"
 #include "core/index/posting_list.h"
+#include "core/index/top_weights.h"
 #include "core/reader/posting_list_reader.h"
 #include "core/reader/reader_utils.h"
 
 namespace redgiant {
+/*
+ * - A read-only posting list stored in arrays. The doc ids and the weights are stored separately, so that
+ *   searching the doc ids does not read the weights.
+ * - The doc ids are searched by blocks, see DocIdBlocks.
+ */
 template <typename DocId, typename Weight>
 class SequentialPostingList: public PostingList<DocId, Weight> {
 public:
@@ -16,7 +25,6 @@ public:
   typedef typename Base::PList PList;
   typedef typename Base::Reader Reader;
   typedef std::pair<DocId, Weight> PostingPair;
-  typedef std::vector<PostingPair> PostingVec;
 
   SequentialPostingList()
   : upper_bound_() {
@@ -25,13 +33,23 @@ public:
   template <typename InputWeight, typename WeightMerger = MaxWeight<Weight>>
   SequentialPostingList(PostingListReader<DocId, InputWeight>& reader, WeightMerger merger = WeightMerger())
   : upper_bound_() {
-    posting_ = read_all(reader, upper_bound_, merger);
+    auto posting = read_all(reader, upper_bound_, merger);
+    std::vector<DocId> doc_ids;
+    doc_ids.reserve(posting.size());
+    weights_.reserve(posting.size());
+    for (const auto& pair: posting) {
+      doc_ids.push_back(pair.first);
+      weights_.push_back(pair.second);
+    }
+    doc_ids_ = DocIdBlocks<DocId>(std::move(doc_ids));
+    top_weights_.build(weights_.begin(), weights_.end(), [] (const Weight& weight) { return weight; });
+    head_.build(posting.begin(), posting.end(), posting.size());
   }
 
   virtual ~SequentialPostingList() = default;
 
   virtual bool empty() const {
-    return posting_.empty();
+    return doc_ids_.empty();
   }
 
   virtual int update(DocId doc_id, const Weight& weight) {
@@ -48,34 +66,38 @@ public:
   virtual std::unique_ptr<Reader> create_reader(std::shared_ptr<PList> shared_list) const;
 
 private:
-  PostingVec posting_;
+  DocIdBlocks<DocId> doc_ids_;
+  std::vector<Weight> weights_;
   Weight upper_bound_;
+  TopWeights<Weight> top_weights_;
+  PostingHead<DocId, Weight> head_;
 };
 
 template <typename DocId, typename Weight>
-class SequentialPostingListReader: public PostingListReader<DocId, const Weight&> {
+class SequentialPostingListReader final : public PostingListReader<DocId, const Weight&> {
 public:
   typedef PostingList<DocId, Weight> PList;
   typedef std::pair<DocId, Weight> PostingPair;
-  typedef std::vector<PostingPair> PostingVec;
 
-  SequentialPostingListReader(const PostingVec& posting, const Weight& upper_bound, std::shared_ptr<PList> ref)
-  : ref_(std::move(ref)), posting_(&posting), upper_bound_(&upper_bound), iter_(posting_->begin()) {
+  SequentialPostingListReader(const DocIdBlocks<DocId>& doc_ids, const std::vector<Weight>& weights,
+      const Weight& upper_bound, const TopWeights<Weight>& top_weights, const PostingHead<DocId, Weight>& head,
+      std::shared_ptr<PList> ref)
+  : ref_(std::move(ref)), doc_ids_(&doc_ids), weights_(&weights), upper_bound_(&upper_bound),
+    top_weights_(&top_weights), head_(&head), pos_(0) {
   }
 
   virtual ~SequentialPostingListReader() = default;
 
   virtual DocId next(DocId current) {
-    for (; iter_ != posting_->end(); ++iter_) {
-      if (iter_->first > current) {
-        return iter_->first;
-      }
+    pos_ = doc_ids_->seek(pos_, current);
+    if (pos_ < doc_ids_->size()) {
+      return (*doc_ids_)[pos_];
     }
     return DocId(); // invalid
   }
 
   virtual const Weight& read() {
-    return iter_->second;
+    return (*weights_)[pos_];
   }
 
   virtual const Weight& upper_bound() {
@@ -83,24 +105,56 @@ public:
   }
 
   virtual size_t size() const {
-    return posting_->size();
+    return doc_ids_->size();
+  }
+
+  virtual size_t next_block(DocId current, DocId* doc_ids, Weight* weights, size_t max) {
+    if (max == 0 || !next(current)) {
+      return 0;
+    }
+    // the postings are contiguous, so the block is copied from both arrays.
+    size_t n = std::min(max, doc_ids_->size() - pos_);
+    std::copy(doc_ids_->data() + pos_, doc_ids_->data() + (pos_ + n), doc_ids);
+    std::copy(weights_->begin() + pos_, weights_->begin() + (pos_ + n), weights);
+    pos_ += n - 1;
+    return n;
+  }
+
+  virtual bool estimate_kth_weight(size_t k, Weight& weight) {
+    if (k > 0 && k <= head_->size()) {
+      // exactly the k-th weight
+      weight = head_->data()[k - 1].second;
+      return true;
+    }
+    return top_weights_->get(k, weight);
+  }
+
+  virtual bool read_head(size_t k, std::vector<PostingPair>& head) {
+    if (k == 0 || k > head_->size()) {
+      return false;
+    }
+    head.assign(head_->data(), head_->data() + k);
+    return true;
   }
 
 private:
   // Shared the lifetime with PostingList, make sure these values are always valid as long as reader valid.
   std::shared_ptr<PList> ref_;
-  const PostingVec* posting_;
+  const DocIdBlocks<DocId>* doc_ids_;
+  const std::vector<Weight>* weights_;
   const Weight* upper_bound_;
-  typename PostingVec::const_iterator iter_;
+  const TopWeights<Weight>* top_weights_;
+  const PostingHead<DocId, Weight>* head_;
+  size_t pos_;
 };
 
 template <typename DocId, typename Weight>
 auto SequentialPostingList<DocId, Weight>::create_reader(std::shared_ptr<PList> shared_list) const
 -> std::unique_ptr<Reader> {
-  // the parameters of reader constructor are pointers to the internal vector and upper bound weight,
+  // the parameters of reader constructor are pointers to the internal vectors and upper bound weight,
   // these pointers shares the life time with posting_list so that they are always valid as long as the reader valid.
-  return std::unique_ptr<Reader>(new SequentialPostingListReader<DocId, Weight>(posting_, upper_bound_,
-      std::move(shared_list)));
+  return std::unique_ptr<Reader>(new SequentialPostingListReader<DocId, Weight>(doc_ids_, weights_, upper_bound_,
+      top_weights_, head_, std::move(shared_list)));
 }
 
 template <typename DocId, typename Weight>
@@ -127,6 +181,50 @@ public:
     return std::shared_ptr<PList>(new SequentialPostingList<DocId, Weight>(*reader));
   }
 };
+
+/*
+ * - Creates the posting lists by another factory, e.g. btree posting lists which are cheap to change, and
+ *   converts them into sequential posting lists when frozen, which are compact and fast to read.
+ * - A frozen posting list is never changed. The changes are made to a new posting list created from it by
+ *   the other factory, so the sequential posting lists could be read-only.
+ */
+template <typename DocId, typename Weight>
+class SequentialFreezingFactory: public PostingListFactory<DocId, Weight> {
+public:
+  typedef PostingListFactory<DocId, Weight> Base;
+  typedef typename Base::PList PList;
+  typedef typename Base::ReaderByVal ReaderByVal;
+  typedef typename Base::ReaderByRef ReaderByRef;
+
+  explicit SequentialFreezingFactory(std::unique_ptr<Base> change_factory)
+  : change_factory_(std::move(change_factory)) {
+  }
+
+  virtual ~SequentialFreezingFactory() = default;
+
+  virtual std::shared_ptr<PList> create_posting_list() const {
+    return change_factory_->create_posting_list();
+  }
+
+  virtual std::shared_ptr<PList> create_posting_list(std::unique_ptr<ReaderByVal> reader) const {
+    return change_factory_->create_posting_list(std::move(reader));
+  }
+
+  virtual std::shared_ptr<PList> create_posting_list(std::unique_ptr<ReaderByRef> reader) const {
+    return change_factory_->create_posting_list(std::move(reader));
+  }
+
+  virtual std::shared_ptr<PList> freeze_posting_list(std::shared_ptr<PList> plist) const {
+    auto reader = create_reader_shared(plist);
+    if (!reader) {
+      return Base::freeze_posting_list(std::move(plist));
+    }
+    return std::make_shared<SequentialPostingList<DocId, Weight>>(*reader);
+  }
+
+private:
+  std::unique_ptr<Base> change_factory_;
+};
 } /* namespace redgiant */
 
-#endif /* SRC_MAIN_CORE_INDEX_STATIC_POSTING_LIST_H_ */
+#endif /* SRC_MAIN_CORE_INDEX_SEQUENTIAL_POSTING_LIST_H_ */
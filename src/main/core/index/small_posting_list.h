@@ -0,0 +1,265 @@
+#ifndef SRC_MAIN_CORE_INDEX_SMALL_POSTING_LIST_H_
+#define SRC_MAIN_CORE_INDEX_SMALL_POSTING_LIST_H_
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "core/index/posting_list.h"
+#include "core/reader/algorithms.h"
+#include "core/reader/posting_list_reader.h"
+#include "core/reader/reader_utils.h"
+
+namespace redgiant {
+/*
+ * - A read-only posting list of at most kCapacity postings, stored in fixed arrays inside the object, so that
+ *   a posting list is a single allocation together with its shared_ptr control block by std::make_shared.
+ * - Most features have only a few documents, for which the btree and the estimations of weights cost much more
+ *   than the postings themselves.
+ */
+template <typename DocId, typename Weight, size_t kCapacity = 8>
+class SmallPostingList: public PostingList<DocId, Weight> {
+public:
+  typedef PostingList<DocId, Weight> Base;
+  typedef typename Base::PList PList;
+  typedef typename Base::Reader Reader;
+
+  static constexpr size_t kMaxSize = kCapacity;
+
+  SmallPostingList()
+  : upper_bound_(), size_(0) {
+  }
+
+  // reads at most kCapacity postings from the reader.
+  template <typename InputWeight, typename WeightMerger = MaxWeight<Weight>>
+  SmallPostingList(PostingListReader<DocId, InputWeight>& reader, WeightMerger merger = WeightMerger())
+  : upper_bound_(), size_(0) {
+    merger(upper_bound_);
+    for (DocId doc_id = reader.next(DocId()); !!doc_id && size_ < kCapacity; doc_id = reader.next(doc_id)) {
+      doc_ids_[size_] = doc_id;
+      weights_[size_] = reader.read();
+      merger(upper_bound_, weights_[size_]);
+      ++size_;
+    }
+  }
+
+  virtual ~SmallPostingList() = default;
+
+  virtual bool empty() const {
+    return size_ == 0;
+  }
+
+  virtual int update(DocId doc_id, const Weight& weight) {
+    (void) doc_id;
+    (void) weight;
+    return 0;
+  }
+
+  virtual int remove(DocId doc_id) {
+    (void) doc_id;
+    return 0;
+  }
+
+  virtual std::unique_ptr<Reader> create_reader(std::shared_ptr<PList> shared_list) const;
+
+private:
+  std::array<DocId, kCapacity> doc_ids_;
+  std::array<Weight, kCapacity> weights_;
+  Weight upper_bound_;
+  size_t size_;
+};
+
+template <typename DocId, typename Weight, size_t kCapacity>
+constexpr size_t SmallPostingList<DocId, Weight, kCapacity>::kMaxSize;
+
+template <typename DocId, typename Weight>
+class SmallPostingListReader final : public PostingListReader<DocId, const Weight&> {
+public:
+  typedef PostingList<DocId, Weight> PList;
+
+  SmallPostingListReader(const DocId* doc_ids, const Weight* weights, size_t size, const Weight& upper_bound,
+      std::shared_ptr<PList> ref)
+  : ref_(std::move(ref)), doc_ids_(doc_ids), weights_(weights), size_(size), upper_bound_(&upper_bound), pos_(0) {
+  }
+
+  virtual ~SmallPostingListReader() = default;
+
+  virtual DocId next(DocId current) {
+    if (pos_ < size_ && !(doc_ids_[pos_] > current)) {
+      pos_ += count_not_greater(doc_ids_ + pos_, size_ - pos_, current);
+    }
+    if (pos_ < size_) {
+      return doc_ids_[pos_];
+    }
+    return DocId(); // invalid
+  }
+
+  virtual const Weight& read() {
+    return weights_[pos_];
+  }
+
+  virtual const Weight& upper_bound() {
+    return *upper_bound_;
+  }
+
+  virtual size_t size() const {
+    return size_;
+  }
+
+  virtual size_t next_block(DocId current, DocId* doc_ids, Weight* weights, size_t max) {
+    if (max == 0 || !next(current)) {
+      return 0;
+    }
+    size_t n = std::min(max, size_ - pos_);
+    std::copy(doc_ids_ + pos_, doc_ids_ + (pos_ + n), doc_ids);
+    std::copy(weights_ + pos_, weights_ + (pos_ + n), weights);
+    pos_ += n - 1;
+    return n;
+  }
+
+  virtual bool estimate_kth_weight(size_t k, Weight& weight) {
+    if (k == 0 || k > size_) {
+      return false;
+    }
+    // exactly the k-th weight, selected in place among the few postings
+    for (size_t i = 0; i < size_; ++i) {
+      size_t greater = 0;
+      size_t not_less = 0;
+      for (size_t j = 0; j < size_; ++j) {
+        if (weights_[j] > weights_[i]) {
+          ++greater;
+        }
+        if (!(weights_[j] < weights_[i])) {
+          ++not_less;
+        }
+      }
+      if (greater < k && k <= not_less) {
+        weight = weights_[i];
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  // Shared the lifetime with PostingList, make sure these values are always valid as long as reader valid.
+  std::shared_ptr<PList> ref_;
+  const DocId* doc_ids_;
+  const Weight* weights_;
+  size_t size_;
+  const Weight* upper_bound_;
+  size_t pos_;
+};
+
+/*
+ * - Reads either a small posting list or a posting list read by LargeReader, which is chosen by a branch in each
+ *   call instead of a virtual call, so that the terms of a query mixing small posting lists with larger ones could
+ *   still be composed statically over this reader type.
+ * - Both readers are final, so the calls of either one are bound statically.
+ */
+template <typename DocId, typename Weight, typename LargeReader>
+class SmallOrPostingListReader final : public PostingListReader<DocId, const Weight&> {
+public:
+  typedef SmallPostingListReader<DocId, Weight> SmallReader;
+  typedef std::pair<DocId, Weight> PostingPair;
+
+  explicit SmallOrPostingListReader(std::unique_ptr<SmallReader> small)
+  : small_(std::move(small)) {
+  }
+
+  explicit SmallOrPostingListReader(std::unique_ptr<LargeReader> large)
+  : large_(std::move(large)) {
+  }
+
+  virtual ~SmallOrPostingListReader() = default;
+
+  virtual DocId next(DocId current) {
+    return small_ ? small_->next(current) : large_->next(current);
+  }
+
+  virtual const Weight& read() {
+    return small_ ? small_->read() : large_->read();
+  }
+
+  virtual const Weight& upper_bound() {
+    return small_ ? small_->upper_bound() : large_->upper_bound();
+  }
+
+  virtual size_t size() const {
+    return small_ ? small_->size() : large_->size();
+  }
+
+  virtual size_t next_block(DocId current, DocId* doc_ids, Weight* weights, size_t max) {
+    return small_ ? small_->next_block(current, doc_ids, weights, max)
+        : large_->next_block(current, doc_ids, weights, max);
+  }
+
+  virtual bool estimate_kth_weight(size_t k, Weight& weight) {
+    return small_ ? small_->estimate_kth_weight(k, weight) : large_->estimate_kth_weight(k, weight);
+  }
+
+  virtual bool read_head(size_t k, std::vector<PostingPair>& head) {
+    return small_ ? small_->read_head(k, head) : large_->read_head(k, head);
+  }
+
+private:
+  // exactly one of them is set
+  std::unique_ptr<SmallReader> small_;
+  std::unique_ptr<LargeReader> large_;
+};
+
+template <typename DocId, typename Weight, size_t kCapacity>
+auto SmallPostingList<DocId, Weight, kCapacity>::create_reader(std::shared_ptr<PList> shared_list) const
+-> std::unique_ptr<Reader> {
+  return std::unique_ptr<Reader>(new SmallPostingListReader<DocId, Weight>(doc_ids_.data(), weights_.data(),
+      size_, upper_bound_, std::move(shared_list)));
+}
+
+/*
+ * - Creates and freezes the posting lists by another factory, except that the posting lists of at most
+ *   SmallList::kMaxSize postings are converted into small posting lists when frozen.
+ * - The changes are made to a new posting list created from the frozen one by the other factory, so a small
+ *   posting list growing larger is promoted to the posting list of the other factory.
+ */
+template <typename DocId, typename Weight>
+class SmallFreezingFactory: public PostingListFactory<DocId, Weight> {
+public:
+  typedef PostingListFactory<DocId, Weight> Base;
+  typedef typename Base::PList PList;
+  typedef typename Base::ReaderByVal ReaderByVal;
+  typedef typename Base::ReaderByRef ReaderByRef;
+  typedef SmallPostingList<DocId, Weight> SmallList;
+
+  explicit SmallFreezingFactory(std::shared_ptr<Base> factory)
+  : factory_(std::move(factory)) {
+  }
+
+  virtual ~SmallFreezingFactory() = default;
+
+  virtual std::shared_ptr<PList> create_posting_list() const {
+    return factory_->create_posting_list();
+  }
+
+  virtual std::shared_ptr<PList> create_posting_list(std::unique_ptr<ReaderByVal> reader) const {
+    return factory_->create_posting_list(std::move(reader));
+  }
+
+  virtual std::shared_ptr<PList> create_posting_list(std::unique_ptr<ReaderByRef> reader) const {
+    return factory_->create_posting_list(std::move(reader));
+  }
+
+  virtual std::shared_ptr<PList> freeze_posting_list(std::shared_ptr<PList> plist) const {
+    auto reader = create_reader_shared(plist);
+    if (!reader || reader->size() > SmallList::kMaxSize) {
+      return factory_->freeze_posting_list(std::move(plist));
+    }
+    return std::make_shared<SmallList>(*reader);
+  }
+
+private:
+  std::shared_ptr<Base> factory_;
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_CORE_INDEX_SMALL_POSTING_LIST_H_ */
@@ -0,0 +1,420 @@
+#ifndef SRC_MAIN_CORE_INDEX_TIERED_POSTING_LIST_H_
+#define SRC_MAIN_CORE_INDEX_TIERED_POSTING_LIST_H_
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "core/index/posting_list.h"
+#include "core/reader/algorithms.h"
+#include "core/reader/posting_list_reader.h"
+#include "third_party/btree/btree_map.h"
+
+namespace redgiant {
+/*
+ * Postings of a weight range, sorted by doc id.
+ */
+template <typename DocId, typename Weight>
+struct PostingTier {
+  typedef std::pair<DocId, Weight> PostingPair;
+
+  // position of the first posting after current, searched from pos.
+  // low tiers are often skipped far ahead, so it gallops instead of stepping one by one.
+  size_t seek(size_t pos, const DocId& current) const {
+    size_t low = pos;
+    size_t high = pos;
+    for (size_t step = 1; high < postings.size() && !(current < postings[high].first); step <<= 1) {
+      low = high + 1;
+      high += step;
+    }
+    high = std::min(high, postings.size());
+    auto iter = std::upper_bound(postings.begin() + low, postings.begin() + high, current,
+        [] (const DocId& doc_id, const PostingPair& pair) { return doc_id < pair.first; });
+    return iter - postings.begin();
+  }
+
+  std::vector<PostingPair> postings;
+  Weight upper_bound;
+  Weight lower_bound;
+};
+
+/*
+ * - This posting list splits long posting lists into tiers by weights, each
+ *   tier is sorted by doc id. The tiers are read separately as if they were
+ *   different terms, so that the low tiers are skipped by the readers like
+ *   WAND once they could not contribute enough to beat the threshold.
+ * - It suits the terms with skewed weights, where a few postings of high
+ *   weights make the top results.
+ * - Changes are kept in a btree map, and the tiers are built on freeze().
+ *   It could be read only when frozen.
+ */
+template <typename DocId, typename Weight, typename WeightMerger = MaxWeight<Weight>>
+class TieredPostingList: public PostingList<DocId, Weight> {
+public:
+  typedef PostingList<DocId, Weight> Base;
+  typedef typename Base::PList PList;
+  typedef typename Base::Reader Reader;
+  typedef std::pair<DocId, Weight> PostingPair;
+  typedef btree::btree_map<DocId, Weight> PostingMap;
+  typedef PostingTier<DocId, Weight> Tier;
+
+  // the least size of posting lists split into tiers
+  static constexpr size_t kMinListSize = 1024;
+  // the least size of a tier, except for the bottom one
+  static constexpr size_t kMinTierSize = 128;
+  // a tier is several times larger than the tier above
+  static constexpr size_t kTierRatio = 8;
+  static constexpr size_t kMaxTiers = 4;
+
+  TieredPostingList()
+  : upper_bound_(), merger_(), frozen_(true) {
+    merger_(upper_bound_); // initialize
+  }
+
+  explicit TieredPostingList(const WeightMerger& merger)
+  : upper_bound_(), merger_(merger), frozen_(true) {
+    merger_(upper_bound_); // initialize
+  }
+
+  template <typename InputWeight>
+  explicit TieredPostingList(PostingListReader<DocId, InputWeight>& reader, const WeightMerger& merger = WeightMerger())
+  : upper_bound_(), merger_(merger), frozen_(true) {
+    std::vector<PostingPair> postings;
+    postings.reserve(reader.size());
+    for (DocId doc_id = reader.next(DocId()); !!doc_id; doc_id = reader.next(doc_id)) {
+      postings.emplace_back(doc_id, reader.read());
+    }
+    build_tiers(postings);
+  }
+
+  virtual ~TieredPostingList() = default;
+
+  virtual bool empty() const {
+    return frozen_ ? tiers_.empty() : changing_.empty();
+  }
+
+  virtual int update(DocId doc_id, const Weight& weight) {
+    if (!doc_id) {
+      return 0;
+    }
+    thaw();
+    changing_[doc_id] = weight;
+    return 1;
+  }
+
+  virtual int remove(DocId doc_id) {
+    thaw();
+    return changing_.erase(doc_id) > 0 ? 1 : 0;
+  }
+
+  virtual void freeze() {
+    if (frozen_) {
+      return;
+    }
+    std::vector<PostingPair> postings(changing_.begin(), changing_.end());
+    changing_.clear();
+    build_tiers(postings);
+    frozen_ = true;
+  }
+
+  // returns null if not frozen.
+  virtual std::unique_ptr<Reader> create_reader(std::shared_ptr<PList> shared_list) const;
+
+  // returns no reader if not frozen.
+  virtual std::vector<std::unique_ptr<Reader>> create_tier_readers(std::shared_ptr<PList> shared_list) const;
+
+  size_t get_tier_count() const {
+    return tiers_.size();
+  }
+
+private:
+  // move the postings back to the map for changes.
+  void thaw() {
+    if (!frozen_) {
+      return;
+    }
+    for (auto& tier: tiers_) {
+      for (auto& posting: tier.postings) {
+        changing_.insert(std::move(posting));
+      }
+    }
+    tiers_.clear();
+    frozen_ = false;
+  }
+
+  // postings are sorted by doc id.
+  void build_tiers(const std::vector<PostingPair>& postings) {
+    tiers_.clear();
+    upper_bound_ = Weight();
+    merger_(upper_bound_);
+    if (postings.empty()) {
+      return;
+    }
+
+    // the least weights of the tiers, except for the bottom one, from top to bottom.
+    // the tier sizes grow by kTierRatio from top to bottom, and the weights at the tier
+    // boundaries are selected from the greatest ranks downwards.
+    std::vector<Weight> bounds;
+    if (postings.size() >= kMinListSize) {
+      std::vector<Weight> weights;
+      weights.reserve(postings.size());
+      for (const auto& posting: postings) {
+        weights.push_back(posting.second);
+      }
+      size_t limit = weights.size();
+      for (size_t rank = postings.size() / kTierRatio; rank >= kMinTierSize && bounds.size() + 1 < kMaxTiers;
+          rank /= kTierRatio) {
+        std::nth_element(weights.begin(), weights.begin() + (rank - 1), weights.begin() + limit,
+            std::greater<Weight>());
+        bounds.push_back(weights[rank - 1]);
+        limit = rank;
+      }
+      std::reverse(bounds.begin(), bounds.end());
+      // ties make the same bound, and an empty tier
+      bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+    }
+
+    tiers_.resize(bounds.size() + 1);
+    for (const auto& posting: postings) {
+      size_t i = 0;
+      while (i < bounds.size() && posting.second < bounds[i]) {
+        ++i;
+      }
+      tiers_[i].postings.push_back(posting);
+    }
+    for (auto& tier: tiers_) {
+      tier.postings.shrink_to_fit();
+      tier.upper_bound = Weight();
+      merger_(tier.upper_bound);
+      tier.lower_bound = tier.postings.empty() ? Weight() : tier.postings.front().second;
+      for (const auto& posting: tier.postings) {
+        merger_(tier.upper_bound, posting.second);
+        merger_(upper_bound_, posting.second);
+        if (posting.second < tier.lower_bound) {
+          tier.lower_bound = posting.second;
+        }
+      }
+    }
+    tiers_.erase(std::remove_if(tiers_.begin(), tiers_.end(), [] (const Tier& tier) {
+      return tier.postings.empty();
+    }), tiers_.end());
+  }
+
+  // changes, valid only if not frozen
+  PostingMap changing_;
+  // tiers from top to bottom, valid only if frozen
+  std::vector<Tier> tiers_;
+  Weight upper_bound_;
+  WeightMerger merger_;
+  bool frozen_;
+};
+
+template <typename DocId, typename Weight, typename WeightMerger>
+constexpr size_t TieredPostingList<DocId, Weight, WeightMerger>::kMinListSize;
+
+template <typename DocId, typename Weight, typename WeightMerger>
+constexpr size_t TieredPostingList<DocId, Weight, WeightMerger>::kMinTierSize;
+
+template <typename DocId, typename Weight, typename WeightMerger>
+constexpr size_t TieredPostingList<DocId, Weight, WeightMerger>::kTierRatio;
+
+template <typename DocId, typename Weight, typename WeightMerger>
+constexpr size_t TieredPostingList<DocId, Weight, WeightMerger>::kMaxTiers;
+
+/*
+ * Reads a single tier.
+ */
+template <typename DocId, typename Weight>
+class PostingTierReader: public PostingListReader<DocId, const Weight&> {
+public:
+  typedef PostingList<DocId, Weight> PList;
+  typedef PostingTier<DocId, Weight> Tier;
+
+  PostingTierReader(const Tier& tier, std::shared_ptr<PList> ref)
+  : ref_(std::move(ref)), tier_(&tier), pos_(0) {
+  }
+
+  virtual ~PostingTierReader() = default;
+
+  virtual DocId next(DocId current) {
+    pos_ = tier_->seek(pos_, current);
+    if (pos_ < tier_->postings.size()) {
+      return tier_->postings[pos_].first;
+    }
+    return DocId(); // invalid
+  }
+
+  virtual const Weight& read() {
+    return tier_->postings[pos_].second;
+  }
+
+  virtual size_t next_block(DocId current, DocId* doc_ids, Weight* weights, size_t max) {
+    if (max == 0 || !next(current)) {
+      return 0;
+    }
+    size_t n = std::min(max, tier_->postings.size() - pos_);
+    for (size_t i = 0; i < n; ++i) {
+      doc_ids[i] = tier_->postings[pos_ + i].first;
+      weights[i] = tier_->postings[pos_ + i].second;
+    }
+    pos_ += n - 1;
+    return n;
+  }
+
+  virtual const Weight& upper_bound() {
+    return tier_->upper_bound;
+  }
+
+  virtual size_t size() const {
+    return tier_->postings.size();
+  }
+
+  virtual bool estimate_kth_weight(size_t k, Weight& weight) {
+    if (k == 0 || k > tier_->postings.size()) {
+      return false;
+    }
+    weight = tier_->lower_bound;
+    return true;
+  }
+
+private:
+  // Shared the lifetime with PostingList, make sure these values are always valid as long as reader valid.
+  std::shared_ptr<PList> ref_;
+  const Tier* tier_;
+  size_t pos_;
+};
+
+/*
+ * Reads all tiers merged in the order of doc id.
+ */
+template <typename DocId, typename Weight>
+class TieredPostingListReader: public PostingListReader<DocId, const Weight&> {
+public:
+  typedef PostingList<DocId, Weight> PList;
+  typedef PostingTier<DocId, Weight> Tier;
+
+  TieredPostingListReader(const std::vector<Tier>& tiers, const Weight& upper_bound, std::shared_ptr<PList> ref)
+  : ref_(std::move(ref)), tiers_(&tiers), upper_bound_(&upper_bound), positions_(tiers.size(), 0),
+    current_(0), size_(0) {
+    for (const auto& tier: tiers) {
+      size_ += tier.postings.size();
+    }
+  }
+
+  virtual ~TieredPostingListReader() = default;
+
+  virtual DocId next(DocId current) {
+    DocId next_doc_id = DocId();
+    for (size_t i = 0; i < tiers_->size(); ++i) {
+      const Tier& tier = (*tiers_)[i];
+      positions_[i] = tier.seek(positions_[i], current);
+      if (positions_[i] < tier.postings.size()
+          && (!next_doc_id || tier.postings[positions_[i]].first < next_doc_id)) {
+        next_doc_id = tier.postings[positions_[i]].first;
+        current_ = i;
+      }
+    }
+    return next_doc_id;
+  }
+
+  virtual const Weight& read() {
+    return (*tiers_)[current_].postings[positions_[current_]].second;
+  }
+
+  virtual const Weight& upper_bound() {
+    return *upper_bound_;
+  }
+
+  virtual size_t size() const {
+    return size_;
+  }
+
+  virtual bool estimate_kth_weight(size_t k, Weight& weight) {
+    if (k == 0 || k > size_) {
+      return false;
+    }
+    // the k-th weight is in the first tiers holding k postings
+    size_t count = 0;
+    for (const auto& tier: *tiers_) {
+      count += tier.postings.size();
+      if (count >= k) {
+        weight = tier.lower_bound;
+        break;
+      }
+    }
+    return true;
+  }
+
+private:
+  // Shared the lifetime with PostingList, make sure these values are always valid as long as reader valid.
+  std::shared_ptr<PList> ref_;
+  const std::vector<Tier>* tiers_;
+  const Weight* upper_bound_;
+  std::vector<size_t> positions_;
+  size_t current_;
+  size_t size_;
+};
+
+template <typename DocId, typename Weight, typename WeightMerger>
+auto TieredPostingList<DocId, Weight, WeightMerger>::create_reader(std::shared_ptr<PList> shared_list) const
+-> std::unique_ptr<Reader> {
+  if (!frozen_) {
+    return nullptr;
+  }
+  // the parameters of reader constructor are pointers to the internal tiers and upper bound weight,
+  // these pointers shares the life time with posting_list so that they are always valid as long as the reader valid.
+  return std::unique_ptr<Reader>(new TieredPostingListReader<DocId, Weight>(tiers_, upper_bound_,
+      std::move(shared_list)));
+}
+
+template <typename DocId, typename Weight, typename WeightMerger>
+auto TieredPostingList<DocId, Weight, WeightMerger>::create_tier_readers(std::shared_ptr<PList> shared_list) const
+-> std::vector<std::unique_ptr<Reader>> {
+  std::vector<std::unique_ptr<Reader>> readers;
+  if (!frozen_) {
+    return readers;
+  }
+  readers.reserve(tiers_.size());
+  for (const auto& tier: tiers_) {
+    readers.emplace_back(new PostingTierReader<DocId, Weight>(tier, shared_list));
+  }
+  return readers;
+}
+
+template <typename DocId, typename Weight, typename WeightMerger = MaxWeight<Weight>>
+class TieredPostingListFactory: public PostingListFactory<DocId, Weight> {
+public:
+  typedef PostingListFactory<DocId, Weight> Base;
+  typedef typename Base::PList PList;
+  typedef typename Base::ReaderByVal ReaderByVal;
+  typedef typename Base::ReaderByRef ReaderByRef;
+
+  TieredPostingListFactory()
+  : merger_() {
+  }
+
+  explicit TieredPostingListFactory(const WeightMerger& merger)
+  : merger_(merger) {
+  }
+
+  virtual ~TieredPostingListFactory() = default;
+
+  virtual std::shared_ptr<PList> create_posting_list() const {
+    return std::shared_ptr<PList>(new TieredPostingList<DocId, Weight, WeightMerger>(merger_));
+  }
+
+  virtual std::shared_ptr<PList> create_posting_list(std::unique_ptr<ReaderByVal> reader) const {
+    return std::shared_ptr<PList>(new TieredPostingList<DocId, Weight, WeightMerger>(*reader, merger_));
+  }
+
+  virtual std::shared_ptr<PList> create_posting_list(std::unique_ptr<ReaderByRef> reader) const {
+    return std::shared_ptr<PList>(new TieredPostingList<DocId, Weight, WeightMerger>(*reader, merger_));
+  }
+
+private:
+  WeightMerger merger_;
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_CORE_INDEX_TIERED_POSTING_LIST_H_ */
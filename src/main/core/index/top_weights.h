@@ -0,0 +1,101 @@
+#ifndef SRC_MAIN_CORE_INDEX_TOP_WEIGHTS_H_
+#define SRC_MAIN_CORE_INDEX_TOP_WEIGHTS_H_
+
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace redgiant {
+/*
+ * The greatest weights of a posting list at the ranks of powers of 2 (1st, 2nd, 4th, ...),
+ * so that the k-th greatest weight is bounded from below by the weight at the nearest rank
+ * not less than k, or the least weight, which takes only a few weights for each posting list.
+ * Weights which are not arithmetic types are never estimated.
+ */
+template <typename Weight, bool = std::is_arithmetic<Weight>::value>
+class TopWeights {
+public:
+  template <typename Iterator, typename GetWeight>
+  void build(Iterator begin, Iterator end, GetWeight get_weight) {
+    (void) begin;
+    (void) end;
+    (void) get_weight;
+  }
+
+  void clear() {
+  }
+
+  bool get(size_t k, Weight& weight) const {
+    (void) k;
+    (void) weight;
+    return false;
+  }
+};
+
+template <typename Weight>
+class TopWeights<Weight, true> {
+public:
+  // the greatest rank stored
+  static constexpr size_t kMaxRank = 1024;
+
+  TopWeights()
+  : least_(), count_(0) {
+  }
+
+  // build from the items in [begin, end), get_weight returns the weight of an item.
+  template <typename Iterator, typename GetWeight>
+  void build(Iterator begin, Iterator end, GetWeight get_weight) {
+    std::vector<Weight> weights;
+    for (; begin != end; ++begin) {
+      weights.push_back(get_weight(*begin));
+    }
+    count_ = weights.size();
+    if (count_ == 0) {
+      clear();
+      return;
+    }
+    least_ = *std::min_element(weights.begin(), weights.end());
+    size_t top = std::min(weights.size(), kMaxRank);
+    std::partial_sort(weights.begin(), weights.begin() + top, weights.end(), std::greater<Weight>());
+
+    ranked_.clear();
+    size_t count = 0;
+    for (size_t rank = 1; rank <= top; rank <<= 1) {
+      ++count;
+    }
+    ranked_.reserve(count);
+    for (size_t rank = 1; rank <= top; rank <<= 1) {
+      ranked_.push_back(weights[rank - 1]);
+    }
+  }
+
+  void clear() {
+    std::vector<Weight>().swap(ranked_);
+    count_ = 0;
+  }
+
+  // there are at least k weights not less than the returned weight.
+  bool get(size_t k, Weight& weight) const {
+    if (k == 0 || k > count_) {
+      return false;
+    }
+    size_t i = 0;
+    for (size_t rank = 1; rank < k; rank <<= 1) {
+      ++i;
+    }
+    weight = i < ranked_.size() ? ranked_[i] : least_;
+    return true;
+  }
+
+private:
+  std::vector<Weight> ranked_;
+  Weight least_;
+  size_t count_;
+};
+
+template <typename Weight>
+constexpr size_t TopWeights<Weight, true>::kMaxRank;
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_CORE_INDEX_TOP_WEIGHTS_H_ */
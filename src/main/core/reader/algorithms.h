@@ -2,9 +2,13 @@
 #define SRC_MAIN_CORE_READER_ALGORITHMS_H_
 
 #include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <numeric>
 #include <utility>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 namespace redgiant {
 template <typename Score, typename InputWeight, typename QueryWeight = InputWeight>
@@ -15,6 +19,80 @@ public:
   }
 };
 
+/*
+ * Multiply a block of weights by the query weight: scores[i] = weights[i] * query, for 0 <= i < n.
+ */
+template <typename Score, typename InputWeight, typename QueryWeight>
+void multiply_block(const InputWeight* weights, size_t n, const QueryWeight& query, Score* scores) {
+  for (size_t i = 0; i < n; ++i) {
+    scores[i] = weights[i] * query;
+  }
+}
+
+/*
+ * Vectorized by AVX2 (4 doubles at a time) if enabled by the compiler flags, e.g. configure --enable-avx2.
+ * Otherwise it is the same scalar loop.
+ */
+inline void multiply_block(const double* weights, size_t n, const double& query, double* scores) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  __m256d query_vec = _mm256_set1_pd(query);
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(scores + i, _mm256_mul_pd(_mm256_loadu_pd(weights + i), query_vec));
+  }
+#endif
+  for (; i < n; ++i) {
+    scores[i] = weights[i] * query;
+  }
+}
+
+// single precision weights are converted into double, 4 at a time by AVX2 if enabled.
+inline void multiply_block(const float* weights, size_t n, const double& query, double* scores) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  __m256d query_vec = _mm256_set1_pd(query);
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(scores + i, _mm256_mul_pd(_mm256_cvtps_pd(_mm_loadu_ps(weights + i)), query_vec));
+  }
+#endif
+  for (; i < n; ++i) {
+    scores[i] = weights[i] * query;
+  }
+}
+
+/*
+ * Combine a block of weights with the query weight by the combiner: scores[i] = combiner(weights[i], query).
+ */
+template <typename Score, typename InputWeight, typename QueryWeight, typename ScoreCombiner>
+void combine_block(ScoreCombiner& combiner, const InputWeight* weights, size_t n, const QueryWeight& query,
+    Score* scores) {
+  for (size_t i = 0; i < n; ++i) {
+    scores[i] = combiner(weights[i], query);
+  }
+}
+
+// the dot product of a block is a vectorized multiplication.
+template <typename Score, typename InputWeight, typename QueryWeight>
+void combine_block(DotProduct<Score, InputWeight, QueryWeight>& combiner, const InputWeight* weights, size_t n,
+    const QueryWeight& query, Score* scores) {
+  (void) combiner;
+  multiply_block(weights, n, query, scores);
+}
+
+/*
+ * The number of doc ids not greater than current in a block sorted in ascending order, which is also the offset of
+ * the first doc id greater than current. The whole block is compared without branches, so that the loop could be
+ * vectorized. Doc id types may overload it for their own layout, found by argument dependent lookup.
+ */
+template <typename DocId>
+size_t count_not_greater(const DocId* doc_ids, size_t n, const DocId& current) {
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i) {
+    count += !(current < doc_ids[i]);
+  }
+  return count;
+}
+
 template <typename Weight>
 class MaxWeight {
 public:
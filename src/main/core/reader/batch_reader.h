@@ -0,0 +1,178 @@
+#ifndef SRC_MAIN_CORE_READER_BATCH_READER_H_
+#define SRC_MAIN_CORE_READER_BATCH_READER_H_
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "core/reader/algorithms.h"
+#include "core/reader/posting_list_reader.h"
+#include "core/reader/reader_utils.h"
+
+namespace redgiant {
+// add the weight read as a prior to the queries scored at the current document.
+template <typename Reader, typename QueryWeight, typename Score, typename ScoreCombiner>
+void add_batch_priors(Reader& reader, const std::vector<std::pair<size_t, QueryWeight>>& prior_queries,
+    const std::vector<bool>& scored, std::vector<Score>& scores, ScoreCombiner& combiner) {
+  if (prior_queries.empty()) {
+    return;
+  }
+  const auto& weight = reader.read();
+  for (const auto& query: prior_queries) {
+    if (scored[query.first]) {
+      scores[query.first] += combiner(weight, query.second);
+    }
+  }
+}
+
+/*
+ * Read the top documents of a batch of queries, reading each term only once for all of them.
+ * - readers are the raw readers of the union of the terms, and term_queries[t] are the queries
+ *   containing the term t, by pairs of (query index, query weight).
+ * - The documents are read document-at-a-time over all terms, and the score of a document for
+ *   each query is the sum of the combined weights of its terms, like DotProductQuery does.
+ * - results[q] are the top counts[q] documents of query q, sorted by scores in descending order.
+ *   Documents with a score not greater than min_scores[q] are dropped.
+ * - prior_queries[t] are the queries reading the term t as a prior, see WandReader: its weight is only
+ *   added to the documents found by the other terms of the query. The terms read by no query as a
+ *   term are not searched, but read forward to the documents found.
+ * - The stop condition is checked every check_interval documents (must be a power of 2). If it
+ *   returns true, the reading is stopped and the best documents read so far are returned.
+ */
+template <typename DocId, typename Weight, typename QueryWeight, typename Score, typename StopCondition,
+    typename ScoreCombiner = DotProduct<Score, typename std::decay<Weight>::type, QueryWeight>>
+void read_batch_topn(std::vector<std::unique_ptr<PostingListReader<DocId, Weight>>>& readers,
+    const std::vector<std::vector<std::pair<size_t, QueryWeight>>>& term_queries,
+    const std::vector<std::vector<std::pair<size_t, QueryWeight>>>& prior_queries,
+    const std::vector<size_t>& counts, const std::vector<Score>& min_scores, StopCondition&& stop, bool& stopped,
+    std::vector<std::vector<std::pair<DocId, Score>>>& results, size_t check_interval = 64,
+    ScoreCombiner combiner = ScoreCombiner()) {
+  typedef std::pair<DocId, size_t> Cursor;
+  // min heap of the cursors of terms
+  auto cursor_greater = [] (const Cursor& lhs, const Cursor& rhs) {
+    return rhs.first < lhs.first;
+  };
+
+  stopped = false;
+  results.assign(counts.size(), std::vector<std::pair<DocId, Score>>());
+  std::vector<Cursor> cursors;
+  cursors.reserve(readers.size());
+  // the cursors of the priors not searched, not greater than the current document
+  std::vector<Cursor> prior_cursors;
+  for (size_t term = 0; term < readers.size(); ++term) {
+    if (term_queries[term].empty()) {
+      if (!prior_queries[term].empty()) {
+        prior_cursors.emplace_back(DocId(), term);
+      }
+      continue;
+    }
+    DocId doc_id = readers[term]->next(DocId());
+    if (doc_id) {
+      cursors.emplace_back(doc_id, term);
+    }
+  }
+  std::make_heap(cursors.begin(), cursors.end(), cursor_greater);
+
+  // scores of the current document, and the queries scored
+  std::vector<Score> scores(counts.size(), Score(0));
+  std::vector<bool> scored(counts.size(), false);
+  std::vector<size_t> scored_queries;
+  std::vector<size_t> read_terms;
+  size_t check_mask = check_interval - 1;
+  size_t n = 0;
+  while (!cursors.empty()) {
+    DocId doc_id = cursors.front().first;
+    while (!cursors.empty() && cursors.front().first == doc_id) {
+      size_t term = cursors.front().second;
+      std::pop_heap(cursors.begin(), cursors.end(), cursor_greater);
+      cursors.pop_back();
+      read_terms.push_back(term);
+
+      const auto& weight = readers[term]->read();
+      for (const auto& query: term_queries[term]) {
+        if (!scored[query.first]) {
+          scored[query.first] = true;
+          scored_queries.push_back(query.first);
+        }
+        scores[query.first] += combiner(weight, query.second);
+      }
+    }
+
+    // the priors of the queries found
+    if (!scored_queries.empty()) {
+      for (size_t term: read_terms) {
+        add_batch_priors(*readers[term], prior_queries[term], scored, scores, combiner);
+      }
+      for (size_t i = 0; i < prior_cursors.size(); ) {
+        auto& cursor = prior_cursors[i];
+        if (cursor.first < doc_id) {
+          DocId before = doc_id;
+          cursor.first = readers[cursor.second]->next(--before);
+          if (!cursor.first) {
+            // read to the end
+            cursor = prior_cursors.back();
+            prior_cursors.pop_back();
+            continue;
+          }
+        }
+        if (cursor.first == doc_id) {
+          add_batch_priors(*readers[cursor.second], prior_queries[cursor.second], scored, scores, combiner);
+        }
+        ++i;
+      }
+    }
+
+    for (size_t query: scored_queries) {
+      auto& topn = results[query];
+      Score score = scores[query];
+      if (score > min_scores[query] && counts[query] > 0) {
+        if (topn.size() < counts[query]) {
+          topn.emplace_back(doc_id, score);
+          std::push_heap(topn.begin(), topn.end(), DocIdPairWeightGreater());
+        } else if (score > topn.front().second) {
+          std::pop_heap(topn.begin(), topn.end(), DocIdPairWeightGreater());
+          topn.back() = std::make_pair(doc_id, score);
+          std::push_heap(topn.begin(), topn.end(), DocIdPairWeightGreater());
+        }
+      }
+      scores[query] = Score(0);
+      scored[query] = false;
+    }
+    scored_queries.clear();
+
+    for (size_t term: read_terms) {
+      DocId next_id = readers[term]->next(doc_id);
+      if (next_id) {
+        cursors.emplace_back(next_id, term);
+        std::push_heap(cursors.begin(), cursors.end(), cursor_greater);
+      }
+    }
+    read_terms.clear();
+
+    if ((++n & check_mask) == 0 && stop()) {
+      stopped = true;
+      break;
+    }
+  }
+
+  for (auto& topn: results) {
+    std::sort_heap(topn.begin(), topn.end(), DocIdPairWeightGreater());
+  }
+}
+
+// a batch without priors.
+template <typename DocId, typename Weight, typename QueryWeight, typename Score, typename StopCondition,
+    typename ScoreCombiner = DotProduct<Score, typename std::decay<Weight>::type, QueryWeight>>
+void read_batch_topn(std::vector<std::unique_ptr<PostingListReader<DocId, Weight>>>& readers,
+    const std::vector<std::vector<std::pair<size_t, QueryWeight>>>& term_queries,
+    const std::vector<size_t>& counts, const std::vector<Score>& min_scores, StopCondition&& stop, bool& stopped,
+    std::vector<std::vector<std::pair<DocId, Score>>>& results, size_t check_interval = 64,
+    ScoreCombiner combiner = ScoreCombiner()) {
+  read_batch_topn(readers, term_queries, std::vector<std::vector<std::pair<size_t, QueryWeight>>>(readers.size()),
+      counts, min_scores, std::forward<StopCondition>(stop), stopped, results, check_interval, combiner);
+}
+
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_CORE_READER_BATCH_READER_H_ */
@@ -3,17 +3,25 @@
 
 #include <memory>
 #include <type_traits>
+#include <utility>
+#include <vector>
 #include "core/reader/algorithms.h"
 #include "core/reader/posting_list_reader.h"
 
 namespace redgiant {
 // InputWeight may be reference, QueryWeight is considered as value type
+// Input is the type of the input reader. The input is read through the virtual PostingListReader interface by
+// default, or bound statically if Input is a concrete final class.
 template <typename DocId, typename Score, typename InputWeight,
     typename QueryWeight = typename std::decay<InputWeight>::type,
-    typename ScoreCombiner = DotProduct<Score, typename std::decay<InputWeight>::type, QueryWeight>>
-class DotProductReader: public PostingListReader<DocId, Score> {
+    typename ScoreCombiner = DotProduct<Score, typename std::decay<InputWeight>::type, QueryWeight>,
+    typename Input = PostingListReader<DocId, InputWeight>>
+class DotProductReader final : public PostingListReader<DocId, Score> {
 public:
-  typedef PostingListReader<DocId, InputWeight> InputReader;
+  typedef Input InputReader;
+  // the same reader over the input of another type
+  template <typename OtherInput>
+  using WithInput = DotProductReader<DocId, Score, InputWeight, QueryWeight, ScoreCombiner, OtherInput>;
 
   DotProductReader(std::unique_ptr<InputReader> reader, const QueryWeight& query)
   : reader_(std::move(reader)), query_(query), combiner_() {
@@ -37,14 +45,66 @@ public:
     return combiner_(reader_->upper_bound(), query_);
   }
 
+  // the weights of the block are read at once, and scored at once.
+  virtual size_t next_block(DocId current, DocId* doc_ids, Score* scores, size_t max) {
+    if (block_weights_.size() < max) {
+      block_weights_.resize(max);
+    }
+    size_t n = reader_->next_block(current, doc_ids, block_weights_.data(), max);
+    combine_block(combiner_, block_weights_.data(), n, query_, scores);
+    return n;
+  }
+
   virtual size_t size() const {
     return reader_->size();
   }
 
+  // the order of weights is kept only if the query weight is not negative.
+  virtual bool estimate_kth_weight(size_t k, Score& score) {
+    typename std::decay<InputWeight>::type weight;
+    if (query_ < QueryWeight() || !reader_->estimate_kth_weight(k, weight)) {
+      return false;
+    }
+    score = combiner_(weight, query_);
+    return true;
+  }
+
+  virtual bool read_head(size_t k, std::vector<std::pair<DocId, Score>>& head) {
+    std::vector<std::pair<DocId, typename std::decay<InputWeight>::type>> input_head;
+    if (query_ < QueryWeight() || !reader_->read_head(k, input_head)) {
+      return false;
+    }
+    head.clear();
+    head.reserve(input_head.size());
+    for (auto& pair: input_head) {
+      head.emplace_back(pair.first, combiner_(pair.second, query_));
+    }
+    return true;
+  }
+
+  const InputReader& get_input() const {
+    return *reader_;
+  }
+
+  // take the input reader away, e.g. to compose another reader of it. this reader is no longer valid then.
+  std::unique_ptr<InputReader> release_input() {
+    return std::move(reader_);
+  }
+
+  const QueryWeight& get_query_weight() const {
+    return query_;
+  }
+
+  const ScoreCombiner& get_combiner() const {
+    return combiner_;
+  }
+
 private:
   std::unique_ptr<InputReader> reader_;
   QueryWeight query_;
   ScoreCombiner combiner_;
+  // the input weights of the last block
+  std::vector<typename std::decay<InputWeight>::type> block_weights_;
 };
 } /* namespace redgiant */
 
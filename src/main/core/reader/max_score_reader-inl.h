@@ -0,0 +1,130 @@
+#ifndef SRC_MAIN_CORE_READER_MAX_SCORE_READER_INL_H_
+#define SRC_MAIN_CORE_READER_MAX_SCORE_READER_INL_H_
+
+#include <algorithm>
+#include "core/reader/max_score_reader.h"
+#include "core/reader/reader_utils.h"
+
+namespace redgiant {
+
+template <typename DocId, typename Score>
+MaxScoreReader<DocId, Score>::MaxScoreReader(std::vector<std::unique_ptr<Reader>>&& input_readers)
+: readers_(std::move(input_readers)), reader_cursors_(readers_.size()), exhausted_(readers_.size(), false),
+  acc_upper_bounds_(readers_.size()), essential_(0), threshold_(0), score_(0) {
+  // cache the upper bounds, and sort the readers by them
+  std::vector<std::pair<Score, size_t>> upper_bounds;
+  upper_bounds.reserve(readers_.size());
+  for (size_t i = 0; i < readers_.size(); ++i) {
+    upper_bounds.emplace_back(readers_[i]->upper_bound(), i);
+  }
+  std::stable_sort(upper_bounds.begin(), upper_bounds.end(),
+      [] (const std::pair<Score, size_t>& lhs, const std::pair<Score, size_t>& rhs) {
+    return lhs.first < rhs.first;
+  });
+  std::vector<std::unique_ptr<Reader>> sorted_readers;
+  sorted_readers.reserve(readers_.size());
+  Score score(0);
+  for (size_t i = 0; i < upper_bounds.size(); ++i) {
+    sorted_readers.push_back(std::move(readers_[upper_bounds[i].second]));
+    score += upper_bounds[i].first;
+    acc_upper_bounds_[i] = score;
+  }
+  readers_.swap(sorted_readers);
+  threshold(threshold_);
+}
+
+template <typename DocId, typename Score>
+DocId MaxScoreReader<DocId, Score>::next(DocId current) {
+  for (;;) {
+    // advance the essential readers, and find the least cursor as the candidate
+    DocId candidate = DocId();
+    for (size_t i = essential_; i < readers_.size(); ++i) {
+      if (exhausted_[i]) {
+        continue;
+      }
+      if (!reader_cursors_[i] || !(current < reader_cursors_[i])) {
+        reader_cursors_[i] = readers_[i]->next(current);
+        if (!reader_cursors_[i]) {
+          exhausted_[i] = true;
+          continue;
+        }
+      }
+      if (!candidate || reader_cursors_[i] < candidate) {
+        candidate = reader_cursors_[i];
+      }
+    }
+    if (!candidate) {
+      // no more valid documents;
+      return DocId();
+    }
+
+    Score score(0);
+    for (size_t i = essential_; i < readers_.size(); ++i) {
+      if (!exhausted_[i] && reader_cursors_[i] == candidate) {
+        score += readers_[i]->read();
+      }
+    }
+    // look up the non-essential readers from the greatest upper bound,
+    // until the rest of them could not make it
+    bool qualified = true;
+    for (size_t i = essential_; i > 0; --i) {
+      if (!(score + acc_upper_bounds_[i - 1] > threshold_)) {
+        qualified = false;
+        break;
+      }
+      if (seek(i - 1, candidate) && reader_cursors_[i - 1] == candidate) {
+        score += readers_[i - 1]->read();
+      }
+    }
+    if (qualified && score > threshold_) {
+      score_ = score;
+      return candidate;
+    }
+    current = candidate;
+  }
+}
+
+template <typename DocId, typename Score>
+Score MaxScoreReader<DocId, Score>::read() {
+  return score_;
+}
+
+template <typename DocId, typename Score>
+Score MaxScoreReader<DocId, Score>::upper_bound() {
+  if (acc_upper_bounds_.size() > 0) {
+    return acc_upper_bounds_.back();
+  }
+  return Score(0);
+}
+
+template <typename DocId, typename Score>
+void MaxScoreReader<DocId, Score>::threshold(const Score& threshold) {
+  threshold_ = threshold;
+  // the readers with accumulated upper bounds not greater than threshold are non-essential
+  auto i = std::upper_bound(acc_upper_bounds_.begin(), acc_upper_bounds_.end(), threshold_);
+  essential_ = i - acc_upper_bounds_.begin();
+}
+
+template <typename DocId, typename Score>
+bool MaxScoreReader<DocId, Score>::estimate_kth_weight(size_t k, Score& score) {
+  return estimate_sum_kth_weight(readers_, k, score);
+}
+
+template <typename DocId, typename Score>
+bool MaxScoreReader<DocId, Score>::seek(size_t term, DocId target) {
+  if (exhausted_[term]) {
+    return false;
+  }
+  if (!reader_cursors_[term] || reader_cursors_[term] < target) {
+    reader_cursors_[term] = readers_[term]->next(--target);
+    if (!reader_cursors_[term]) {
+      exhausted_[term] = true;
+      return false;
+    }
+  }
+  return true;
+}
+
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_CORE_READER_MAX_SCORE_READER_INL_H_ */
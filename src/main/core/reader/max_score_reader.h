@@ -0,0 +1,60 @@
+#ifndef SRC_MAIN_CORE_READER_MAX_SCORE_READER_H_
+#define SRC_MAIN_CORE_READER_MAX_SCORE_READER_H_
+
+#include <memory>
+#include <vector>
+#include "core/reader/posting_list_reader.h"
+
+namespace redgiant {
+class MaxScoreReaderTest;
+
+/*
+ * - This reader implements the document-at-a-time MaxScore algorithm. The
+ *   terms are sorted by upper bounds, and the terms with the least upper
+ *   bounds summing up to no more than the threshold are non-essential: a
+ *   document matching only these terms could not beat the threshold.
+ * - Documents are enumerated from the essential terms only, and the
+ *   non-essential terms are looked up for the candidates, until the rest of
+ *   them could not lift the score above the threshold.
+ * - It works better than WAND for queries of many terms with skewed upper
+ *   bounds, where most terms become non-essential soon.
+ */
+template <typename DocId, typename Score>
+class MaxScoreReader : public PostingListReader<DocId, Score> {
+public:
+  friend class MaxScoreReaderTest;
+  typedef PostingListReader<DocId, Score> Reader;
+
+  MaxScoreReader(std::vector<std::unique_ptr<Reader>>&& input_readers);
+  virtual ~MaxScoreReader() = default;
+
+  virtual DocId next(DocId current);
+  virtual Score read();
+  virtual Score upper_bound();
+
+  virtual void threshold(const Score& threshold);
+
+  virtual bool estimate_kth_weight(size_t k, Score& score);
+
+private:
+  // advance the reader to the first document not less than target, returns false if exhausted.
+  bool seek(size_t term, DocId target);
+
+private:
+  // saved readers, sorted by upper bounds in ascending order
+  std::vector<std::unique_ptr<Reader>> readers_;
+  // cursors of readers, invalid before started or after exhausted
+  std::vector<DocId> reader_cursors_;
+  std::vector<bool> exhausted_;
+  // accumulated upper bounds of readers
+  std::vector<Score> acc_upper_bounds_;
+  // readers before this are non-essential
+  size_t essential_;
+  Score threshold_;
+  // score of the current document
+  Score score_;
+};
+
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_CORE_READER_MAX_SCORE_READER_H_ */
@@ -0,0 +1,176 @@
+#ifndef SRC_MAIN_CORE_READER_PARALLEL_READER_H_
+#define SRC_MAIN_CORE_READER_PARALLEL_READER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "core/reader/posting_list_reader.h"
+#include "core/reader/reader_utils.h"
+
+namespace redgiant {
+/*
+ * - This reader keeps the readers of the partitions of a query, each reading a range of doc ids.
+ *   The ranges must be disjoint, and given in the ascending order of doc ids.
+ * - Iterated as a reader, it reads the partitions one after another. The partitions could be read
+ *   concurrently by read_topn_parallel() instead.
+ * - The k-th score could not be estimated by the partitions, so the estimation of the whole query
+ *   could be given.
+ */
+template <typename DocId, typename Score>
+class ParallelReader : public PostingListReader<DocId, Score> {
+public:
+  typedef PostingListReader<DocId, Score> Reader;
+
+  // estimated_score is a lower bound of the estimated_k-th score of the query, if estimated_k > 0.
+  ParallelReader(std::vector<std::unique_ptr<Reader>>&& partitions, size_t estimated_k = 0,
+      const Score& estimated_score = Score())
+  : partitions_(std::move(partitions)), part_(0), upper_bound_(0), size_(0),
+    estimated_k_(estimated_k), estimated_score_(estimated_score) {
+    for (size_t i = 0; i < partitions_.size(); ++i) {
+      Score upper_bound = partitions_[i]->upper_bound();
+      if (i == 0 || upper_bound > upper_bound_) {
+        upper_bound_ = upper_bound;
+      }
+      size_ += partitions_[i]->size();
+    }
+  }
+
+  virtual ~ParallelReader() = default;
+
+  virtual DocId next(DocId current) {
+    for (; part_ < partitions_.size(); ++part_) {
+      DocId doc_id = partitions_[part_]->next(current);
+      if (doc_id) {
+        return doc_id;
+      }
+    }
+    return DocId(); // invalid
+  }
+
+  virtual Score read() {
+    return partitions_[part_]->read();
+  }
+
+  virtual Score upper_bound() {
+    return upper_bound_;
+  }
+
+  virtual size_t size() const {
+    return size_;
+  }
+
+  virtual void threshold(const Score& threshold) {
+    for (size_t i = part_; i < partitions_.size(); ++i) {
+      partitions_[i]->threshold(threshold);
+    }
+  }
+
+  virtual bool estimate_kth_weight(size_t k, Score& score) {
+    if (k == 0 || k > estimated_k_) {
+      return false;
+    }
+    // the k-th score is not less than the estimated_k-th score
+    score = estimated_score_;
+    return true;
+  }
+
+  std::vector<std::unique_ptr<Reader>>& get_partitions() {
+    return partitions_;
+  }
+
+private:
+  std::vector<std::unique_ptr<Reader>> partitions_;
+  // the partition being iterated
+  size_t part_;
+  Score upper_bound_;
+  size_t size_;
+  size_t estimated_k_;
+  Score estimated_score_;
+};
+
+/*
+ * Raise the shared threshold to score, if it is greater.
+ */
+template <typename Score>
+void raise_shared_threshold(std::atomic<Score>& threshold, const Score& score) {
+  Score current = threshold.load(std::memory_order_relaxed);
+  while (score > current && !threshold.compare_exchange_weak(current, score, std::memory_order_relaxed)) {
+  }
+}
+
+/*
+ * Read the top n documents of the partitions concurrently, like read_topn_until() does for a reader.
+ * - run(n, task) should call task(i) for each i in [0, n), possibly in several threads, and return
+ *   after all of them completed.
+ * - Every partition keeps the top n documents of its own, and the k-th score of it is shared with
+ *   the others through an atomic threshold, so every partition prunes by the best k-th score found
+ *   so far. The documents of the partitions are merged at last.
+ * - If any partition is stopped, the others are stopped at their next check.
+ */
+template <typename DocId, typename Score, typename Runner, typename StopCondition>
+auto read_topn_parallel(ParallelReader<DocId, Score>& reader, size_t count, const Score& min_score,
+    Runner&& run, StopCondition&& stop, bool& stopped, size_t check_interval = 64)
+-> std::vector<std::pair<DocId, Score>> {
+  typedef std::pair<DocId, Score> DocIdPair;
+  typedef std::vector<DocIdPair> DocIdVector;
+  auto& partitions = reader.get_partitions();
+  std::vector<DocIdVector> partition_results(partitions.size());
+  std::atomic<Score> shared_threshold(min_score);
+  std::atomic<bool> shared_stopped(false);
+  stopped = false;
+  if (count == 0) {
+    return DocIdVector();
+  }
+
+  run(partitions.size(), [&] (size_t part) {
+    PostingListReader<DocId, Score>& partition = *partitions[part];
+    DocIdVector& results = partition_results[part];
+    results.reserve(count);
+    Score threshold = shared_threshold.load(std::memory_order_relaxed);
+    partition.threshold(threshold);
+    size_t check_mask = check_interval - 1;
+    size_t n = 0;
+    for (DocId current = partition.next(DocId()); !!current; current = partition.next(current)) {
+      DocIdPair pair(current, partition.read());
+      if (results.size() < count) {
+        results.push_back(std::move(pair));
+        std::push_heap(results.begin(), results.end(), DocIdPairWeightGreater());
+      } else if (DocIdPairWeightGreater()(pair, results.front())) {
+        std::pop_heap(results.begin(), results.end(), DocIdPairWeightGreater());
+        results.back() = std::move(pair);
+        std::push_heap(results.begin(), results.end(), DocIdPairWeightGreater());
+      }
+      if (results.size() == count && results.front().second > threshold) {
+        raise_shared_threshold(shared_threshold, results.front().second);
+      }
+      // pick up the threshold raised by any partition
+      Score shared = shared_threshold.load(std::memory_order_relaxed);
+      if (shared > threshold) {
+        threshold = shared;
+        partition.threshold(threshold);
+      }
+      if ((++n & check_mask) == 0 && (shared_stopped.load(std::memory_order_relaxed) || stop())) {
+        shared_stopped.store(true, std::memory_order_relaxed);
+        break;
+      }
+    }
+  });
+
+  DocIdVector results;
+  for (auto& part: partition_results) {
+    results.insert(results.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+  }
+  if (results.size() > count) {
+    std::nth_element(results.begin(), results.begin() + (count - 1), results.end(), DocIdPairWeightGreater());
+    results.resize(count);
+  }
+  std::sort(results.begin(), results.end(), DocIdPairWeightGreater());
+  stopped = shared_stopped.load(std::memory_order_relaxed);
+  return results;
+}
+
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_CORE_READER_PARALLEL_READER_H_ */
@@ -1,6 +1,7 @@
 #ifndef SRC_MAIN_CORE_READER_POSTING_LIST_READER_H_
 #define SRC_MAIN_CORE_READER_POSTING_LIST_READER_H_
 
+#include <functional>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -65,6 +66,72 @@ public:
   virtual void threshold(const WeightByVal& weight) {
     (void) weight;
   }
+
+  /*
+   * -  Estimate the k-th greatest weight in the reader, so that there are at least k items with a weight not less
+   *    than the estimated weight. It could be used as the initial threshold of reading top k items.
+   * -  Return false if it could not be estimated. The default implementation is not to estimate.
+   *
+   * -  This function shall return in constant time.
+   */
+  virtual bool estimate_kth_weight(size_t k, WeightByVal& weight) {
+    (void) k;
+    (void) weight;
+    return false;
+  }
+
+  /*
+   * -  Read the k items with the greatest weights into head, sorted by weight in descending order. The cursor of
+   *    the reader is not moved.
+   * -  Return false if it is not supported, which is the default implementation, or k is greater than the number of
+   *    items kept for it. Then the top k items have to be read by iterating the reader.
+   *
+   * -  This function shall return in O(k) time.
+   */
+  virtual bool read_head(size_t k, std::vector<std::pair<DocId, WeightByVal>>& head) {
+    (void) k;
+    (void) head;
+    return false;
+  }
+
+  /*
+   * -  Read the next block of at most max items with doc ids greater than the param current, into doc_ids and
+   *    weights, in the order of doc ids. Return the number of items read, or zero if no more items found.
+   * -  The cursor is moved to the last item read, so that read() returns its weight and next() continues after it.
+   * -  The default implementation calls next() and read() for each item. Readers of contiguous postings could read
+   *    a whole block at once, and the readers scoring the items could score the whole block at once.
+   *
+   * -  This function shall return in O(distance + max) time.
+   */
+  virtual size_t next_block(DocId current, DocId* doc_ids, WeightByVal* weights, size_t max) {
+    size_t n = 0;
+    for (; n < max; ++n) {
+      current = next(current);
+      if (!current) {
+        break;
+      }
+      doc_ids[n] = current;
+      weights[n] = read();
+    }
+    return n;
+  }
+
+  /*
+   * -  Read the top k items with weights greater than min_weight into results, sorted by weight in descending order,
+   *    like read_topn_until(): stop() is checked every 64 items, and if it returns true, the reading is stopped with
+   *    stopped set to true. The reader reads itself by its concrete type, without a virtual call per item.
+   * -  Return false if it is not supported, which is the default implementation. Then the reader has to be iterated
+   *    through the virtual functions.
+   */
+  virtual bool read_topn_static(size_t k, const WeightByVal& min_weight, const std::function<bool ()>& stop,
+      bool& stopped, std::vector<std::pair<DocId, WeightByVal>>& results) {
+    (void) k;
+    (void) min_weight;
+    (void) stop;
+    (void) stopped;
+    (void) results;
+    return false;
+  }
 };
 } /* namespace redgiant */
 
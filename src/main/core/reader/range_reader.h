@@ -0,0 +1,68 @@
+#ifndef SRC_MAIN_CORE_READER_RANGE_READER_H_
+#define SRC_MAIN_CORE_READER_RANGE_READER_H_
+
+#include <memory>
+#include <utility>
+#include "core/reader/posting_list_reader.h"
+
+namespace redgiant {
+/*
+ * - This reader reads the documents of the input reader in a range of doc ids, which are greater
+ *   than after and not greater than last. An invalid after (DocId()) reads from the first document,
+ *   and an invalid last reads to the end.
+ * - The first call of next() seeks to the beginning of the range directly.
+ */
+template <typename DocId, typename Weight>
+class RangeReader : public PostingListReader<DocId, Weight> {
+public:
+  typedef PostingListReader<DocId, Weight> Reader;
+  typedef typename Reader::WeightByVal WeightByVal;
+
+  RangeReader(std::unique_ptr<Reader> reader, DocId after, DocId last)
+  : reader_(std::move(reader)), after_(after), last_(last), exhausted_(false) {
+  }
+
+  virtual ~RangeReader() = default;
+
+  virtual DocId next(DocId current) {
+    if (exhausted_) {
+      return DocId();
+    }
+    if (after_ && (!current || current < after_)) {
+      current = after_;
+    }
+    DocId doc_id = reader_->next(current);
+    if (!doc_id || (last_ && last_ < doc_id)) {
+      exhausted_ = true;
+      return DocId();
+    }
+    return doc_id;
+  }
+
+  virtual Weight read() {
+    return reader_->read();
+  }
+
+  virtual Weight upper_bound() {
+    return reader_->upper_bound();
+  }
+
+  // the size of the input reader, which is an estimation.
+  virtual size_t size() const {
+    return reader_->size();
+  }
+
+  virtual void threshold(const WeightByVal& weight) {
+    reader_->threshold(weight);
+  }
+
+private:
+  std::unique_ptr<Reader> reader_;
+  DocId after_;
+  DocId last_;
+  bool exhausted_;
+};
+
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_CORE_READER_RANGE_READER_H_ */
@@ -69,20 +69,32 @@ struct DocIdPairWeightGreater {
   }
 };
 
-template <typename DocId, typename Score>
-auto read_topn(PostingListReader<DocId, Score>& reader, size_t count, bool sort_weight = true)
+/*
+ * The same as read_topn_until(), but the reader is read by its concrete type Reader, so that the calls are
+ * bound statically and could be inlined if Reader is final, instead of a virtual call per document.
+ */
+template <typename DocId, typename Score, typename Reader, typename StopCondition>
+auto read_topn_direct(Reader& reader, size_t count, const typename std::decay<Score>::type& min_score,
+    StopCondition&& stop, bool& stopped, size_t check_interval = 64, bool sort_weight = true)
 -> std::vector<std::pair<DocId, typename std::decay<Score>::type>> {
   typedef typename std::decay<Score>::type WeightByVal;
   typedef std::pair<DocId, WeightByVal> DocIdPair;
   typedef std::vector<DocIdPair> DocIdVector;
   // dump results into this vector
   DocIdVector results;
+  stopped = false;
   if (count > 0) {
     results.reserve(count);
+    reader.threshold(min_score);
+    size_t check_mask = check_interval - 1;
+    size_t n = 0;
     for (DocId current = reader.next(DocId()); !!current; current = reader.next(current)) {
       if (results.size() < count) {
         results.emplace_back(current, reader.read());
         std::push_heap(results.begin(), results.end(), DocIdPairWeightGreater());
+        if (results.size() == count && results.front().second > min_score) {
+          reader.threshold(results.front().second);
+        }
       } else {
         auto pair = std::make_pair(current, reader.read());
         if (DocIdPairWeightGreater()(pair, results.front())) {
@@ -90,9 +102,15 @@ auto read_topn(PostingListReader<DocId, Score>& reader, size_t count, bool sort_
           results.back() = std::move(pair);
           std::push_heap(results.begin(), results.end(), DocIdPairWeightGreater());
           // hint the reader that we are expecting scores greater than threshold
-          reader.threshold(results.front().second);
+          if (results.front().second > min_score) {
+            reader.threshold(results.front().second);
+          }
         }
       }
+      if ((++n & check_mask) == 0 && stop()) {
+        stopped = true;
+        break;
+      }
     }
     if (sort_weight) {
       std::sort_heap(results.begin(), results.end(), DocIdPairWeightGreater());
@@ -101,6 +119,53 @@ auto read_topn(PostingListReader<DocId, Score>& reader, size_t count, bool sort_
   return results;
 }
 
+/*
+ * Read the top n documents, checking the stop condition every check_interval documents
+ * (must be a power of 2). If it returns true, the reading is stopped and the best documents
+ * read so far are returned, with stopped set to true.
+ * The reader starts with min_score as the threshold, so documents with a score not greater
+ * than min_score may be skipped. The threshold never drops below min_score.
+ */
+template <typename DocId, typename Score, typename StopCondition>
+auto read_topn_until(PostingListReader<DocId, Score>& reader, size_t count,
+    const typename std::decay<Score>::type& min_score, StopCondition&& stop,
+    bool& stopped, size_t check_interval = 64, bool sort_weight = true)
+-> std::vector<std::pair<DocId, typename std::decay<Score>::type>> {
+  return read_topn_direct<DocId, Score>(reader, count, min_score, std::forward<StopCondition>(stop), stopped,
+      check_interval, sort_weight);
+}
+
+template <typename DocId, typename Score>
+auto read_topn(PostingListReader<DocId, Score>& reader, size_t count, bool sort_weight = true)
+-> std::vector<std::pair<DocId, typename std::decay<Score>::type>> {
+  typedef typename std::decay<Score>::type WeightByVal;
+  bool stopped;
+  // never stop, the check is optimized out
+  return read_topn_until(reader, count, WeightByVal(), [] { return false; }, stopped, 1, sort_weight);
+}
+
+/*
+ * Estimate the k-th score of the documents scored by the sum of the readers.
+ * A document scores no less than any of its terms if no term scores negative, so the greatest
+ * estimation of the readers is also a lower bound of the k-th score. The least score of a reader
+ * is estimated as its size-th score.
+ */
+template <typename TermReader, typename Score>
+bool estimate_sum_kth_weight(const std::vector<std::unique_ptr<TermReader>>& readers, size_t k, Score& score) {
+  bool found = false;
+  Score term_score;
+  for (auto& reader: readers) {
+    if (!reader->estimate_kth_weight(reader->size(), term_score) || term_score < Score(0)) {
+      return false;
+    }
+    if (reader->estimate_kth_weight(k, term_score) && (!found || term_score > score)) {
+      score = term_score;
+      found = true;
+    }
+  }
+  return found;
+}
+
 template <typename DocId, typename Weight>
 auto read_single(PostingListReader<DocId, Weight>& reader, DocId key)
 -> std::unique_ptr<typename std::decay<Weight>::type> {
@@ -0,0 +1,110 @@
+#ifndef SRC_MAIN_CORE_READER_SCORE_ACCUMULATOR_H_
+#define SRC_MAIN_CORE_READER_SCORE_ACCUMULATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace redgiant {
+/*
+ * - Accumulates the scores of documents, in a hash table of open addressing
+ *   with linear probing. The documents and scores are kept in separate arrays
+ *   in the order of first seen, so that the scores are scanned contiguously.
+ * - It is meant to be reused (e.g. one per thread), so the memory allocated
+ *   is kept over reset() calls.
+ */
+template <typename DocId, typename Score, typename DocIdHash>
+class ScoreAccumulator {
+public:
+  static constexpr size_t kMinCapacity = 16;
+
+  ScoreAccumulator()
+  : mask_(0), shift_(64) {
+    reset_slots(kMinCapacity);
+  }
+
+  ~ScoreAccumulator() = default;
+
+  // clear the documents, and prepare for the expected number of documents.
+  void reset(size_t expected) {
+    size_t capacity = kMinCapacity;
+    // load factor no more than 0.5
+    while (capacity < expected * 2) {
+      capacity <<= 1;
+    }
+    reset_slots(capacity);
+    doc_ids_.clear();
+    scores_.clear();
+    doc_ids_.reserve(expected);
+    scores_.reserve(expected);
+  }
+
+  void add(const DocId& doc_id, const Score& score) {
+    // mix the bits of hash, which may be sequential
+    size_t slot = (uint64_t)(hasher_(doc_id) * 0x9E3779B97F4A7C15ull) >> shift_;
+    for (;; slot = (slot + 1) & mask_) {
+      uint32_t index = slots_[slot];
+      if (index == 0) {
+        doc_ids_.push_back(doc_id);
+        scores_.push_back(score);
+        slots_[slot] = doc_ids_.size();
+        if (doc_ids_.size() * 2 > slots_.size()) {
+          grow();
+        }
+        return;
+      }
+      if (doc_ids_[index - 1] == doc_id) {
+        scores_[index - 1] += score;
+        return;
+      }
+    }
+  }
+
+  size_t size() const {
+    return doc_ids_.size();
+  }
+
+  std::vector<DocId>& get_doc_ids() {
+    return doc_ids_;
+  }
+
+  std::vector<Score>& get_scores() {
+    return scores_;
+  }
+
+private:
+  void grow() {
+    size_t size = doc_ids_.size();
+    reset_slots(slots_.size() * 2);
+    for (size_t i = 0; i < size; ++i) {
+      size_t slot = (uint64_t)(hasher_(doc_ids_[i]) * 0x9E3779B97F4A7C15ull) >> shift_;
+      while (slots_[slot] != 0) {
+        slot = (slot + 1) & mask_;
+      }
+      slots_[slot] = i + 1;
+    }
+  }
+
+  void reset_slots(size_t capacity) {
+    slots_.assign(capacity, 0);
+    mask_ = capacity - 1;
+    shift_ = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) {
+      --shift_;
+    }
+  }
+
+  // indexes of documents plus 1, 0 for empty slots
+  std::vector<uint32_t> slots_;
+  size_t mask_;
+  int shift_;
+  std::vector<DocId> doc_ids_;
+  std::vector<Score> scores_;
+  DocIdHash hasher_;
+};
+
+template <typename DocId, typename Score, typename DocIdHash>
+constexpr size_t ScoreAccumulator<DocId, Score, DocIdHash>::kMinCapacity;
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_CORE_READER_SCORE_ACCUMULATOR_H_ */
@@ -0,0 +1,183 @@
+#ifndef SRC_MAIN_CORE_READER_TAAT_READER_H_
+#define SRC_MAIN_CORE_READER_TAAT_READER_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "core/reader/posting_list_reader.h"
+#include "core/reader/score_accumulator.h"
+
+namespace redgiant {
+/*
+ * - This reader reads the terms one by one (term-at-a-time), and accumulates
+ *   the scores of all documents before reading. Every posting is read exactly
+ *   once without any skipping, which is the cheapest way for queries of a few
+ *   short posting lists.
+ * - The scores are accumulated in a hash table reused by the readers of the
+ *   same thread. The top k documents are selected from the scores directly
+ *   by read_head(), and the documents are sorted by doc ids only if iterated.
+ */
+template <typename DocId, typename Score, typename DocIdHash = std::hash<DocId>>
+class TaatReader : public PostingListReader<DocId, Score> {
+public:
+  typedef PostingListReader<DocId, Score> Reader;
+  typedef ScoreAccumulator<DocId, Score, DocIdHash> Accumulator;
+
+  static constexpr size_t kBlockSize = 128;
+
+  TaatReader(std::vector<std::unique_ptr<Reader>>&& input_readers)
+  : upper_bound_(0), pos_(0), sorted_(false) {
+    accumulate(input_readers, [] { return false; });
+  }
+
+  // stop() is checked between the blocks of postings. If it returns true, the rest of the postings are not
+  // read, and the scores are accumulated from the postings read so far, with stopped set to true.
+  template <typename StopCondition>
+  TaatReader(std::vector<std::unique_ptr<Reader>>&& input_readers, StopCondition&& stop, bool& stopped)
+  : upper_bound_(0), pos_(0), sorted_(false) {
+    stopped = !accumulate(input_readers, std::forward<StopCondition>(stop));
+  }
+
+  virtual ~TaatReader() = default;
+
+  virtual DocId next(DocId current) {
+    if (!sorted_) {
+      sort();
+    }
+    for (; pos_ < order_.size(); ++pos_) {
+      if (current < doc_ids_[order_[pos_]]) {
+        return doc_ids_[order_[pos_]];
+      }
+    }
+    return DocId(); // invalid
+  }
+
+  virtual Score read() {
+    return scores_[order_[pos_]];
+  }
+
+  virtual Score upper_bound() {
+    return upper_bound_;
+  }
+
+  virtual size_t size() const {
+    return scores_.size();
+  }
+
+  virtual bool estimate_kth_weight(size_t k, Score& score) {
+    if (k == 0 || k > scores_.size()) {
+      return false;
+    }
+    score = select_kth(k);
+    return true;
+  }
+
+  // all documents are returned if less than k.
+  virtual bool read_head(size_t k, std::vector<std::pair<DocId, Score>>& head) {
+    if (k == 0 || scores_.empty()) {
+      return false;
+    }
+    k = std::min(k, scores_.size());
+    Score kth = select_kth(k);
+    // a single pass over the scores, documents of the k-th score are added by doc ids
+    head.clear();
+    head.reserve(k);
+    std::vector<std::pair<DocId, Score>> ties;
+    for (size_t i = 0; i < scores_.size(); ++i) {
+      if (scores_[i] > kth) {
+        head.emplace_back(doc_ids_[i], scores_[i]);
+      } else if (!(scores_[i] < kth)) {
+        ties.emplace_back(doc_ids_[i], scores_[i]);
+      }
+    }
+    std::sort(ties.begin(), ties.end(), [] (const std::pair<DocId, Score>& lhs, const std::pair<DocId, Score>& rhs) {
+      return lhs.first < rhs.first;
+    });
+    for (size_t i = 0; head.size() < k && i < ties.size(); ++i) {
+      head.push_back(std::move(ties[i]));
+    }
+    std::sort(head.begin(), head.end(), [] (const std::pair<DocId, Score>& lhs, const std::pair<DocId, Score>& rhs) {
+      return lhs.second > rhs.second || (!(rhs.second > lhs.second) && lhs.first < rhs.first);
+    });
+    return true;
+  }
+
+private:
+  // false if stopped before all postings are read.
+  template <typename StopCondition>
+  bool accumulate(const std::vector<std::unique_ptr<Reader>>& input_readers, StopCondition&& stop) {
+    static thread_local Accumulator accumulator;
+    size_t size = 0;
+    for (const auto& reader: input_readers) {
+      size += reader->size();
+    }
+    accumulator.reset(size);
+    // the postings are read and scored by blocks
+    DocId block_doc_ids[kBlockSize];
+    Score block_scores[kBlockSize];
+    bool completed = true;
+    for (const auto& reader: input_readers) {
+      DocId current = DocId();
+      for (size_t n = reader->next_block(current, block_doc_ids, block_scores, kBlockSize); n > 0;
+          n = reader->next_block(current, block_doc_ids, block_scores, kBlockSize)) {
+        for (size_t i = 0; i < n; ++i) {
+          accumulator.add(block_doc_ids[i], block_scores[i]);
+        }
+        current = block_doc_ids[n - 1];
+        if (stop()) {
+          completed = false;
+          break;
+        }
+      }
+      if (!completed) {
+        break;
+      }
+    }
+    // copied out, so that the memory of the accumulator is kept for the next reader
+    doc_ids_.assign(accumulator.get_doc_ids().begin(), accumulator.get_doc_ids().end());
+    scores_.assign(accumulator.get_scores().begin(), accumulator.get_scores().end());
+    for (size_t i = 0; i < scores_.size(); ++i) {
+      if (i == 0 || scores_[i] > upper_bound_) {
+        upper_bound_ = scores_[i];
+      }
+    }
+    return completed;
+  }
+
+  // the k-th greatest score, 0 < k <= size
+  Score select_kth(size_t k) const {
+    std::vector<Score> scores(scores_);
+    std::nth_element(scores.begin(), scores.begin() + (k - 1), scores.end(), std::greater<Score>());
+    return scores[k - 1];
+  }
+
+  void sort() {
+    order_.resize(doc_ids_.size());
+    for (size_t i = 0; i < order_.size(); ++i) {
+      order_[i] = i;
+    }
+    std::sort(order_.begin(), order_.end(), [this] (uint32_t lhs, uint32_t rhs) {
+      return doc_ids_[lhs] < doc_ids_[rhs];
+    });
+    sorted_ = true;
+  }
+
+  // accumulated documents and scores, in the order of first seen
+  std::vector<DocId> doc_ids_;
+  std::vector<Score> scores_;
+  // indexes sorted by doc ids
+  std::vector<uint32_t> order_;
+  Score upper_bound_;
+  size_t pos_;
+  bool sorted_;
+};
+
+template <typename DocId, typename Score, typename DocIdHash>
+constexpr size_t TaatReader<DocId, Score, DocIdHash>::kBlockSize;
+
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_CORE_READER_TAAT_READER_H_ */
@@ -3,14 +3,17 @@
 
 #include <algorithm>
 #include <set>
+#include "core/reader/reader_utils.h"
 #include "core/reader/wand_reader.h"
 
 namespace redgiant {
 
-template <typename DocId, typename Score>
-WandReader<DocId, Score>::WandReader(std::vector<std::unique_ptr<Reader>>&& input_readers)
+template <typename DocId, typename Score, typename TermReader>
+WandReader<DocId, Score, TermReader>::WandReader(std::vector<std::unique_ptr<Reader>>&& input_readers,
+    std::vector<std::unique_ptr<PriorReader>>&& prior_readers)
 : readers_(std::move(input_readers)), reader_cursors_(readers_.size(), 0), upper_bounds_(readers_.size()),
-  sorted_indexes_(readers_.size()), acc_upper_bounds_(readers_.size()), threshold_(0) {
+  sorted_indexes_(readers_.size()), acc_upper_bounds_(readers_.size()), priors_(std::move(prior_readers)),
+  prior_cursors_(priors_.size()), prior_upper_bound_(0), threshold_(0) {
   // zero initialized containers and threshold
   // keep the initial order by default
   size_t i = 0;
@@ -20,10 +23,14 @@ WandReader<DocId, Score>::WandReader(std::vector<std::unique_ptr<Reader>>&& inpu
       [] (const std::unique_ptr<Reader>& reader) { return reader->upper_bound(); });
   // sum upper bound scores in the sequence of sorted terms
   std::partial_sum(upper_bounds_.begin(), upper_bounds_.end(), acc_upper_bounds_.begin());
+  for (const auto& prior: priors_) {
+    prior_upper_bound_ += prior->upper_bound();
+  }
+  threshold_ -= prior_upper_bound_;
 }
 
-template <typename DocId, typename Score>
-DocId WandReader<DocId, Score>::next(DocId current) {
+template <typename DocId, typename Score, typename TermReader>
+DocId WandReader<DocId, Score, TermReader>::next(DocId current) {
   size_t pivot = find_pivot(0);
   for (;;) {
     // check pivot valid
@@ -47,8 +54,8 @@ DocId WandReader<DocId, Score>::next(DocId current) {
   }
 }
 
-template <typename DocId, typename Score>
-Score WandReader<DocId, Score>::read() {
+template <typename DocId, typename Score, typename TermReader>
+Score WandReader<DocId, Score, TermReader>::read() {
   Score score(0);
   DocId current = reader_cursors_[sorted_indexes_[0]];
   for (size_t index: sorted_indexes_) {
@@ -58,27 +65,69 @@ Score WandReader<DocId, Score>::read() {
     }
     score += readers_[index]->read();
   }
+  if (!priors_.empty()) {
+    score += read_priors(current);
+  }
   return score;
 }
 
-template <typename DocId, typename Score>
-Score WandReader<DocId, Score>::upper_bound() {
+template <typename DocId, typename Score, typename TermReader>
+Score WandReader<DocId, Score, TermReader>::upper_bound() {
   if (acc_upper_bounds_.size() > 0) {
-    return acc_upper_bounds_.back();
+    return acc_upper_bounds_.back() + prior_upper_bound_;
   }
   return Score(0);
 }
 
-template <typename DocId, typename Score>
-size_t WandReader<DocId, Score>::find_pivot(size_t from) {
+template <typename DocId, typename Score, typename TermReader>
+Score WandReader<DocId, Score, TermReader>::read_priors(DocId current) {
+  Score score(0);
+  for (size_t i = 0; i < priors_.size(); ) {
+    if (prior_cursors_[i] < current) {
+      // the documents are read in ascending order, so the priors only move forward
+      DocId before = current;
+      prior_cursors_[i] = priors_[i]->next(--before);
+      if (!prior_cursors_[i]) {
+        // read to the end, the upper bound is kept
+        priors_[i] = std::move(priors_.back());
+        priors_.pop_back();
+        prior_cursors_[i] = prior_cursors_.back();
+        prior_cursors_.pop_back();
+        continue;
+      }
+    }
+    if (prior_cursors_[i] == current) {
+      score += priors_[i]->read();
+    }
+    ++i;
+  }
+  return score;
+}
+
+// the priors only raise the scores, so the estimation of the terms is still a lower bound.
+template <typename DocId, typename Score, typename TermReader>
+bool WandReader<DocId, Score, TermReader>::estimate_kth_weight(size_t k, Score& score) {
+  return estimate_sum_kth_weight(readers_, k, score);
+}
+
+template <typename DocId, typename Score, typename TermReader>
+bool WandReader<DocId, Score, TermReader>::read_topn_static(size_t k, const Score& min_score,
+    const std::function<bool ()>& stop, bool& stopped, std::vector<std::pair<DocId, Score>>& results) {
+  // the class is final, so the calls to itself are not virtual.
+  results = read_topn_direct<DocId, Score>(*this, k, min_score, stop, stopped);
+  return true;
+}
+
+template <typename DocId, typename Score, typename TermReader>
+size_t WandReader<DocId, Score, TermReader>::find_pivot(size_t from) {
   // find the first element, that is greater than threshold_
   auto i = std::upper_bound(acc_upper_bounds_.begin() + from, acc_upper_bounds_.end(), threshold_);
   // if not found, return value is acc_upper_bounds_.size() and also equal to readers_.size()
   return i - acc_upper_bounds_.begin();
 }
 
-template <typename DocId, typename Score>
-size_t WandReader<DocId, Score>::pick_term(size_t pivot, DocId cursor) {
+template <typename DocId, typename Score, typename TermReader>
+size_t WandReader<DocId, Score, TermReader>::pick_term(size_t pivot, DocId cursor) {
   (void)pivot;
   (void)cursor;
   // TODO: optimize
@@ -87,8 +136,8 @@ size_t WandReader<DocId, Score>::pick_term(size_t pivot, DocId cursor) {
   return 0;
 }
 
-template <typename DocId, typename Score>
-size_t WandReader<DocId, Score>::step_next(size_t pivot, DocId cursor) {
+template <typename DocId, typename Score, typename TermReader>
+size_t WandReader<DocId, Score, TermReader>::step_next(size_t pivot, DocId cursor) {
   pivot++; // make sure pivot will not go negative
   while (pivot > 0 && acc_upper_bounds_[pivot-1] > threshold_) {
     // note: picked term may be the previous pivot itself
@@ -111,8 +160,8 @@ size_t WandReader<DocId, Score>::step_next(size_t pivot, DocId cursor) {
   return find_pivot(pivot);
 }
 
-template <typename DocId, typename Score>
-void WandReader<DocId, Score>::remove_term(size_t term) {
+template <typename DocId, typename Score, typename TermReader>
+void WandReader<DocId, Score, TermReader>::remove_term(size_t term) {
   Score score(0);
   if (term > 0) {
     score = acc_upper_bounds_[term-1];
@@ -129,8 +178,8 @@ void WandReader<DocId, Score>::remove_term(size_t term) {
   acc_upper_bounds_.pop_back();
 }
 
-template <typename DocId, typename Score>
-void WandReader<DocId, Score>::move_term(size_t term) {
+template <typename DocId, typename Score, typename TermReader>
+void WandReader<DocId, Score, TermReader>::move_term(size_t term) {
   Score score(0);
   if (term > 0) {
     score = acc_upper_bounds_[term-1];
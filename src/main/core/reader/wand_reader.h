@@ -1,36 +1,57 @@
 #ifndef SRC_MAIN_CORE_READER_WAND_READER_H_
 #define SRC_MAIN_CORE_READER_WAND_READER_H_
 
+#include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 #include "core/reader/posting_list_reader.h"
 
 namespace redgiant {
 class WandReaderTest;
 
-template <typename DocId, typename Score>
-class WandReader : public PostingListReader<DocId, Score> {
+/*
+ * TermReader is the type of the term readers. If it is a final class, e.g. a DotProductReader over a concrete
+ * posting list reader, the calls to the terms are bound statically and could be inlined, and so is the top k loop
+ * of read_topn_static(). Otherwise the terms are read through the virtual PostingListReader interface.
+ *
+ * The priors are readers of query-independent scores of documents, e.g. popularity. They are not searched like the
+ * terms: only the documents found by the terms are looked up in them, and their upper bounds are added to the
+ * bounds of the terms, so a prior covering the whole corpus does not stop the terms from being skipped. The scores
+ * of the priors shall not be negative.
+ */
+template <typename DocId, typename Score, typename TermReader = PostingListReader<DocId, Score>>
+class WandReader final : public PostingListReader<DocId, Score> {
 public:
   friend class WandReaderTest;
-  typedef PostingListReader<DocId, Score> Reader;
+  typedef TermReader Reader;
+  typedef PostingListReader<DocId, Score> PriorReader;
 
-  WandReader(std::vector<std::unique_ptr<Reader>>&& input_readers);
+  WandReader(std::vector<std::unique_ptr<Reader>>&& input_readers,
+      std::vector<std::unique_ptr<PriorReader>>&& prior_readers = std::vector<std::unique_ptr<PriorReader>>());
   virtual ~WandReader() = default;
 
   virtual DocId next(DocId current);
   virtual Score read();
   virtual Score upper_bound();
 
-  virtual void threshold(Score threshold) {
-    threshold_ = threshold;
+  // the threshold of the terms is lowered by the upper bound of the priors.
+  virtual void threshold(const Score& threshold) {
+    threshold_ = threshold - prior_upper_bound_;
   }
 
+  virtual bool estimate_kth_weight(size_t k, Score& score);
+
+  virtual bool read_topn_static(size_t k, const Score& min_score, const std::function<bool ()>& stop,
+      bool& stopped, std::vector<std::pair<DocId, Score>>& results);
+
 private:
   size_t find_pivot(size_t from);
   size_t pick_term(size_t pivot, DocId cursor);
   size_t step_next(size_t pivot, DocId cursor);
   void remove_term(size_t term_index);
   void move_term(size_t term_index);
+  Score read_priors(DocId current);
 
 private:
   // saved readers
@@ -43,6 +64,10 @@ private:
   std::vector<size_t> sorted_indexes_;
   // accumulated upper bounds of readers in the sorted order
   std::vector<Score> acc_upper_bounds_;
+  // the priors, and their cursors not greater than the current document
+  std::vector<std::unique_ptr<PriorReader>> priors_;
+  std::vector<DocId> prior_cursors_;
+  Score prior_upper_bound_;
   Score threshold_;
 };
 
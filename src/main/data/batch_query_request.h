@@ -0,0 +1,60 @@
+#ifndef SRC_MAIN_DATA_BATCH_QUERY_REQUEST_H_
+#define SRC_MAIN_DATA_BATCH_QUERY_REQUEST_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "data/query_request.h"
+#include "utils/stop_watch.h"
+
+namespace redgiant {
+/*
+ * A batch of queries sent in a single request.
+ * The request id of each query is the id given in the batch, or its index if not given.
+ */
+class BatchQueryRequest {
+public:
+  BatchQueryRequest(const std::string& request_id, StopWatch watch = StopWatch(), bool debug = false)
+  : request_id_(request_id), watch_(watch), debug_(debug) {
+  }
+
+  // no copy
+  BatchQueryRequest(const BatchQueryRequest&) = delete;
+  BatchQueryRequest& operator= (const BatchQueryRequest&) = delete;
+
+  ~BatchQueryRequest() = default;
+
+  const std::string& get_request_id() const {
+    return request_id_;
+  }
+
+  std::vector<QueryRequest>& get_queries() {
+    return queries_;
+  }
+
+  const std::vector<QueryRequest>& get_queries() const {
+    return queries_;
+  }
+
+  void add_query(QueryRequest query) {
+    queries_.push_back(std::move(query));
+  }
+
+  const StopWatch& get_watch() const {
+    return watch_;
+  }
+
+  bool is_debug() const {
+    return debug_;
+  }
+
+private:
+  std::string request_id_;
+  std::vector<QueryRequest> queries_;
+  StopWatch watch_;
+  bool debug_;
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_DATA_BATCH_QUERY_REQUEST_H_ */
@@ -0,0 +1,85 @@
+#include "data/batch_query_request_parser.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "data/batch_query_request.h"
+#include "data/query_request.h"
+#include "utils/json_utils.h"
+#include "utils/logger.h"
+
+namespace redgiant {
+
+DECLARE_LOGGER(logger, __FILE__);
+
+const size_t BatchQueryRequestParser::kMaxQueries;
+const size_t BatchQueryRequestParser::kMaxBulkQueries;
+const int BatchQueryRequestParser::kDefaultQueryCount;
+
+int BatchQueryRequestParser::parse_json(const rapidjson::Value& root, BatchQueryRequest& output) {
+  if (!root.IsObject()) {
+    LOG_ERROR(logger, "request object does not exist.");
+    return -1;
+  }
+
+  auto queries = json_get_array(root, "queries");
+  if (!queries || queries->Empty()) {
+    LOG_ERROR(logger, "batch[%s]: no queries found!", output.get_request_id().c_str());
+    return -1;
+  }
+  if (queries->Size() > max_queries_) {
+    LOG_ERROR(logger, "batch[%s]: too many queries: %u, max %zu", output.get_request_id().c_str(),
+        queries->Size(), max_queries_);
+    return -1;
+  }
+
+  // parsed only once for all queries sharing them
+  std::unique_ptr<QueryRequest> shared;
+  auto features = json_get_object(root, "features");
+  if (features) {
+    shared.reset(new QueryRequest(output.get_request_id(), 0, "", output.get_watch(), output.is_debug()));
+    if (query_parser_.parse_feature_spaces(*features, *shared) < 0) {
+      return -1;
+    }
+  }
+
+  output.get_queries().reserve(queries->Size());
+  for (rapidjson::SizeType i = 0; i < queries->Size(); ++i) {
+    const rapidjson::Value& query = (*queries)[i];
+    if (!query.IsObject()) {
+      LOG_ERROR(logger, "batch[%s]: query %u is not an object", output.get_request_id().c_str(), i);
+      return -1;
+    }
+
+    std::string id;
+    if (!json_try_get_value(query, "id", id)) {
+      id = std::to_string(i);
+    }
+    std::string model;
+    json_try_get_value(query, "model", model);
+    int count = kDefaultQueryCount;
+    if (json_get_node(query, "count") && (!json_try_get_value(query, "count", count) || count <= 0)) {
+      LOG_ERROR(logger, "batch[%s]: invalid count of query %s", output.get_request_id().c_str(), id.c_str());
+      return -1;
+    }
+
+    QueryRequest request(id, count, std::move(model), output.get_watch(), output.is_debug());
+    auto query_features = json_get_object(query, "features");
+    if (query_features) {
+      if (query_parser_.parse_feature_spaces(*query_features, request) < 0) {
+        return -1;
+      }
+    } else if (shared) {
+      request.copy_features(*shared);
+    } else {
+      LOG_ERROR(logger, "batch[%s]: no features found for query %s", output.get_request_id().c_str(), id.c_str());
+      return -1;
+    }
+    output.add_query(std::move(request));
+  }
+
+  return 0;
+}
+
+} /* namespace redgiant */
@@ -0,0 +1,63 @@
+#ifndef SRC_MAIN_DATA_BATCH_QUERY_REQUEST_PARSER_H_
+#define SRC_MAIN_DATA_BATCH_QUERY_REQUEST_PARSER_H_
+
+#include <memory>
+#include "data/json_parser.h"
+#include "data/query_request_parser.h"
+
+namespace redgiant {
+class BatchQueryRequest;
+class FeatureSpaceManager;
+
+/*
+ * Parses a batch of queries, e.g.
+ * {
+ *   "features": { "category": { "3": 1.0 } },
+ *   "queries": [
+ *     { "id": "top", "model": "mixed", "count": 10 },
+ *     { "id": "news", "model": "category_only", "count": 5,
+ *       "features": { "category": { "5": 1.0 } } }
+ *   ]
+ * }
+ * The top level features are parsed once and shared by the queries without their own features.
+ */
+class BatchQueryRequestParser: public JsonParser<BatchQueryRequest> {
+public:
+  static const size_t kMaxQueries = 64;
+  // the bulk queries are searched together
+  static const size_t kMaxBulkQueries = 4096;
+  static const int kDefaultQueryCount = 10;
+
+  BatchQueryRequestParser(std::shared_ptr<FeatureSpaceManager> feature_spaces, size_t max_queries = kMaxQueries)
+  : query_parser_(std::move(feature_spaces)), max_queries_(max_queries) {
+  }
+
+  virtual ~BatchQueryRequestParser() = default;
+
+  virtual int parse_json(const rapidjson::Value &root, BatchQueryRequest& output);
+
+private:
+  QueryRequestParser query_parser_;
+  size_t max_queries_;
+};
+
+class BatchQueryRequestParserFactory: public ParserFactory<BatchQueryRequest> {
+public:
+  BatchQueryRequestParserFactory(std::shared_ptr<FeatureSpaceManager> feature_spaces,
+      size_t max_queries = BatchQueryRequestParser::kMaxQueries)
+  : feature_spaces_(std::move(feature_spaces)), max_queries_(max_queries) {
+  }
+
+  virtual ~BatchQueryRequestParserFactory() = default;
+
+  std::unique_ptr<Parser<BatchQueryRequest>> create_parser() {
+    return std::unique_ptr<Parser<BatchQueryRequest>>(new BatchQueryRequestParser(feature_spaces_, max_queries_));
+  }
+
+private:
+  std::shared_ptr<FeatureSpaceManager> feature_spaces_;
+  size_t max_queries_;
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_DATA_BATCH_QUERY_REQUEST_PARSER_H_ */
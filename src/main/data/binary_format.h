@@ -0,0 +1,92 @@
+#ifndef SRC_MAIN_DATA_BINARY_FORMAT_H_
+#define SRC_MAIN_DATA_BINARY_FORMAT_H_
+
+#include <endian.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace redgiant {
+/*
+ * The compact binary wire format of documents and queries, used when the content type
+ * of request is "application/x-redgiant-binary". All numbers are little endian.
+ *
+ * Document record:
+ *   uint32    length of the rest of the record
+ *   byte[16]  raw document id (see DocumentId::from_raw, and NumericDocumentId::from_raw for
+ *             the numeric ids)
+ *   uint32    number of features
+ *   repeated  { uint64 feature id, float32 weight }
+ * A document request may contain multiple records one after another.
+ *
+ * Query record:
+ *   uint32    length of the rest of the record
+ *   uint32    number of features
+ *   repeated  { uint64 feature id, float32 weight }
+ *
+ * Feature ids are the final ids used by the index: the space id in the high 8 bits, and
+ * the integer key, or the hash of string key, in the low 56 bits.
+ */
+class BinaryFormat {
+public:
+  static const size_t kLengthSize = 4;
+  static const size_t kCountSize = 4;
+  static const size_t kDocIdSize = 16;
+  static const size_t kFeatureSize = 12;
+  static const size_t kDocumentHeaderSize = kLengthSize + kDocIdSize + kCountSize;
+  static const size_t kQueryHeaderSize = kLengthSize + kCountSize;
+
+  static bool is_binary_content(const std::string& content_type) {
+    static const char kContentType[] = "application/x-redgiant-binary";
+    // ignore parameters like charset
+    return content_type.compare(0, sizeof(kContentType) - 1, kContentType) == 0;
+  }
+
+  // return the size of the first record in buffer, including the length field.
+  // return 0 if the buffer does not contain a complete record.
+  static size_t get_record_size(const char* data, size_t len) {
+    if (len < kLengthSize) {
+      return 0;
+    }
+    size_t record_size = kLengthSize + read_uint32(data);
+    return record_size <= len ? record_size : 0;
+  }
+
+  static uint32_t read_uint32(const char* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return le32toh(value);
+  }
+
+  static uint64_t read_uint64(const char* data) {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return le64toh(value);
+  }
+
+  static float read_float(const char* data) {
+    uint32_t bits = read_uint32(data);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  static void write_uint32(uint32_t value, std::string& out) {
+    value = htole32(value);
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  static void write_uint64(uint64_t value, std::string& out) {
+    value = htole64(value);
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  static void write_float(float value, std::string& out) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    write_uint32(bits, out);
+  }
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_DATA_BINARY_FORMAT_H_ */
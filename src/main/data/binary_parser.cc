@@ -0,0 +1,65 @@
+#include "data/binary_parser.h"
+
+#include "data/binary_format.h"
+#include "data/document.h"
+#include "data/query_request.h"
+#include "utils/logger.h"
+
+namespace redgiant {
+
+DECLARE_LOGGER(logger, __FILE__);
+
+int BinaryDocumentParser::parse(const char* str, size_t len, Document& output) {
+  if (len < BinaryFormat::kDocumentHeaderSize || BinaryFormat::get_record_size(str, len) != len) {
+    LOG_ERROR(logger, "binary document: invalid record length %zu.", len);
+    return -1;
+  }
+
+  Document::DocId doc_id = Document::DocId::from_raw(str + BinaryFormat::kLengthSize);
+  if (!doc_id) {
+    LOG_ERROR(logger, "binary document: document id is missing or invalid.");
+    return -1;
+  }
+  if (LOG_TRACE_ENABLED(logger)) {
+    output.set_doc_id(doc_id.to_string());
+  } else {
+    // do not format the id string if it is not printed
+    output.set_doc_id(doc_id);
+  }
+
+  size_t count = BinaryFormat::read_uint32(str + BinaryFormat::kLengthSize + BinaryFormat::kDocIdSize);
+  if (len != BinaryFormat::kDocumentHeaderSize + count * BinaryFormat::kFeatureSize) {
+    LOG_ERROR(logger, "binary document: %zu features does not match record length %zu.", count, len);
+    return -1;
+  }
+
+  const char* p = str + BinaryFormat::kDocumentHeaderSize;
+  for (size_t i = 0; i < count; ++i, p += BinaryFormat::kFeatureSize) {
+    output.add_term(BinaryFormat::read_uint64(p), BinaryFormat::read_float(p + 8));
+  }
+  LOG_TRACE(logger, "document[%s]: parsed %zu features from binary.", output.get_id_str().c_str(), count);
+  return 0;
+}
+
+int BinaryQueryRequestParser::parse(const char* str, size_t len, QueryRequest& output) {
+  if (len < BinaryFormat::kQueryHeaderSize || BinaryFormat::get_record_size(str, len) != len) {
+    LOG_ERROR(logger, "request[%s]: invalid binary record length %zu.",
+        output.get_request_id().c_str(), len);
+    return -1;
+  }
+
+  size_t count = BinaryFormat::read_uint32(str + BinaryFormat::kLengthSize);
+  if (len != BinaryFormat::kQueryHeaderSize + count * BinaryFormat::kFeatureSize) {
+    LOG_ERROR(logger, "request[%s]: %zu features does not match binary record length %zu.",
+        output.get_request_id().c_str(), count, len);
+    return -1;
+  }
+
+  const char* p = str + BinaryFormat::kQueryHeaderSize;
+  for (size_t i = 0; i < count; ++i, p += BinaryFormat::kFeatureSize) {
+    output.add_term(BinaryFormat::read_uint64(p), BinaryFormat::read_float(p + 8));
+  }
+  return 0;
+}
+
+} /* namespace redgiant */
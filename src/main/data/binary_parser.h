@@ -0,0 +1,74 @@
+#ifndef SRC_MAIN_DATA_BINARY_PARSER_H_
+#define SRC_MAIN_DATA_BINARY_PARSER_H_
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include "data/parser.h"
+
+namespace redgiant {
+class Document;
+class QueryRequest;
+
+/*
+ * Parsers of the binary format defined in data/binary_format.h.
+ * Each call parses exactly one record.
+ */
+template <typename Output>
+class BinaryParser: public Parser<Output> {
+public:
+  BinaryParser() = default;
+  virtual ~BinaryParser() = default;
+
+  virtual int parse_file(const char* file_name, Output& output) {
+    std::ifstream is(file_name, std::ios::in | std::ios::binary);
+    if (!is) {
+      return -1;
+    }
+    std::string content((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    return this->parse(content.data(), content.size(), output);
+  }
+};
+
+// the features are added to the flat terms of document, the id in record is always used.
+class BinaryDocumentParser: public BinaryParser<Document> {
+public:
+  BinaryDocumentParser() = default;
+  virtual ~BinaryDocumentParser() = default;
+
+  virtual int parse(const char* str, size_t len, Document& output);
+};
+
+// the features are added to the flat terms of request.
+class BinaryQueryRequestParser: public BinaryParser<QueryRequest> {
+public:
+  BinaryQueryRequestParser() = default;
+  virtual ~BinaryQueryRequestParser() = default;
+
+  virtual int parse(const char* str, size_t len, QueryRequest& output);
+};
+
+class BinaryDocumentParserFactory: public ParserFactory<Document> {
+public:
+  BinaryDocumentParserFactory() = default;
+  virtual ~BinaryDocumentParserFactory() = default;
+
+  std::unique_ptr<Parser<Document>> create_parser() {
+    return std::unique_ptr<Parser<Document>>(new BinaryDocumentParser());
+  }
+};
+
+class BinaryQueryRequestParserFactory: public ParserFactory<QueryRequest> {
+public:
+  BinaryQueryRequestParserFactory() = default;
+  virtual ~BinaryQueryRequestParserFactory() = default;
+
+  std::unique_ptr<Parser<QueryRequest>> create_parser() {
+    return std::unique_ptr<Parser<QueryRequest>>(new BinaryQueryRequestParser());
+  }
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_DATA_BINARY_PARSER_H_ */
@@ -11,11 +11,29 @@
 #include "data/feature.h"
 #include "data/feature_space.h"
 #include "data/feature_vector.h"
+#include "data/numeric_document_id.h"
 
 namespace redgiant {
 
+/*
+ * A document on the ingest path.
+ * The weighted features are kept in a flat array of (feature id, weight), which is all
+ * the index needs. Feature vectors with the original keys are only kept if they are
+ * explicitly added, e.g. for tracing.
+ */
 class Document {
 public:
+#if defined(REDGIANT_NUMERIC_DOC_IDS)
+  // the 64 bits integer ids, e.g. configure --enable-numeric-doc-ids
+  typedef NumericDocumentId DocId;
+#else
+  typedef DocumentId DocId;
+#endif
+  typedef Feature::FeatureId FeatureId;
+  typedef FeatureVector::FeatureWeight FeatureWeight;
+  typedef std::pair<FeatureId, FeatureWeight> TermPair;
+  typedef std::vector<TermPair> Terms;
+
   Document() = default;
 
   Document(std::string id)
@@ -27,7 +45,7 @@ public:
   Document(Document&&) = default;
   ~Document() = default;
 
-  const DocumentId& get_id() const {
+  const DocId& get_id() const {
     return id_;
   }
 
@@ -36,22 +54,54 @@ public:
   }
 
   void set_doc_id(std::string id) {
-    id_ = DocumentId(id);
+    id_ = DocId(id);
     id_str_ = std::move(id);
   }
 
+  // the id string is left empty, used when the document is not from a string id.
+  void set_doc_id(const DocId& id) {
+    id_ = id;
+    id_str_.clear();
+  }
+
+  // reuse the memory of the id string.
+  void set_doc_id(const char* id, size_t len) {
+    id_str_.assign(id, len);
+    id_ = DocId(id_str_);
+  }
+
   const std::vector<FeatureVector>& get_feature_vectors() const {
     return feature_vectors_;
   }
 
   void add_feature_vector(FeatureVector feature_vector) {
+    for (const auto& feature_pair: feature_vector.get_features()) {
+      terms_.emplace_back(feature_pair.first->get_id(), feature_pair.second);
+    }
     feature_vectors_.push_back(std::move(feature_vector));
   }
 
+  const Terms& get_terms() const {
+    return terms_;
+  }
+
+  void add_term(FeatureId feature_id, FeatureWeight weight) {
+    terms_.emplace_back(feature_id, weight);
+  }
+
+  // reset the document to be reused, the allocated memory is kept.
+  void clear() {
+    id_ = DocId();
+    id_str_.clear();
+    feature_vectors_.clear();
+    terms_.clear();
+  }
+
 private:
-  DocumentId id_;
+  DocId id_;
   std::string id_str_;
   std::vector<FeatureVector> feature_vectors_;
+  Terms terms_;
 };
 
 } /* namespace redgiant */
@@ -1,8 +1,13 @@
 #ifndef SRC_MAIN_DATA_DOCUMENT_ID_H_
 #define SRC_MAIN_DATA_DOCUMENT_ID_H_
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 namespace redgiant {
 class DocumentId {
@@ -19,6 +24,22 @@ public:
 
   ~DocumentId() = default;
 
+  // the 16 bytes binary form of GUID, as laid out in memory on little endian machines.
+  static const size_t kRawSize = 16;
+
+  static DocumentId from_raw(const void* raw) {
+    GuidUnion u;
+    std::memcpy(&u, raw, kRawSize);
+    return DocumentId(u.st.low, u.st.high);
+  }
+
+  void to_raw(void* raw) const {
+    GuidUnion u;
+    u.st.low = low_;
+    u.st.high = high_;
+    std::memcpy(raw, &u, kRawSize);
+  }
+
   bool operator== (const DocumentId& rhs) const {
     return low_ == rhs.low_ && high_ == rhs.high_;
   }
@@ -64,6 +85,14 @@ public:
     return *this;
   }
 
+  uint64_t get_low() const {
+    return low_;
+  }
+
+  uint64_t get_high() const {
+    return high_;
+  }
+
   std::string to_string() const;
 
   struct Hash {
@@ -72,6 +101,35 @@ public:
     }
   };
 
+  /*
+   * The number of ids not greater than current in a block of ids sorted in ascending order, i.e. the offset of the
+   * first id greater than current, used to search the sequential posting lists. It is found by argument dependent
+   * lookup, and compares two ids at a time by AVX2 if enabled.
+   */
+  friend size_t count_not_greater(const DocumentId* ids, size_t n, const DocumentId& current) {
+    size_t count = 0;
+    size_t i = 0;
+#if defined(__AVX2__)
+    // the ids are pairs of (low, high) in memory, compared as unsigned by flipping the sign bits
+    const __m256i sign = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+    const __m256i cur = _mm256_xor_si256(_mm256_set_epi64x((long long)current.high_, (long long)current.low_,
+        (long long)current.high_, (long long)current.low_), sign);
+    for (; i + 2 <= n; i += 2) {
+      __m256i pair = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + i));
+      __m256i biased = _mm256_xor_si256(pair, sign);
+      int gt = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(biased, cur)));
+      int eq = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(pair, _mm256_xor_si256(cur, sign))));
+      // bit 0 and 2: high greater, or high equal and low greater
+      int greater = (gt >> 1) | ((eq >> 1) & gt);
+      count += 2 - (greater & 1) - ((greater >> 2) & 1);
+    }
+#endif
+    for (; i < n; ++i) {
+      count += !(current < ids[i]);
+    }
+    return count;
+  }
+
 private:
   uint64_t low_;
   uint64_t high_;
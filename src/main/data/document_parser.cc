@@ -1,5 +1,6 @@
 #include "data/document_parser.h"
 
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -32,7 +33,7 @@ int DocumentParser::parse_json(const rapidjson::Value& root, Document& output) {
       return -1;
     }
     LOG_TRACE(logger, "document[%s]: read uuid from json.", uuid);
-    output.set_doc_id(uuid);
+    output.set_doc_id(uuid, strlen(uuid));
   }
 
   auto features = json_get_object(root, "features");
@@ -49,8 +50,13 @@ int DocumentParser::parse_json(const rapidjson::Value& root, Document& output) {
 }
 
 int DocumentParser::parse_feature_spaces(const rapidjson::Value& json, Document& doc) {
+  // keep the keys only if asked for, or they will be written to trace logs.
+  bool keep_keys = keep_keys_ || LOG_TRACE_ENABLED(logger);
+  // reused for looking up spaces, does not allocate after the first few documents.
+  static thread_local std::string space_name;
+
   for (auto it = json.MemberBegin(); it != json.MemberEnd(); ++it) {
-    std::string space_name = it->name.GetString();
+    space_name.assign(it->name.GetString(), it->name.GetStringLength());
     std::shared_ptr<FeatureSpace> space = feature_spaces_->get_space(space_name);
     if (!space) {
       // feature space must be pre-defined
@@ -60,20 +66,25 @@ int DocumentParser::parse_feature_spaces(const rapidjson::Value& json, Document&
       LOG_TRACE(logger, "document[%s]: parsing feature space [%s]",
           doc.get_id_str().c_str(), space_name.c_str());
 
-      FeatureVector vec(std::move(space));
+      std::unique_ptr<FeatureVector> vec;
+      if (keep_keys) {
+        vec.reset(new FeatureVector(space));
+      }
       int ret = -1;
       if (it->value.IsNumber()) {
-        ret = parse_feature_vector_single_weighted(it->value, doc, vec);
+        ret = parse_feature_vector_single_weighted(it->value, *space, doc, vec.get());
       } else if (it->value.IsString()){
-        ret = parse_feature_vector_single_unitary(it->value, doc, vec);
+        ret = parse_feature_vector_single_unitary(it->value, *space, doc, vec.get());
       } else if (it->value.IsObject()) {
-        ret = parse_feature_vector_multiple_weighted(it->value, doc, vec);
+        ret = parse_feature_vector_multiple_weighted(it->value, *space, doc, vec.get());
       } else if (it->value.IsArray()) {
-        ret = parse_feature_vector_multiple_unitary(it->value, doc, vec);
+        ret = parse_feature_vector_multiple_unitary(it->value, *space, doc, vec.get());
       }
 
       if (ret == 0) {
-        doc.add_feature_vector(std::move(vec));
+        if (vec) {
+          doc.add_feature_vector(std::move(*vec));
+        }
       } else {
         LOG_WARN(logger, "document[%s]: cannot parse feature space [%s], ignored.",
             doc.get_id_str().c_str(), space_name.c_str());
@@ -85,56 +96,39 @@ int DocumentParser::parse_feature_spaces(const rapidjson::Value& json, Document&
 
 // e.g. { "download_count" : 123456 }, json is 123456
 int DocumentParser::parse_feature_vector_single_weighted(const rapidjson::Value& json,
-    const Document& doc, FeatureVector& vec) {
+    const FeatureSpace& space, Document& doc, FeatureVector* vec) {
   if (!json.IsNumber()) {
     return -1;
   }
 
   // the feature key is empty, we set it to "0" and it is usually configured to integer type.
-  std::shared_ptr<Feature> feature =  vec.get_space().create_feature("0");
-  if (feature) {
-    LOG_TRACE(logger, "document[%s], created feature %016llx (%s) in feature space [%s]",
-        doc.get_id_str().c_str(), (unsigned long long)feature->get_id(),
-        feature->get_key().c_str(), vec.get_space_name().c_str());
-    vec.add_feature(std::move(feature), json.GetDouble());
-  }
+  add_feature("0", 1, json.GetDouble(), space, doc, vec);
   return 0;
 }
 
 // e.g. { "publisher" : "cnn" }, json is "cnn"
 int DocumentParser::parse_feature_vector_single_unitary(const rapidjson::Value& json,
-    const Document& doc, FeatureVector& vec) {
+    const FeatureSpace& space, Document& doc, FeatureVector* vec) {
   if (!json.IsString()) {
     return -1;
   }
 
-  std::shared_ptr<Feature> feature = vec.get_space().create_feature(json.GetString());
-  if (feature) {
-    LOG_TRACE(logger, "document[%s], created feature %016llx (%s) in feature space [%s]",
-        doc.get_id_str().c_str(), (unsigned long long)feature->get_id(),
-        feature->get_key().c_str(), vec.get_space_name().c_str());
-    vec.add_feature(std::move(feature), 1.0);
-  }
+  add_feature(json.GetString(), json.GetStringLength(), 1.0, space, doc, vec);
   return 0;
 }
 
 // e.g. { "favorite_sports" : { "football" : 1.0, "tennis" : 2.0 } }
 // json is { "football" : 1.0, "tennis" : 2.0 }
 int DocumentParser::parse_feature_vector_multiple_weighted(const rapidjson::Value& json,
-    const Document& doc, FeatureVector& vec) {
+    const FeatureSpace& space, Document& doc, FeatureVector* vec) {
   if (!json.IsObject()) {
     return -1;
   }
 
   for (auto it = json.MemberBegin(); it != json.MemberEnd(); ++it) {
     if (it->name.IsString() && it->value.IsNumber()) {
-      std::shared_ptr<Feature> feature = vec.get_space().create_feature(it->name.GetString());
-      if (feature) {
-        LOG_TRACE(logger, "document[%s], created feature %016llx (%s) in feature space [%s]",
-            doc.get_id_str().c_str(), (unsigned long long)feature->get_id(),
-            feature->get_key().c_str(), vec.get_space_name().c_str());
-        vec.add_feature(std::move(feature), it->value.GetDouble());
-      }
+      add_feature(it->name.GetString(), it->name.GetStringLength(), it->value.GetDouble(),
+          space, doc, vec);
     }
   }
   return 0;
@@ -143,24 +137,36 @@ int DocumentParser::parse_feature_vector_multiple_weighted(const rapidjson::Valu
 // e.g. { "favorite_sports" : [ "football", "tennis" ] }
 // json is [ "football", "tennis" ]
 int DocumentParser::parse_feature_vector_multiple_unitary(const rapidjson::Value& json,
-    const Document& doc, FeatureVector& vec) {
+    const FeatureSpace& space, Document& doc, FeatureVector* vec) {
   if (!json.IsArray()) {
     return -1;
   }
 
   for (auto it = json.Begin(); it != json.End(); ++it) {
     if (it->IsString()) {
-      std::shared_ptr<Feature> feature = vec.get_space().create_feature(it->GetString());
-      if (feature) {
-        LOG_TRACE(logger, "document[%s], created feature %016llx (%s) in feature space [%s]",
-            doc.get_id_str().c_str(), (unsigned long long)feature->get_id(),
-            feature->get_key().c_str(), vec.get_space_name().c_str());
-        vec.add_feature(std::move(feature), 1.0);
-      }
+      add_feature(it->GetString(), it->GetStringLength(), 1.0, space, doc, vec);
     }
   }
   return 0;
 }
 
+void DocumentParser::add_feature(const char* key, size_t len, double weight,
+    const FeatureSpace& space, Document& doc, FeatureVector* vec) {
+  Feature::FeatureId id = space.calculate_feature_id(key, len);
+  if (id == FeatureSpace::kInvalidId) {
+    return;
+  }
+
+  if (!vec) {
+    doc.add_term(id, weight);
+    return;
+  }
+
+  std::shared_ptr<Feature> feature = std::make_shared<Feature>(std::string(key, len), id);
+  LOG_TRACE(logger, "document[%s], created feature %016llx (%s) in feature space [%s]",
+      doc.get_id_str().c_str(), (unsigned long long)feature->get_id(),
+      feature->get_key().c_str(), space.get_name().c_str());
+  vec->add_feature(std::move(feature), weight);
+}
 
 } /* namespace redgiant */
@@ -6,13 +6,18 @@
 
 namespace redgiant {
 class Document;
+class FeatureSpace;
 class FeatureSpaceManager;
 class FeatureVector;
 
+/*
+ * Parse the features directly into the flat terms of document, without keeping the keys.
+ * Feature vectors with keys are also built if keep_keys is set or trace logs are enabled.
+ */
 class DocumentParser: public JsonParser<Document> {
 public:
-  DocumentParser(std::shared_ptr<FeatureSpaceManager> feature_spaces)
-  : feature_spaces_(std::move(feature_spaces)) {
+  DocumentParser(std::shared_ptr<FeatureSpaceManager> feature_spaces, bool keep_keys = false)
+  : feature_spaces_(std::move(feature_spaces)), keep_keys_(keep_keys) {
   }
 
   virtual ~DocumentParser() = default;
@@ -25,25 +30,30 @@ private:
   // parse feature vector contains only one single feature that is a weight.
   // e.g. { "download_count" : 123456 }
   int parse_feature_vector_single_weighted(const rapidjson::Value& json,
-      const Document& doc, FeatureVector& vec);
+      const FeatureSpace& space, Document& doc, FeatureVector* vec);
 
   // parse feature vector contains only one single feature with no weight.
   // e.g. { "publisher" : "cnn" }
   int parse_feature_vector_single_unitary(const rapidjson::Value& json,
-      const Document& doc, FeatureVector& vec);
+      const FeatureSpace& space, Document& doc, FeatureVector* vec);
 
   // parse feature vector contains multiple features and their weights.
   // e.g. { "favorite_sports" : { "football" : 1.0, "tennis" : 2.0 } }
   int parse_feature_vector_multiple_weighted(const rapidjson::Value& json,
-      const Document& doc, FeatureVector& vec);
+      const FeatureSpace& space, Document& doc, FeatureVector* vec);
 
   // parse feature vector contains multiple features and their weights.
   // e.g. { "favorite_sports" : [ "football", "tennis" ] }
   int parse_feature_vector_multiple_unitary(const rapidjson::Value& json,
-      const Document& doc, FeatureVector& vec);
+      const FeatureSpace& space, Document& doc, FeatureVector* vec);
+
+  // add the feature to vec if it is given, or add the term to doc directly.
+  void add_feature(const char* key, size_t len, double weight,
+      const FeatureSpace& space, Document& doc, FeatureVector* vec);
 
 private:
   std::shared_ptr<FeatureSpaceManager> feature_spaces_;
+  bool keep_keys_;
 };
 
 class DocumentParserFactory: public ParserFactory<Document> {
@@ -3,6 +3,7 @@
 
 #include <ctime>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "data/document.h"
@@ -11,15 +12,39 @@
 namespace redgiant {
 class DocumentUpdateRequest {
 public:
+  // update with a document already parsed.
   DocumentUpdateRequest(std::shared_ptr<Document> doc, std::time_t expire_time,
       StopWatch watch = StopWatch())
   : doc_(std::move(doc)), expire_time_(expire_time), watch_(watch) {
   }
 
+  // update with the raw request content, which is parsed by the update workers.
+  // binary content may contain multiple documents.
+  DocumentUpdateRequest(std::string uuid, std::string content, std::time_t expire_time,
+      bool binary = false, StopWatch watch = StopWatch())
+  : uuid_(std::move(uuid)), content_(std::move(content)), binary_(binary),
+    expire_time_(expire_time), watch_(watch) {
+  }
+
   const std::shared_ptr<Document>& get_doc() const {
     return doc_;
   }
 
+  // uuid given in the request, may be empty.
+  const std::string& get_uuid() const {
+    return uuid_;
+  }
+
+  // raw content to be parsed, only valid if doc is not set.
+  const std::string& get_content() const {
+    return content_;
+  }
+
+  // whether the content is in binary format, or json
+  bool is_binary() const {
+    return binary_;
+  }
+
   std::time_t get_expire_time() const {
     return expire_time_;
   }
@@ -30,6 +55,9 @@ public:
 
 private:
   std::shared_ptr<Document> doc_;
+  std::string uuid_;
+  std::string content_;
+  bool binary_ = false;
   std::time_t expire_time_;
   // used for measuring feeding latency
   StopWatch watch_;
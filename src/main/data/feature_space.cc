@@ -1,6 +1,7 @@
 #include "data/feature_space.h"
 
-#include <stdexcept>
+#include <cerrno>
+#include <cstdlib>
 #include <string>
 #include "utils/logger.h"
 
@@ -21,19 +22,11 @@ auto FeatureSpace::calculate_feature_id(const std::string& feature_key) const
     // For strings, hash the string and get the lower 56 bits.
     id |= (FeatureId)string_hash(feature_key) & kFeatureMask;
   } else if (type_ == SpaceType::kInteger) {
-    try {
-      // For integers, get the lower 56 bits directly.
-      unsigned long long number = stoull(feature_key);
-      id |= (FeatureId)number & kFeatureMask;
-    } catch (std::invalid_argument& exception) {
-      LOG_DEBUG(logger, "feature key %s is invalid in space %s",
-          feature_key.c_str(), space_name_.c_str());
-      return kInvalidId;
-    } catch (std::out_of_range& exception) {
-      LOG_DEBUG(logger, "feature key %s is out of range in space %s",
-          feature_key.c_str(), space_name_.c_str());
+    FeatureId number = calculate_integer_id(feature_key.c_str());
+    if (number == kInvalidId) {
       return kInvalidId;
     }
+    id |= number;
   }
 
   LOG_TRACE(logger, "Built feature key %s in space %s to id %016llx",
@@ -41,4 +34,42 @@ auto FeatureSpace::calculate_feature_id(const std::string& feature_key) const
   return id;
 }
 
+auto FeatureSpace::calculate_feature_id(const char* feature_key, size_t len) const
+-> FeatureId {
+  if (type_ == SpaceType::kString) {
+    // the string hash must be identical to std::hash<std::string>, reuse a per-thread
+    // string, which does not allocate once it is large enough.
+    static thread_local std::string key_buf;
+    key_buf.assign(feature_key, len);
+    return calculate_feature_id(key_buf);
+  }
+
+  FeatureId id = ((FeatureId)space_id_ << kSpaceOffset) & kSpaceMask;
+  FeatureId number = calculate_integer_id(feature_key);
+  if (number == kInvalidId) {
+    return kInvalidId;
+  }
+  return id | number;
+}
+
+// same as stoull, but do not throw.
+auto FeatureSpace::calculate_integer_id(const char* feature_key) const
+-> FeatureId {
+  char* end = nullptr;
+  errno = 0;
+  unsigned long long number = std::strtoull(feature_key, &end, 10);
+  if (end == feature_key) {
+    LOG_DEBUG(logger, "feature key %s is invalid in space %s",
+        feature_key, space_name_.c_str());
+    return kInvalidId;
+  }
+  if (errno == ERANGE) {
+    LOG_DEBUG(logger, "feature key %s is out of range in space %s",
+        feature_key, space_name_.c_str());
+    return kInvalidId;
+  }
+  // For integers, get the lower 56 bits directly.
+  return (FeatureId)number & kFeatureMask;
+}
+
 } /* namespace redgiant */
@@ -19,8 +19,10 @@ public:
     kInteger
   };
 
-  FeatureSpace(std::string name, SpaceId id, SpaceType type)
-  : space_name_(std::move(name)), space_id_(id), type_(type) {
+  // posting_list is the name of the posting list type of the features in the index, or empty for the
+  // default one of the index.
+  FeatureSpace(std::string name, SpaceId id, SpaceType type, std::string posting_list = std::string())
+  : space_name_(std::move(name)), space_id_(id), type_(type), posting_list_(std::move(posting_list)) {
     // TODO: id should be in range [0,254] (255 is reserved for invalid)
   }
 
@@ -40,6 +42,10 @@ public:
     return type_;
   }
 
+  const std::string& get_posting_list() const {
+    return posting_list_;
+  }
+
   // for tracing
   std::string get_type_name() const {
     if (type_ == SpaceType::kString) {
@@ -59,6 +65,10 @@ public:
 
   FeatureId calculate_feature_id(const std::string& feature_key) const;
 
+  // same as above, without constructing a string for the key.
+  // the key must be null terminated, as rapidjson strings are.
+  FeatureId calculate_feature_id(const char* feature_key, size_t len) const;
+
   FeatureId project_to_space(FeatureId id) const {
     return (id & kFeatureMask) | ((FeatureId)space_id_ << kSpaceOffset);
   }
@@ -75,6 +85,8 @@ public:
   static const FeatureId kInvalidId = (~(FeatureId)0); // -1
 
 private:
+  FeatureId calculate_integer_id(const char* feature_key) const;
+
   static const int kSpaceBits = 8;
   static const int kSpaceOffset = 56;
   static const int kFeatureBits = 56;
@@ -85,6 +97,7 @@ private:
   std::string space_name_;
   SpaceId space_id_;
   SpaceType type_;
+  std::string posting_list_;
 };
 
 } /* namespace redgiant */
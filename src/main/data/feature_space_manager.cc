@@ -1,6 +1,7 @@
 #include "data/feature_space_manager.h"
 
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "data/feature_space.h"
@@ -35,8 +36,11 @@ int FeatureSpaceManager::initialize(const rapidjson::Value& root) {
       LOG_ERROR(logger, "feature spaces does not contain valid id!");
       return -1;
     }
+    // optional, the default posting lists of the index if not given
+    std::string posting_list;
+    json_try_get_value(*it, "posting_list", posting_list);
     set_space_internal(std::make_shared<FeatureSpace>(
-        name, id, type == "string" ? SpaceType::kString : SpaceType::kInteger));
+        name, id, type == "string" ? SpaceType::kString : SpaceType::kInteger, std::move(posting_list)));
   }
   return 0;
 
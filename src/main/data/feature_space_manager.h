@@ -5,6 +5,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "data/feature_space.h"
 #include "third_party/lock/shared_lock.h"
@@ -27,6 +28,17 @@ public:
     return get_space_internal(space_name);
   }
 
+  std::vector<std::shared_ptr<FeatureSpace>> get_spaces() const {
+    // read spaces
+    shared_lock<shared_mutex> lock(mutex_spaces_);
+    std::vector<std::shared_ptr<FeatureSpace>> spaces;
+    spaces.reserve(spaces_.size());
+    for (const auto& pair: spaces_) {
+      spaces.push_back(pair.second);
+    }
+    return spaces;
+  }
+
   void set_space(std::shared_ptr<FeatureSpace> space) {
     if (space) {
       // write spaces
@@ -13,8 +13,13 @@ public:
   JsonParser() = default;
   virtual ~JsonParser() = default;
 
+  // the DOM is allocated from the buffers of the thread, which are reused by every call, so that
+  // the parsers stay small. it falls back to the heap only for very large documents.
   virtual int parse(const char* str, size_t len, Output& output) {
-    rapidjson::Document root;
+    static thread_local Buffers buffers;
+    rapidjson::MemoryPoolAllocator<> value_allocator(buffers.value, sizeof(buffers.value));
+    rapidjson::MemoryPoolAllocator<> stack_allocator(buffers.stack, sizeof(buffers.stack));
+    ArenaDocument root(&value_allocator, sizeof(buffers.stack) / 2, &stack_allocator);
     if (root.Parse(str, len).HasParseError()) {
       return -1;
     }
@@ -39,6 +44,18 @@ public:
   }
 
   virtual int parse_json(const rapidjson::Value &root, Output& output) = 0;
+
+private:
+  typedef rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::MemoryPoolAllocator<>,
+      rapidjson::MemoryPoolAllocator<>> ArenaDocument;
+
+  static const size_t kValueBufferSize = 64 * 1024;
+  static const size_t kStackBufferSize = 16 * 1024;
+
+  struct Buffers {
+    alignas(16) char value[kValueBufferSize];
+    alignas(16) char stack[kStackBufferSize];
+  };
 };
 } /* namespace redgiant */
 
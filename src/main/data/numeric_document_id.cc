@@ -0,0 +1,37 @@
+#include "data/numeric_document_id.h"
+
+namespace redgiant {
+
+NumericDocumentId::NumericDocumentId(const std::string& id)
+: id_(0) {
+  if (id.empty() || id.size() > 20) {
+    // not a 64 bits decimal integer, the GUID form is 36 characters
+    if (id.size() == 36) {
+      id_ = from_guid(DocumentId(id)).id_;
+    }
+    return;
+  }
+  uint64_t value = 0;
+  for (char c: id) {
+    unsigned digit = (unsigned)(c - '0');
+    if (digit > 9 || value > (UINT64_MAX - digit) / 10) {
+      // not a number, or overflows
+      return;
+    }
+    value = value * 10 + digit;
+  }
+  id_ = value;
+}
+
+std::string NumericDocumentId::to_string() const {
+  char buf[20];
+  char* p = buf + sizeof(buf);
+  uint64_t value = id_;
+  do {
+    *--p = (char)('0' + value % 10);
+    value /= 10;
+  } while (value);
+  return std::string(p, buf + sizeof(buf));
+}
+
+} /* namespace redgiant */
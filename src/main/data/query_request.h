@@ -16,10 +16,15 @@ class QueryResult;
 
 class QueryRequest {
 public:
+  typedef Feature::FeatureId FeatureId;
+  typedef FeatureVector::FeatureWeight FeatureWeight;
+  typedef std::pair<FeatureId, FeatureWeight> TermPair;
+  typedef std::vector<TermPair> Terms;
+
   QueryRequest(const std::string& request_id, size_t query_count,
       std::string model_name, StopWatch watch = StopWatch(), bool debug = false)
   : request_id_(request_id), query_count_(query_count),
-    model_name_(std::move(model_name)), watch_(watch), debug_(debug) {
+    model_name_(std::move(model_name)), watch_(watch), timeout_us_(0), min_score_(0), debug_(debug) {
   }
 
   // no copy
@@ -60,18 +65,55 @@ public:
     model_name_ = std::move(model_name);
   }
 
-  const std::vector<FeatureVector> get_feature_vectors() const {
+  const std::vector<FeatureVector>& get_feature_vectors() const {
     return feature_vectors_;
   }
 
   void add_feature_vector(FeatureVector feature_vector) {
+    for (const auto& feature_pair: feature_vector.get_features()) {
+      terms_.emplace_back(feature_pair.first->get_id(), feature_pair.second);
+    }
     feature_vectors_.push_back(std::move(feature_vector));
   }
 
+  // all weighted features of the request, including those from feature vectors.
+  // the space of a feature is encoded in the high bits of its id.
+  const Terms& get_terms() const {
+    return terms_;
+  }
+
+  void add_term(FeatureId feature_id, FeatureWeight weight) {
+    terms_.emplace_back(feature_id, weight);
+  }
+
+  // use the features already parsed in another request, e.g. shared by a batch.
+  void copy_features(const QueryRequest& other) {
+    feature_vectors_ = std::vector<FeatureVector>(other.feature_vectors_);
+    terms_ = other.terms_;
+  }
+
   const StopWatch& get_watch() const {
     return watch_;
   }
 
+  // latency budget counted from the start of the watch, 0 for unlimited.
+  long get_timeout_us() const {
+    return timeout_us_;
+  }
+
+  void set_timeout_us(long timeout_us) {
+    timeout_us_ = timeout_us;
+  }
+
+  // documents with a score not greater than min_score may be omitted from the results.
+  double get_min_score() const {
+    return min_score_;
+  }
+
+  void set_min_score(double min_score) {
+    min_score_ = min_score;
+  }
+
   bool is_debug() const {
     return debug_;
   }
@@ -81,7 +123,10 @@ private:
   size_t query_count_;
   std::string model_name_;
   std::vector<FeatureVector> feature_vectors_;
+  Terms terms_;
   StopWatch watch_;
+  long timeout_us_;
+  double min_score_;
   bool debug_;
 };
 } /* namespace redgiant */
@@ -19,9 +19,10 @@ public:
 
   virtual int parse_json(const rapidjson::Value &root, QueryRequest& output);
 
-private:
+  // parse the "features" object of a request.
   int parse_feature_spaces(const rapidjson::Value& json, QueryRequest& request);
 
+private:
   // parse feature vector contains only one single feature that is a weight.
   // e.g. { "download_count" : 3.0 }
   int parse_feature_vector_single_weighted(const rapidjson::Value& json,
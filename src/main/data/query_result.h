@@ -27,7 +27,7 @@ public:
   };
 
   QueryResult(const std::string& request_id, const StopWatch& watch)
-  : request_id_(request_id), watch_(watch), error_status_(false) {
+  : request_id_(request_id), watch_(watch), error_status_(false), partial_(false) {
   }
 
   // no copy
@@ -69,12 +69,22 @@ public:
     return error_status_;
   }
 
+  // the query is stopped by its latency budget, and the results are the best found so far.
+  void set_partial(bool partial) {
+    partial_ = partial;
+  }
+
+  bool is_partial() const {
+    return partial_;
+  }
+
 private:
   std::string request_id_;
   KeyScores results_;
   StopWatch watch_;
   LatencyTracker<kTimePhaseCount> latency_tracker_;
   bool error_status_;
+  bool partial_;
 };
 } /* namespace redgiant */
 
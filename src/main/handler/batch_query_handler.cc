@@ -0,0 +1,215 @@
+#include "handler/batch_query_handler.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <utility>
+
+#include "data/batch_query_request.h"
+#include "data/query_request.h"
+#include "data/query_result.h"
+#include "handler/query_handler.h"
+#include "query/query_executor.h"
+#include "query/query_job.h"
+#include "service/request_context.h"
+#include "service/response_writer.h"
+#include "utils/logger.h"
+
+namespace redgiant {
+
+DECLARE_LOGGER(logger, __FILE__);
+
+// write the string given by users as a JSON string, escaping quotes, backslashes and control characters.
+static void write_json_string(std::ostream& os, const std::string& str) {
+  os << '"';
+  for (char c: str) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    } else if ((unsigned char)c < 0x20) {
+      char buf[8];
+      std::snprintf(buf, sizeof(buf), "\\u%04x", (unsigned)c);
+      os << buf;
+    } else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
+BatchQueryHandler::BatchResult::BatchResult(const BatchQueryRequest& request)
+: batch_id(request.get_request_id()), watch(request.get_watch()),
+  results(request.get_queries().size()), remaining(request.get_queries().size()) {
+  ids.reserve(request.get_queries().size());
+  for (auto& query: request.get_queries()) {
+    ids.push_back(query.get_request_id());
+  }
+}
+
+void BatchQueryHandler::handle_request(const RequestContext* request, ResponseWriter* response) {
+  StopWatch watch;
+
+  int method = request->get_method();
+  if (method != RequestContext::METHOD_POST) {
+    response->add_body("method should be POST\n");
+    response->send(400, NULL);
+    LOG_ERROR(logger, "method is not POST");
+    return;
+  }
+
+  int post_len = request->get_content_length();
+  if (post_len <= 0) {
+    response->add_body("content is missing\n");
+    response->send(400, NULL);
+    LOG_ERROR(logger, "content is missing");
+    return;
+  }
+
+  std::string request_id = request->get_query_param("id");
+  std::string debug = request->get_query_param("debug");
+  std::string timeout_str = request->get_query_param("timeout_us");
+  std::string min_score_str = request->get_query_param("min_score");
+
+  BatchQueryRequest batch_request(request_id, watch, debug == "true");
+
+  buf_.alloc(post_len + 1);
+  char* body = buf_.data();
+  int ret_len = request->get_content(body, post_len);
+  body[ret_len] = 0;
+
+  if (batch_request.is_debug()) {
+    LOG_TRACE(logger, "[batch:%s] batch query request: uri=%s, post=%s", request_id.c_str(),
+        request->get_uri().c_str(), body);
+  }
+
+  int parse_ret = parser_->parse(body, ret_len, batch_request);
+  buf_.clear();
+
+  if (parse_ret < 0) {
+    response->add_body(R"({"ret":"parse_error", "queries":[]})""\n");
+    response->send(400, NULL);
+    LOG_INFO(logger, "[batch:%s] error=parse_error, latency=%ldus", request_id.c_str(), watch.get_ticks_us());
+    return;
+  }
+
+  std::shared_ptr<BatchResult> result = std::make_shared<BatchResult>(batch_request);
+  auto& queries = batch_request.get_queries();
+  if (!timeout_str.empty()) {
+    // the queries share the watch of the batch, so the budget is for the whole batch
+    long timeout_us = atol(timeout_str.c_str());
+    for (auto& query: queries) {
+      query.set_timeout_us(timeout_us);
+    }
+  }
+  if (!min_score_str.empty()) {
+    double min_score = atof(min_score_str.c_str());
+    for (auto& query: queries) {
+      query.set_min_score(min_score);
+    }
+  }
+
+  if (shared_) {
+    if (pipeline_) {
+      // one job for the whole batch, so the shared terms are still read only once
+      result->writer = response->defer();
+      if (result->writer) {
+        if (!pipeline_->try_schedule(std::make_shared<QueryJob>(std::move(queries),
+            [result] (std::vector<std::unique_ptr<QueryResult>> results) {
+              for (size_t i = 0; i < results.size(); ++i) {
+                result->results[i] = std::move(results[i]);
+              }
+              send_result(*result, result->writer.get());
+            }))) {
+          send_busy(*result, result->writer.get());
+        }
+        return;
+      }
+    }
+    std::vector<std::unique_ptr<QueryResult>> results = executor_->execute_batch(queries);
+    for (size_t i = 0; i < results.size(); ++i) {
+      result->results[i] = std::move(results[i]);
+    }
+    send_result(*result, response);
+    return;
+  }
+
+  if (pipeline_) {
+    // fan out to the query workers, the last one finished sends the response. the server thread never
+    // waits for the queue, so the queries not taken by the busy workers fail.
+    result->writer = response->defer();
+    if (result->writer) {
+      size_t scheduled = 0;
+      for (; scheduled < queries.size(); ++scheduled) {
+        size_t i = scheduled;
+        if (!pipeline_->try_schedule(std::make_shared<QueryJob>(std::move(queries[i]),
+            [result, i] (const QueryRequest& request, std::unique_ptr<QueryResult> query_result) {
+              (void) request;
+              result->results[i] = std::move(query_result);
+              if (result->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                send_result(*result, result->writer.get());
+              }
+            }))) {
+          break;
+        }
+      }
+      if (scheduled == 0) {
+        send_busy(*result, result->writer.get());
+      } else if (scheduled < queries.size()) {
+        size_t rejected = queries.size() - scheduled;
+        LOG_WARN(logger, "[batch:%s] %zu queries rejected by the busy workers", request_id.c_str(), rejected);
+        if (result->remaining.fetch_sub(rejected, std::memory_order_acq_rel) == rejected) {
+          send_result(*result, result->writer.get());
+        }
+      }
+      return;
+    }
+  }
+
+  for (size_t i = 0; i < queries.size(); ++i) {
+    result->results[i] = executor_->execute(queries[i]);
+  }
+  send_result(*result, response);
+}
+
+void BatchQueryHandler::send_result(const BatchResult& result, ResponseWriter* response) {
+  size_t error_count = 0;
+  std::ostringstream os; // output
+  os  << R"({"ret":"success")"
+      << R"(,"queries":[)";
+  for (size_t i = 0; i < result.results.size(); ++i) {
+    if (i > 0) {
+      os  << ',';
+    }
+    // the ids are given by users, so they are escaped.
+    os  << R"({"id":)";
+    write_json_string(os, result.ids[i]);
+    const QueryResult* query_result = result.results[i].get();
+    if (!query_result || query_result->is_error_status()) {
+      error_count++;
+      os  << R"(,"ret":"query_error","results":[]})";
+    } else {
+      os  << R"(,"ret":"success")";
+      if (query_result->is_partial()) {
+        os  << R"(,"partial":true)";
+      }
+      os  << R"(,"results":)";
+      QueryHandler::write_results(os, *query_result);
+      os  << '}';
+    }
+  }
+  os << "]}\n";
+
+  response->add_body(os.str());
+  response->send(200, NULL);
+
+  LOG_INFO(logger, "[batch:%s] REQ_STAT ret=success, queries=%zu, errors=%zu, latency=%ldus",
+      result.batch_id.c_str(), result.results.size(), error_count, result.watch.get_ticks_us());
+}
+
+void BatchQueryHandler::send_busy(const BatchResult& result, ResponseWriter* response) {
+  response->add_body(R"({"ret":"busy", "queries":[]})""\n");
+  response->send(503, NULL);
+  LOG_INFO(logger, "[batch:%s] REQ_STAT error=busy, latency=%ldus", result.batch_id.c_str(),
+      result.watch.get_ticks_us());
+}
+
+} /* namespace redgiant */
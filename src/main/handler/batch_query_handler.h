@@ -0,0 +1,93 @@
+#ifndef SRC_MAIN_HANDLER_BATCH_QUERY_HANDLER_H_
+#define SRC_MAIN_HANDLER_BATCH_QUERY_HANDLER_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "data/parser.h"
+#include "query/query_executor.h"
+#include "service/request_handler.h"
+#include "utils/cached_buffer.h"
+#include "utils/concurrency/job_executor.h"
+#include "utils/stop_watch.h"
+
+namespace redgiant {
+class BatchQueryRequest;
+class QueryJob;
+class QueryResult;
+
+/*
+ * Executes a batch of queries in one request, and responds with all of the results.
+ * The queries are executed concurrently by the pipeline if given and the response could be
+ * deferred, otherwise executed one by one in place by the executor. The queries not taken by
+ * the pipeline when its queue is full fail, and the batch is rejected with 503 if none is taken.
+ * If shared, the queries are executed together instead, which reads the terms shared by the queries
+ * only once, as one job of the pipeline if given and the response could be deferred, otherwise in place.
+ */
+class BatchQueryHandler: public RequestHandler {
+public:
+  BatchQueryHandler(std::unique_ptr<Parser<BatchQueryRequest>> parser, std::unique_ptr<QueryExecutor> executor,
+      JobExecutor<QueryJob>* pipeline = nullptr, bool shared = false)
+  : parser_(std::move(parser)), executor_(std::move(executor)), pipeline_(pipeline), shared_(shared),
+    buf_(2 * 1024 * 1024) {
+  }
+
+  virtual ~BatchQueryHandler() = default;
+
+  virtual void handle_request(const RequestContext* request, ResponseWriter* response);
+
+private:
+  // results collected from the queries of a batch
+  struct BatchResult {
+    std::string batch_id;
+    StopWatch watch;
+    std::vector<std::string> ids;
+    std::vector<std::unique_ptr<QueryResult>> results;
+    // number of queries not finished yet
+    std::atomic<size_t> remaining;
+    std::shared_ptr<ResponseWriter> writer;
+
+    BatchResult(const BatchQueryRequest& request);
+  };
+
+  static void send_result(const BatchResult& result, ResponseWriter* response);
+
+  // none of the queries is taken by the pipeline.
+  static void send_busy(const BatchResult& result, ResponseWriter* response);
+
+  std::unique_ptr<Parser<BatchQueryRequest>> parser_;
+  std::unique_ptr<QueryExecutor> executor_;
+  JobExecutor<QueryJob>* pipeline_;
+  bool shared_;
+  CachedBuffer<char> buf_;
+};
+
+class BatchQueryHandlerFactory: public RequestHandlerFactory {
+public:
+  BatchQueryHandlerFactory(std::shared_ptr<ParserFactory<BatchQueryRequest>> parser_factory,
+      std::shared_ptr<QueryExecutorFactory> executor_factory, JobExecutor<QueryJob>* pipeline = nullptr,
+      bool shared = false)
+  : parser_factory_(std::move(parser_factory)), executor_factory_(std::move(executor_factory)),
+    pipeline_(pipeline), shared_(shared) {
+  }
+
+  virtual ~BatchQueryHandlerFactory() = default;
+
+  virtual std::unique_ptr<RequestHandler> create_handler() {
+    return std::unique_ptr<RequestHandler>(
+        new BatchQueryHandler(parser_factory_->create_parser(),
+            executor_factory_->create_executor(), pipeline_, shared_));
+  }
+
+private:
+  std::shared_ptr<ParserFactory<BatchQueryRequest>> parser_factory_;
+  std::shared_ptr<QueryExecutorFactory> executor_factory_;
+  JobExecutor<QueryJob>* pipeline_;
+  bool shared_;
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_HANDLER_BATCH_QUERY_HANDLER_H_ */
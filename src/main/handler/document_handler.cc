@@ -1,10 +1,14 @@
 #include "handler/document_handler.h"
 
 #include <time.h>
-#include <string>
+#include <climits>
 #include <memory>
+#include <sstream>
+#include <string>
 #include <utility>
+#include <vector>
 
+#include "data/binary_format.h"
 #include "data/document.h"
 #include "data/document_parser.h"
 #include "index/document_index_view.h"
@@ -38,8 +42,40 @@ void DocumentHandler::handle_request(const RequestContext* request, ResponseWrit
     return;
   }
 
-  std::shared_ptr<Document> doc = std::make_shared<Document>();
+  std::string ttl_str = request->get_query_param("ttl");
+  unsigned long ttl = default_ttl_;
+  if (!ttl_str.empty()) {
+    ttl = std::stoul(ttl_str);
+    if (ttl > 0 && ttl != ULONG_MAX) {
+      LOG_DEBUG(logger, "set document ttl from request: %lu", (unsigned long)ttl);
+    } else {
+      ttl = default_ttl_;
+    }
+  }
+  // expire time is current time plus ttl
+  time_t expire_time = time(NULL) + ttl;
+
   std::string uuid = request->get_query_param("uuid");
+  bool binary = BinaryFormat::is_binary_content(request->get_header("Content-Type"));
+  // parse in this thread only if the client wants parse errors to be reported.
+  bool validate = request->get_query_param("validate") == "true";
+  if (async_parse_ && !validate) {
+    std::string content;
+    request->get_content(content);
+    // async parse and update, parse errors are counted by the update pipeline
+    index_view_->update_document_async(uuid, expire_time, std::move(content), binary);
+
+    response->add_body(R"({"ret":"0", "message":"accepted"})""\n");
+    response->send(200, NULL);
+    return;
+  }
+
+  if (binary) {
+    handle_binary(request, response, expire_time);
+    return;
+  }
+
+  std::shared_ptr<Document> doc = std::make_shared<Document>();
   // if there is no uuid in post content, try to get it from the query param.
   if (!uuid.empty()) {
     LOG_DEBUG(logger, "set document uuid from request: %s", uuid.c_str());
@@ -61,19 +97,6 @@ void DocumentHandler::handle_request(const RequestContext* request, ResponseWrit
     return;
   }
 
-  std::string ttl_str = request->get_query_param("ttl");
-  unsigned long ttl = default_ttl_;
-  if (!ttl_str.empty()) {
-    ttl = std::stoul(ttl_str);
-    if (ttl > 0 && ttl != ULONG_MAX) {
-      LOG_DEBUG(logger, "set document ttl from request: %lu", (unsigned long)ttl);
-    } else {
-      ttl = default_ttl_;
-    }
-  }
-  // expire time is current time plus ttl
-  time_t expire_time = time(NULL) + ttl;
-
   // async update
   index_view_->update_document_async(uuid, expire_time, std::move(doc));
 
@@ -83,4 +106,35 @@ void DocumentHandler::handle_request(const RequestContext* request, ResponseWrit
   response->send(200, NULL);
 }
 
+// binary content may contain multiple documents, update them only if all are valid.
+void DocumentHandler::handle_binary(const RequestContext* request, ResponseWriter* response,
+    time_t expire_time) {
+  std::string content;
+  request->get_content(content);
+
+  std::vector<std::shared_ptr<Document>> docs;
+  const char* data = content.data();
+  size_t len = content.size();
+  while (len > 0) {
+    size_t record_size = BinaryFormat::get_record_size(data, len);
+    std::shared_ptr<Document> doc = std::make_shared<Document>();
+    if (record_size == 0 || binary_parser_.parse(data, record_size, *doc) < 0) {
+      LOG_ERROR(logger, "parse error in binary document %zu", docs.size());
+      response->add_body("parse error\n");
+      response->send(400, NULL);
+      return;
+    }
+    docs.push_back(std::move(doc));
+    data += record_size;
+    len -= record_size;
+  }
+
+  for (auto& doc: docs) {
+    index_view_->update_document_async("", expire_time, std::move(doc));
+  }
+
+  response->add_body(R"({"ret":"0", "message":"success"})""\n");
+  response->send(200, NULL);
+}
+
 } /* namespace redgiant */
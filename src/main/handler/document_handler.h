@@ -1,9 +1,11 @@
 #ifndef SRC_MAIN_HANDLER_DOCUMENT_HANDLER_H_
 #define SRC_MAIN_HANDLER_DOCUMENT_HANDLER_H_
 
+#include <ctime>
 #include <memory>
 #include <utility>
 
+#include "data/binary_parser.h"
 #include "data/parser.h"
 #include "service/request_handler.h"
 #include "utils/cached_buffer.h"
@@ -15,10 +17,12 @@ class DocumentIndexView;
 
 class DocumentHandler: public RequestHandler {
 public:
+  // if async_parse is set, the content is parsed by the update pipeline instead of
+  // the server thread, unless the request asks for validation.
   DocumentHandler(std::unique_ptr<Parser<Document>> parser,
-      DocumentIndexView* index_view, unsigned long default_ttl)
+      DocumentIndexView* index_view, unsigned long default_ttl, bool async_parse = false)
   : parser_(std::move(parser)), index_view_(index_view),
-    default_ttl_(default_ttl), buf_(2 * 1024 * 1024) {
+    default_ttl_(default_ttl), async_parse_(async_parse), buf_(2 * 1024 * 1024) {
   }
 
   virtual ~DocumentHandler() = default;
@@ -26,31 +30,36 @@ public:
   virtual void handle_request(const RequestContext* request, ResponseWriter* response);
 
 private:
+  void handle_binary(const RequestContext* request, ResponseWriter* response, time_t expire_time);
+
   std::shared_ptr<Parser<Document>> parser_;
+  BinaryDocumentParser binary_parser_;
   DocumentIndexView* index_view_;
   unsigned long default_ttl_;
+  bool async_parse_;
   CachedBuffer<char> buf_;
 };
 
 class FeedDocumentHandlerFactory: public RequestHandlerFactory {
 public:
   FeedDocumentHandlerFactory(std::shared_ptr<ParserFactory<Document>> parser_factory,
-      DocumentIndexView* index_view, unsigned long default_ttl = 86400)
+      DocumentIndexView* index_view, unsigned long default_ttl = 86400, bool async_parse = false)
   : parser_factory_(std::move(parser_factory)), index_view_(index_view),
-    default_ttl_(default_ttl) {
+    default_ttl_(default_ttl), async_parse_(async_parse) {
   }
 
   virtual ~FeedDocumentHandlerFactory() = default;
 
   virtual std::unique_ptr<RequestHandler> create_handler() {
     return std::unique_ptr<RequestHandler>(
-        new DocumentHandler(parser_factory_->create_parser(), index_view_, default_ttl_));
+        new DocumentHandler(parser_factory_->create_parser(), index_view_, default_ttl_, async_parse_));
   }
 
 private:
   std::shared_ptr<ParserFactory<Document>> parser_factory_;
   DocumentIndexView* index_view_;
   unsigned long default_ttl_;
+  bool async_parse_;
 };
 } /* namespace redgiant */
 
@@ -4,11 +4,14 @@
 #include <cstdlib>
 #include <iostream>
 #include <sstream>
+#include <utility>
 
+#include "data/binary_format.h"
 #include "data/query_request.h"
 #include "data/query_request_parser.h"
 #include "data/query_result.h"
 #include "query/query_executor.h"
+#include "query/query_job.h"
 #include "service/request_context.h"
 #include "service/response_writer.h"
 #include "utils/logger.h"
@@ -41,6 +44,8 @@ void QueryHandler::handle_request(const RequestContext* request, ResponseWriter*
   std::string ranking_model = request->get_query_param("model");
   std::string query_count_str = request->get_query_param("count");
   std::string debug = request->get_query_param("debug");
+  std::string timeout_str = request->get_query_param("timeout_us");
+  std::string min_score_str = request->get_query_param("min_score");
 
   int query_count = 10;
   if (!query_count_str.empty()) {
@@ -54,6 +59,12 @@ void QueryHandler::handle_request(const RequestContext* request, ResponseWriter*
   }
 
   QueryRequest query_request(request_id, query_count, ranking_model, watch, debug == "true");
+  if (!timeout_str.empty()) {
+    query_request.set_timeout_us(atol(timeout_str.c_str()));
+  }
+  if (!min_score_str.empty()) {
+    query_request.set_min_score(atof(min_score_str.c_str()));
+  }
   if (query_request.is_debug()) {
     LOG_INFO(logger, "[query:%s] model:%s, query_count:%d", request_id.c_str(), ranking_model.c_str(), query_count);
   }
@@ -63,11 +74,18 @@ void QueryHandler::handle_request(const RequestContext* request, ResponseWriter*
   int ret_len = request->get_content(body, post_len);
   body[ret_len] = 0;
 
+  bool binary = BinaryFormat::is_binary_content(request->get_header("Content-Type"));
   if (query_request.is_debug()) {
-    LOG_TRACE(logger, "[query:%s] query request: uri=%s, post=%s", request_id.c_str(), request->get_uri().c_str(), body);
+    LOG_TRACE(logger, "[query:%s] query request: uri=%s, post=%s", request_id.c_str(), request->get_uri().c_str(),
+        binary ? "(binary)" : body);
   }
 
-  int parse_ret = parser_->parse(body, ret_len, query_request);
+  int parse_ret = -1;
+  if (binary) {
+    parse_ret = binary_parser_.parse(body, ret_len, query_request);
+  } else {
+    parse_ret = parser_->parse(body, ret_len, query_request);
+  }
   buf_.clear();
 
   if (parse_ret < 0) {
@@ -77,20 +95,60 @@ void QueryHandler::handle_request(const RequestContext* request, ResponseWriter*
     return;
   }
 
+  if (pipeline_) {
+    // hand over to the query workers, and reply from the worker thread. the server thread never waits
+    // for the queue, so the query is rejected if the workers are too busy to take it.
+    std::shared_ptr<ResponseWriter> deferred = response->defer();
+    if (deferred) {
+      if (!pipeline_->try_schedule(std::make_shared<QueryJob>(std::move(query_request),
+          [deferred] (const QueryRequest& request, std::unique_ptr<QueryResult> result) {
+            send_result(request, result.get(), deferred.get());
+          }))) {
+        deferred->add_body(R"({"ret":"busy", "results":[]})""\n");
+        deferred->send(503, NULL);
+        LOG_INFO(logger, "[query:%s] REQ_STAT error=busy, latency=%ldus", request_id.c_str(), watch.get_ticks_us());
+      }
+      return;
+    }
+  }
+
   // run query
   std::unique_ptr<QueryResult> result = executor_->execute(query_request);
+  send_result(query_request, result.get(), response);
+}
+
+void QueryHandler::send_result(const QueryRequest& request, const QueryResult* result,
+    ResponseWriter* response) {
+  const std::string& request_id = request.get_request_id();
   if (!result || result->is_error_status()) {
     response->add_body(R"({"ret":"query_error", "results":[]})""\n");
     response->send(500, NULL);
-    LOG_INFO(logger, "[query:%s] REQ_STAT error=query_error, latency=%ldus", request_id.c_str(), watch.get_ticks_us());
+    LOG_INFO(logger, "[query:%s] REQ_STAT error=query_error, latency=%ldus", request_id.c_str(),
+        request.get_watch().get_ticks_us());
     return;
   }
 
   std::ostringstream os; // output
-  os  << R"({"ret":"success")"
-      << R"(,"results":[)";
+  os  << R"({"ret":"success")";
+  if (result->is_partial()) {
+    os  << R"(,"partial":true)";
+  }
+  os  << R"(,"results":)";
+  write_results(os, *result);
+  os << "}\n";
+
+  response->add_body(os.str());
+  response->send(200, NULL);
+
+  LOG_INFO(logger, "[query:%s] REQ_STAT ret=success, count=%zu, partial=%d, latency=%ldus",
+      request_id.c_str(), result->get_results().size(), (int)result->is_partial(),
+      request.get_watch().get_ticks_us());
+}
+
+void QueryHandler::write_results(std::ostream& os, const QueryResult& result) {
+  os << '[';
   bool first = true; // avoid trailing comma
-  for (auto& r: result->get_results()) {
+  for (auto& r: result.get_results()) {
     if (first) {
       first = false;
     } else {
@@ -99,13 +157,7 @@ void QueryHandler::handle_request(const RequestContext* request, ResponseWriter*
     os  << R"({"uuid":")" << r.first << '"'
         << R"(,"score":)" << r.second << "}";
   }
-  os << "]}\n";
-
-  response->add_body(os.str());
-  response->send(200, NULL);
-
-  LOG_INFO(logger, "[query:%s] REQ_STAT ret=success, count=%zu, latency=%ldus",
-      request_id.c_str(), result->get_results().size(), watch.get_ticks_us());
+  os << ']';
 }
 
 } /* namespace redgiant */
@@ -2,37 +2,54 @@
 #define SRC_MAIN_HANDLER_QUERY_HANDLER_H_
 
 #include <memory>
+#include <ostream>
 #include <utility>
 
+#include "data/binary_parser.h"
 #include "data/parser.h"
 #include "query/query_executor.h"
 #include "service/request_handler.h"
 #include "utils/cached_buffer.h"
+#include "utils/concurrency/job_executor.h"
 
 namespace redgiant {
+class QueryJob;
 class QueryRequest;
+class QueryResult;
 
 class QueryHandler: public RequestHandler {
 public:
-  QueryHandler(std::unique_ptr<Parser<QueryRequest>> parser, std::unique_ptr<QueryExecutor> executor)
-  : parser_(std::move(parser)), executor_(std::move(executor)), buf_(2 * 1024 * 1024) {
+  // queries are executed by the pipeline if given and the response could be deferred, or rejected with 503
+  // if its queue is full, otherwise executed in place by the executor.
+  QueryHandler(std::unique_ptr<Parser<QueryRequest>> parser, std::unique_ptr<QueryExecutor> executor,
+      JobExecutor<QueryJob>* pipeline = nullptr)
+  : parser_(std::move(parser)), executor_(std::move(executor)), pipeline_(pipeline),
+    buf_(2 * 1024 * 1024) {
   }
 
   virtual ~QueryHandler() = default;
 
   virtual void handle_request(const RequestContext* request, ResponseWriter* response);
 
+  // write the results as a json array.
+  static void write_results(std::ostream& os, const QueryResult& result);
+
 private:
+  static void send_result(const QueryRequest& request, const QueryResult* result, ResponseWriter* response);
+
   std::unique_ptr<Parser<QueryRequest>> parser_;
+  BinaryQueryRequestParser binary_parser_;
   std::unique_ptr<QueryExecutor> executor_;
+  JobExecutor<QueryJob>* pipeline_;
   CachedBuffer<char> buf_;
 };
 
 class QueryHandlerFactory: public RequestHandlerFactory {
 public:
   QueryHandlerFactory(std::shared_ptr<ParserFactory<QueryRequest>> parser_factory,
-      std::shared_ptr<QueryExecutorFactory> executor_factory)
-  : parser_factory_(std::move(parser_factory)), executor_factory_(std::move(executor_factory)) {
+      std::shared_ptr<QueryExecutorFactory> executor_factory, JobExecutor<QueryJob>* pipeline = nullptr)
+  : parser_factory_(std::move(parser_factory)), executor_factory_(std::move(executor_factory)),
+    pipeline_(pipeline) {
   }
 
   virtual ~QueryHandlerFactory() = default;
@@ -40,12 +57,13 @@ public:
   virtual std::unique_ptr<RequestHandler> create_handler() {
     return std::unique_ptr<RequestHandler>(
         new QueryHandler(parser_factory_->create_parser(),
-            executor_factory_->create_executor()));
+            executor_factory_->create_executor(), pipeline_));
   }
 
 private:
   std::shared_ptr<ParserFactory<QueryRequest>> parser_factory_;
   std::shared_ptr<QueryExecutorFactory> executor_factory_;
+  JobExecutor<QueryJob>* pipeline_;
 };
 } /* namespace redgiant */
 
@@ -0,0 +1,31 @@
+#include "handler/stats_handler.h"
+
+#include <sstream>
+#include <string>
+#include "service/request_context.h"
+#include "service/response_writer.h"
+#include "utils/stats.h"
+
+namespace redgiant {
+
+void StatsHandler::handle_request(const RequestContext* request, ResponseWriter* response) {
+  (void) request;
+
+  std::ostringstream os;
+  os << R"({"ret":"success","stats":{)";
+  bool first = true; // avoid trailing comma
+  for (auto& value: stats_->get_values()) {
+    if (first) {
+      first = false;
+    } else {
+      os << ',';
+    }
+    os << '"' << value.first << R"(":)" << value.second;
+  }
+  os << "}}\n";
+
+  response->add_body(os.str());
+  response->send(200, NULL);
+}
+
+} /* namespace redgiant */
@@ -0,0 +1,42 @@
+#ifndef SRC_MAIN_HANDLER_STATS_HANDLER_H_
+#define SRC_MAIN_HANDLER_STATS_HANDLER_H_
+
+#include <memory>
+#include "service/request_handler.h"
+
+namespace redgiant {
+class Stats;
+
+// responds with the values of all the counters.
+class StatsHandler: public RequestHandler {
+public:
+  StatsHandler(const Stats* stats)
+  : stats_(stats) {
+  }
+
+  virtual ~StatsHandler() = default;
+
+  virtual void handle_request(const RequestContext* request, ResponseWriter* response);
+
+private:
+  const Stats* stats_;
+};
+
+class StatsHandlerFactory: public RequestHandlerFactory {
+public:
+  StatsHandlerFactory(const Stats* stats)
+  : stats_(stats) {
+  }
+
+  virtual ~StatsHandlerFactory() = default;
+
+  virtual std::unique_ptr<RequestHandler> create_handler() {
+    return std::unique_ptr<RequestHandler>(new StatsHandler(stats_));
+  }
+
+private:
+  const Stats* stats_;
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_HANDLER_STATS_HANDLER_H_ */
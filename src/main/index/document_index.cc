@@ -8,8 +8,9 @@ namespace redgiant {
 template class BaseIndexImpl<DocumentTraits>;
 template class RowIndexImpl<DocumentTraits>;
 
-DocumentIndex::DocumentIndex(size_t initial_buckets, size_t max_size, const std::string& file_name)
-: Base(initial_buckets, max_size, SnapshotLoader(file_name)) {
+DocumentIndex::DocumentIndex(size_t initial_buckets, size_t max_size, const std::string& file_name,
+    FactorySelector factory_selector)
+: Base(initial_buckets, max_size, SnapshotLoader(file_name), std::move(factory_selector)) {
 }
 
 size_t DocumentIndex::dump(const std::string& file_name) {
@@ -13,13 +13,14 @@ class DocumentIndex: public RowIndexImpl<DocumentTraits> {
 public:
   typedef RowIndexImpl<DocumentTraits> Base;
 
-  DocumentIndex(size_t initial_buckets, size_t max_size)
-  : Base(initial_buckets, max_size) {
+  DocumentIndex(size_t initial_buckets, size_t max_size, FactorySelector factory_selector = FactorySelector())
+  : Base(initial_buckets, max_size, std::move(factory_selector)) {
   }
 
   // restore from file
   // note: this may throws exception
-  DocumentIndex(size_t initial_buckets, size_t max_size, const std::string& file_name);
+  DocumentIndex(size_t initial_buckets, size_t max_size, const std::string& file_name,
+      FactorySelector factory_selector = FactorySelector());
 
   // have to leave an empty function here to workaround gcc bugs
   ~DocumentIndex() {
@@ -2,14 +2,27 @@
 
 #include <algorithm>
 #include <iomanip>
+#include <map>
 #include <sstream>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "core/index/tiered_posting_list.h"
+#include "core/reader/batch_reader.h"
+#include "core/reader/max_score_reader.h"
+#include "core/reader/max_score_reader-inl.h"
+#include "core/reader/parallel_reader.h"
+#include "core/reader/range_reader.h"
+#include "core/reader/reader_utils.h"
+#include "core/reader/taat_reader.h"
 #include "core/reader/wand_reader.h"
 #include "core/reader/wand_reader-inl.h"
 #include "data/document.h"
 #include "data/document_id.h"
+#include "data/numeric_document_id.h"
+#include "data/interm_query.h"
 #include "data/query_request.h"
 #include "index/document_query.h"
 #include "utils/logger.h"
@@ -35,15 +48,214 @@ static std::string readers_to_string (const std::vector<DocumentIndexManager::Re
   return os.str();
 }
 
+// the parallel partitions split the keys of the doc ids evenly: the numeric ids which are mostly sequential,
+// or the high 64 bits of uuids which are random. set_partition_key() gives the least doc id of the key.
+#if defined(REDGIANT_NUMERIC_DOC_IDS)
+static uint64_t get_partition_key(const NumericDocumentId& doc_id) {
+  return doc_id.get_id();
+}
+
+static void set_partition_key(NumericDocumentId& doc_id, uint64_t key) {
+  doc_id = NumericDocumentId(key);
+}
+#else
+static uint64_t get_partition_key(const DocumentId& doc_id) {
+  return doc_id.get_high();
+}
+
+static void set_partition_key(DocumentId& doc_id, uint64_t key) {
+  doc_id = DocumentId(0, key);
+}
+#endif
+
+// the posting lists of each feature space are created by the factory of its type, and the default type
+// of the index for spaces not listed. btree posting lists by default are left to the index itself.
+// if small_lists is set, short posting lists are converted into small posting lists once frozen.
+static DocumentIndex::FactorySelector create_factory_selector(const DocumentIndexManager::SpaceLists& space_lists,
+    const std::string& default_list, bool small_lists) {
+  auto create_factory = [small_lists] (const std::string& type) -> std::shared_ptr<DocumentIndex::PListFactory> {
+    std::shared_ptr<DocumentIndex::PListFactory> factory = DocumentIndexManager::create_list_factory(type);
+    if (!factory) {
+      LOG_ERROR(logger, "unknown posting list type %s, use btree instead.", type.c_str());
+      factory = DocumentIndexManager::create_list_factory(DocumentIndexManager::kBTreeList);
+    }
+    if (small_lists) {
+      factory = std::make_shared<SmallFreezingFactory<DocumentIndex::DocId, DocumentIndex::TermWeight>>(
+          std::move(factory));
+    }
+    return factory;
+  };
+  std::shared_ptr<DocumentIndex::PListFactory> default_factory;
+  if (default_list != DocumentIndexManager::kBTreeList || small_lists) {
+    default_factory = create_factory(default_list);
+  }
+  if (space_lists.empty() && !default_factory) {
+    return DocumentIndex::FactorySelector();
+  }
+  // indexed by space ids, the factories of the same type are shared
+  std::vector<std::shared_ptr<DocumentIndex::PListFactory>> factories;
+  std::map<std::string, std::shared_ptr<DocumentIndex::PListFactory>> factories_by_type;
+  for (const auto& pair: space_lists) {
+    auto& factory = factories_by_type[pair.second];
+    if (!factory) {
+      factory = create_factory(pair.second);
+    }
+    if (pair.first >= factories.size()) {
+      factories.resize(pair.first + 1, default_factory);
+    }
+    factories[pair.first] = factory;
+  }
+  return [factories, default_factory] (DocumentIndex::TermId term_id) -> const DocumentIndex::PListFactory* {
+    FeatureSpace::SpaceId space_id = FeatureSpace::get_part_space_id(term_id);
+    return space_id < factories.size() ? factories[space_id].get() : default_factory.get();
+  };
+}
+
+// the spaces of prior posting lists, indexed by space ids.
+static std::vector<bool> get_prior_spaces(const DocumentIndexManager::SpaceLists& space_lists) {
+  std::vector<bool> prior_spaces;
+  for (const auto& pair: space_lists) {
+    if (pair.second == DocumentIndexManager::kPriorList) {
+      if (pair.first >= prior_spaces.size()) {
+        prior_spaces.resize(pair.first + 1, false);
+      }
+      prior_spaces[pair.first] = true;
+    }
+  }
+  return prior_spaces;
+}
+
+// the input readers of the posting lists read by the given reader type, which are read through it as they are.
+template <typename InputReader>
+struct StaticInput {
+  static bool accepts(const DocumentQuery::ScoreReader::InputReader* input) {
+    return dynamic_cast<const InputReader*>(input);
+  }
+
+  static std::unique_ptr<InputReader> convert(std::unique_ptr<DocumentQuery::ScoreReader::InputReader> input) {
+    return std::unique_ptr<InputReader>(static_cast<InputReader*>(input.release()));
+  }
+};
+
+// the small posting lists mixed with the ones of LargeReader, which are wrapped without copying the postings.
+template <typename LargeReader>
+struct StaticInput<SmallOrPostingListReader<DocumentIndexManager::DocId, DocumentIndexManager::TermWeight,
+    LargeReader>> {
+  typedef SmallOrPostingListReader<DocumentIndexManager::DocId, DocumentIndexManager::TermWeight, LargeReader>
+      InputReader;
+
+  static bool accepts(const DocumentQuery::ScoreReader::InputReader* input) {
+    return dynamic_cast<const LargeReader*>(input) || dynamic_cast<const DocumentIndexManager::SmallReader*>(input);
+  }
+
+  static std::unique_ptr<InputReader> convert(std::unique_ptr<DocumentQuery::ScoreReader::InputReader> input) {
+    if (dynamic_cast<LargeReader*>(input.get())) {
+      return std::unique_ptr<InputReader>(new InputReader(
+          std::unique_ptr<LargeReader>(static_cast<LargeReader*>(input.release()))));
+    }
+    return std::unique_ptr<InputReader>(new InputReader(std::unique_ptr<DocumentIndexManager::SmallReader>(
+        static_cast<DocumentIndexManager::SmallReader*>(input.release()))));
+  }
+};
+
+// true if all the readers are scored readers of the inputs accepted by the given input reader type.
+template <typename InputReader>
+static bool is_input_of(const std::vector<std::unique_ptr<DocumentIndexManager::Reader>>& readers) {
+  for (const auto& reader: readers) {
+    const DocumentQuery::ScoreReader* score_reader = dynamic_cast<const DocumentQuery::ScoreReader*>(reader.get());
+    if (!score_reader || !StaticInput<InputReader>::accepts(&score_reader->get_input())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// compose the scored readers of the given input reader type statically, see is_input_of().
+template <typename InputReader>
+static std::unique_ptr<DocumentIndexManager::Reader> compose_static(
+    std::vector<std::unique_ptr<DocumentIndexManager::Reader>>& readers,
+    std::vector<std::unique_ptr<DocumentIndexManager::Reader>>& priors) {
+  typedef DocumentIndexManager::StaticScoreReader<InputReader> StaticScoreReader;
+  std::vector<std::unique_ptr<StaticScoreReader>> static_readers;
+  static_readers.reserve(readers.size());
+  for (auto& reader: readers) {
+    DocumentQuery::ScoreReader& score_reader = static_cast<DocumentQuery::ScoreReader&>(*reader);
+    std::unique_ptr<InputReader> input = StaticInput<InputReader>::convert(score_reader.release_input());
+    static_readers.emplace_back(new StaticScoreReader(std::move(input), score_reader.get_query_weight(),
+        score_reader.get_combiner()));
+  }
+  return std::unique_ptr<DocumentIndexManager::Reader>(
+      new DocumentIndexManager::StaticWandReader<InputReader>(std::move(static_readers), std::move(priors)));
+}
+
+// terms with high upper bounds first, so they are read first when cursors tie,
+// which makes the results better when the query is truncated by its latency budget.
+static void sort_by_upper_bound(std::vector<DocumentIndexManager::ReaderPair>& readers) {
+  std::stable_sort(readers.begin(), readers.end(),
+      [] (const DocumentIndexManager::ReaderPair& lhs, const DocumentIndexManager::ReaderPair& rhs) {
+    return lhs.second->upper_bound() > rhs.second->upper_bound();
+  });
+}
+
+#if defined(REDGIANT_FLOAT_WEIGHTS)
+// the weights of the index are float, to which the flat terms of document are converted. the buffer is reused
+// by the updates of the thread, and valid until the next conversion.
+template <typename Terms>
+static const DocumentIndex::DocTerms& to_doc_terms(const Terms& terms) {
+  static thread_local DocumentIndex::DocTerms converted;
+  converted.assign(terms.begin(), terms.end());
+  return converted;
+}
+#else
+// the flat terms of document are exactly the doc terms of index.
+static const DocumentIndex::DocTerms& to_doc_terms(const DocumentIndex::DocTerms& terms) {
+  return terms;
+}
+#endif
+
 const std::string DocumentIndexManager::kIndexFileNamePrefix = "doc_";
+const std::string DocumentIndexManager::kBTreeList = "btree";
+const std::string DocumentIndexManager::kSequentialList = "sequential";
+const std::string DocumentIndexManager::kTieredList = "tiered";
+const std::string DocumentIndexManager::kConstantList = "constant";
+const std::string DocumentIndexManager::kQuantized8List = "quantized8";
+const std::string DocumentIndexManager::kQuantized16List = "quantized16";
+const std::string DocumentIndexManager::kPriorList = "prior";
 
-DocumentIndexManager::DocumentIndexManager(size_t doc_initial_buckets, size_t doc_max_size)
-: index_(doc_initial_buckets, doc_max_size) {
+DocumentIndexManager::DocumentIndexManager(size_t doc_initial_buckets, size_t doc_max_size,
+    const SpaceLists& space_lists, const std::string& default_list, bool small_lists)
+: index_(doc_initial_buckets, doc_max_size, create_factory_selector(space_lists, default_list, small_lists)),
+  max_partition_key_(0), prior_spaces_(get_prior_spaces(space_lists)) {
 }
 
 DocumentIndexManager::DocumentIndexManager(size_t doc_initial_buckets, size_t doc_max_size,
-    const std::string& snapshot_prefix)
-: index_(doc_initial_buckets, doc_max_size, snapshot_prefix + kIndexFileNamePrefix + "0") {
+    const std::string& snapshot_prefix, const SpaceLists& space_lists, const std::string& default_list,
+    bool small_lists)
+: index_(doc_initial_buckets, doc_max_size, snapshot_prefix + kIndexFileNamePrefix + "0",
+    create_factory_selector(space_lists, default_list, small_lists)),
+  max_partition_key_(get_partition_key(index_.get_max_doc_id())), prior_spaces_(get_prior_spaces(space_lists)) {
+}
+
+std::shared_ptr<DocumentIndex::PListFactory> DocumentIndexManager::create_list_factory(const std::string& type) {
+  if (type == kBTreeList) {
+    return std::make_shared<BTreePostingListFactory<DocId, TermWeight>>();
+  } else if (type == kSequentialList || type == kPriorList) {
+    // changed as btree posting lists, and converted once frozen
+    return std::make_shared<SequentialFreezingFactory<DocId, TermWeight>>(
+        std::unique_ptr<DocumentIndex::PListFactory>(new BTreePostingListFactory<DocId, TermWeight>()));
+  } else if (type == kTieredList) {
+    return std::make_shared<TieredPostingListFactory<DocId, TermWeight>>();
+  } else if (type == kConstantList) {
+    return std::make_shared<ConstantFreezingFactory<DocId, TermWeight>>(
+        std::unique_ptr<DocumentIndex::PListFactory>(new BTreePostingListFactory<DocId, TermWeight>()));
+  } else if (type == kQuantized8List) {
+    return std::make_shared<QuantizedFreezingFactory<DocId, TermWeight, uint8_t>>(
+        std::unique_ptr<DocumentIndex::PListFactory>(new BTreePostingListFactory<DocId, TermWeight>()));
+  } else if (type == kQuantized16List) {
+    return std::make_shared<QuantizedFreezingFactory<DocId, TermWeight, uint16_t>>(
+        std::unique_ptr<DocumentIndex::PListFactory>(new BTreePostingListFactory<DocId, TermWeight>()));
+  }
+  return nullptr;
 }
 
 int DocumentIndexManager::remove(DocId doc_id) {
@@ -55,36 +267,33 @@ int DocumentIndexManager::batch_remove(const std::vector<DocId> doc_ids) {
 }
 
 int DocumentIndexManager::update(std::shared_ptr<Document> doc, time_t expire_time) {
-  StopWatch watch;
-  int ret = 0;
-  DocTerms weights;
-  // loop in all feature vectors
-  for (const auto& feature_vector: doc->get_feature_vectors()) {
-    // loop in features in vectors
-    for (const auto& feature_pair: feature_vector.get_features()) {
-      weights.emplace_back(feature_pair.first->get_id(), feature_pair.second);
-    }
-  }
-  return index_.update(doc->get_id(), weights, expire_time);
+  return update(*doc, expire_time);
+}
+
+int DocumentIndexManager::update(const Document& doc, time_t expire_time) {
+  update_partition_key(doc.get_id());
+  return index_.update(doc.get_id(), to_doc_terms(doc.get_terms()), expire_time);
 }
 
 int DocumentIndexManager::batch_update(const std::vector<std::shared_ptr<Document>>& docs, time_t expire_time) {
   StopWatch watch;
   std::vector<RowTuple> update_docs;
+  update_docs.reserve(docs.size());
   for (const auto& doc: docs) {
-    DocTerms weights;
-    // loop in all feature vectors
-    for (const auto& feature_vector: doc->get_feature_vectors()) {
-      // loop in features in vectors
-      for (const auto& feature_pair: feature_vector.get_features()) {
-        weights.emplace_back(feature_pair.first->get_id(), feature_pair.second);
-      }
-    }
-    update_docs.emplace_back(doc->get_id(), std::move(weights), expire_time);
+    update_partition_key(doc->get_id());
+    update_docs.emplace_back(doc->get_id(), DocTerms(doc->get_terms().begin(), doc->get_terms().end()),
+        expire_time);
   }
   return index_.batch_update(update_docs);
 }
 
+void DocumentIndexManager::update_partition_key(const DocId& doc_id) {
+  uint64_t key = get_partition_key(doc_id);
+  uint64_t max_key = max_partition_key_.load(std::memory_order_relaxed);
+  while (key > max_key && !max_partition_key_.compare_exchange_weak(max_key, key, std::memory_order_relaxed)) {
+  }
+}
+
 auto DocumentIndexManager::peek_term(TermId term_id) const
 -> std::unique_ptr<RawReader> {
   return index_.peek(term_id);
@@ -95,9 +304,16 @@ auto DocumentIndexManager::peek_term(TermId term_id) const
 //  return index_.peek(term_id);
 //}
 
-auto DocumentIndexManager::query(const QueryRequest& request, const DocumentQuery& query) const
+auto DocumentIndexManager::query(const QueryRequest& request, const DocumentQuery& query,
+    QueryPlanner::Plan* plan, const std::function<bool ()>& stop, bool* stopped) const
 -> std::unique_ptr<Reader> {
   StopWatch watch;
+  if (plan) {
+    *plan = QueryPlanner::kPlanEmpty;
+  }
+  if (stopped) {
+    *stopped = false;
+  }
 
   size_t query_size = query.get_doc_queries().size();
   if (query_size == 0) {
@@ -108,26 +324,216 @@ auto DocumentIndexManager::query(const QueryRequest& request, const DocumentQuer
   std::vector<ReaderPair> readers = index_.batch_query(query.get_doc_queries());
 
   if (request.is_debug()) {
-    LOG_INFO(logger, "[query:%s] document query %zu terms, found %zu terms.",
+    LOG_INFO(logger, "[query:%s] document query %zu terms, found %zu term readers.",
         request.get_request_id().c_str(), query.get_doc_queries().size(), readers.size());
     LOG_TRACE(logger, "[query:%s] document query found terms:%s",
         request.get_request_id().c_str(), readers_to_string(readers).c_str());
   }
 
-  if (readers.size() == 0) {
+  // the priors are not counted as terms by the planner, since they are not searched.
+  std::vector<std::unique_ptr<Reader>> priors = take_priors(readers);
+
+  std::vector<QueryPlanner::TermStats> terms;
+  terms.reserve(readers.size());
+  size_t postings = 0;
+  for (const auto& reader: readers) {
+    terms.push_back({reader.second->size(), reader.second->upper_bound()});
+    postings += reader.second->size();
+  }
+  QueryPlanner::Plan query_plan = planner_.plan(terms, query.get_query_count());
+  if (!priors.empty() && query_plan != QueryPlanner::kPlanEmpty && query_plan != QueryPlanner::kPlanParallel) {
+    // only the WAND readers take the priors
+    query_plan = QueryPlanner::kPlanWand;
+  }
+  if (plan) {
+    *plan = query_plan;
+  }
+  if (request.is_debug()) {
+    LOG_INFO(logger, "[query:%s] query plan: %s, %zu term readers, %zu priors, %zu postings.",
+        request.get_request_id().c_str(), QueryPlanner::get_plan_name(query_plan), readers.size(), priors.size(),
+        postings);
+  }
+
+  if (query_plan == QueryPlanner::kPlanEmpty) {
     return nullptr;
   }
-  if (readers.size() == 1) {
+  if (query_plan == QueryPlanner::kPlanSingle) {
     return std::move(readers[0].second);
   }
 
+  sort_by_upper_bound(readers);
+
   // TODO: simplify this
   std::vector<std::unique_ptr<Reader>> simple_readers;
   simple_readers.reserve(readers.size());
   for (auto& reader: readers) {
     simple_readers.push_back(std::move(reader.second));
   }
-  return std::unique_ptr<Reader>(new WandReader<DocId, Score>(std::move(simple_readers)));
+  switch (query_plan) {
+  case QueryPlanner::kPlanParallel:
+    return query_parallel(query, simple_readers);
+  case QueryPlanner::kPlanTaat: {
+    bool taat_stopped = false;
+    std::unique_ptr<Reader> reader(new TaatReader<DocId, Score, DocumentIndex::DocIdHash>(
+        std::move(simple_readers), [&stop] { return stop && stop(); }, taat_stopped));
+    if (stopped) {
+      *stopped = taat_stopped;
+    }
+    return reader;
+  }
+  case QueryPlanner::kPlanMaxScore:
+    return std::unique_ptr<Reader>(new MaxScoreReader<DocId, Score>(std::move(simple_readers)));
+  default:
+    return query_wand(request, std::move(simple_readers), std::move(priors));
+  }
+}
+
+auto DocumentIndexManager::query_wand(const QueryRequest& request,
+    std::vector<std::unique_ptr<Reader>>&& readers, std::vector<std::unique_ptr<Reader>>&& priors) const
+-> std::unique_ptr<Reader> {
+  // the terms are composed statically only if all of them are read by the same concrete reader type,
+  // e.g. the posting lists of the tiered spaces are read through the virtual interface. the small posting
+  // lists mixed with btree or sequential ones are read by a branch between the two concrete types.
+  std::unique_ptr<Reader> reader;
+  if (is_input_of<SmallReader>(readers)) {
+    reader = compose_static<SmallReader>(readers, priors);
+  } else if (is_input_of<BTreeReader>(readers)) {
+    reader = compose_static<BTreeReader>(readers, priors);
+  } else if (is_input_of<SequentialReader>(readers)) {
+    reader = compose_static<SequentialReader>(readers, priors);
+  } else if (is_input_of<ConstantReader>(readers)) {
+    reader = compose_static<ConstantReader>(readers, priors);
+  } else if (is_input_of<SmallOrBTreeReader>(readers)) {
+    reader = compose_static<SmallOrBTreeReader>(readers, priors);
+  } else if (is_input_of<SmallOrSequentialReader>(readers)) {
+    reader = compose_static<SmallOrSequentialReader>(readers, priors);
+  } else {
+    return std::unique_ptr<Reader>(new WandReader<DocId, Score>(std::move(readers), std::move(priors)));
+  }
+  if (request.is_debug()) {
+    LOG_INFO(logger, "[query:%s] composed %zu term readers statically.",
+        request.get_request_id().c_str(), readers.size());
+  }
+  return reader;
+}
+
+auto DocumentIndexManager::query_parallel(const DocumentQuery& query,
+    const std::vector<std::unique_ptr<Reader>>& readers) const
+-> std::unique_ptr<Reader> {
+  // the k-th score estimated by the whole posting lists
+  size_t query_count = query.get_query_count();
+  Score estimated_score(0);
+  if (!estimate_sum_kth_weight(readers, query_count, estimated_score)) {
+    query_count = 0;
+  }
+
+  // the partitions split the keys of the doc ids evenly up to the greatest one: (bounds[i], bounds[i+1]].
+  // the last partition is unbounded, for the doc ids updated after the key is read. the bounds are valid
+  // doc ids as long as the step is not zero.
+  size_t partition_num = planner_.get_parallel_partitions();
+  uint64_t step = std::max<uint64_t>(max_partition_key_.load(std::memory_order_relaxed) / partition_num, 1);
+  std::vector<DocId> bounds(partition_num + 1);
+  for (size_t i = 1; i < partition_num; ++i) {
+    set_partition_key(bounds[i], step * i);
+  }
+
+  // all partitions read the same posting lists
+  std::vector<std::vector<ReaderPair>> copies = index_.batch_query(query.get_doc_queries(), partition_num);
+  std::vector<std::unique_ptr<Reader>> partitions;
+  partitions.reserve(partition_num);
+  for (size_t i = 0; i < partition_num; ++i) {
+    // the priors are only looked up by the documents found, so they are not limited by the range
+    std::vector<std::unique_ptr<Reader>> priors = take_priors(copies[i]);
+    sort_by_upper_bound(copies[i]);
+    std::vector<std::unique_ptr<Reader>> range_readers;
+    range_readers.reserve(copies[i].size());
+    for (auto& reader: copies[i]) {
+      range_readers.emplace_back(new RangeReader<DocId, Score>(std::move(reader.second), bounds[i], bounds[i + 1]));
+    }
+    partitions.emplace_back(new WandReader<DocId, Score>(std::move(range_readers), std::move(priors)));
+  }
+  return std::unique_ptr<Reader>(new ParallelReader(std::move(partitions), query_count, estimated_score));
+}
+
+auto DocumentIndexManager::take_priors(std::vector<ReaderPair>& readers) const
+-> std::vector<std::unique_ptr<Reader>> {
+  std::vector<std::unique_ptr<Reader>> priors;
+  if (prior_spaces_.empty()) {
+    return priors;
+  }
+  auto terms_end = std::stable_partition(readers.begin(), readers.end(), [this] (const ReaderPair& reader) {
+    return !is_prior(reader.first);
+  });
+  if (terms_end == readers.begin()) {
+    // no other terms, the priors are read as terms, e.g. the most popular documents
+    return priors;
+  }
+  priors.reserve(readers.end() - terms_end);
+  for (auto iter = terms_end; iter != readers.end(); ++iter) {
+    priors.push_back(std::move(iter->second));
+  }
+  readers.erase(terms_end, readers.end());
+  return priors;
+}
+
+auto DocumentIndexManager::batch_search(const std::vector<const IntermQuery*>& queries,
+    const std::vector<size_t>& counts, const std::vector<Score>& min_scores, const std::function<bool ()>& stop,
+    bool& stopped) const
+-> std::vector<Results> {
+  StopWatch watch;
+  // the union of the terms, and the queries containing each of them
+  std::unordered_map<TermId, size_t> term_indexes;
+  std::vector<TermId> term_ids;
+  std::vector<std::vector<std::pair<size_t, IntermQuery::QueryWeight>>> term_queries;
+  size_t query_terms = 0;
+  for (size_t i = 0; i < queries.size(); ++i) {
+    if (!queries[i]) {
+      continue;
+    }
+    for (const auto& feature: queries[i]->get_features()) {
+      auto ret = term_indexes.emplace(feature.first, term_ids.size());
+      if (ret.second) {
+        term_ids.push_back(feature.first);
+        term_queries.emplace_back();
+      }
+      term_queries[ret.first->second].emplace_back(i, feature.second);
+      ++query_terms;
+    }
+  }
+
+  std::vector<std::unique_ptr<RawReader>> found = index_.batch_peek(term_ids);
+  // like take_priors(), the priors of a query are read as terms unless it has other terms found.
+  std::vector<bool> has_terms(queries.size(), false);
+  for (size_t i = 0; i < found.size(); ++i) {
+    if (found[i] && !is_prior(term_ids[i])) {
+      for (const auto& query: term_queries[i]) {
+        has_terms[query.first] = true;
+      }
+    }
+  }
+  std::vector<std::unique_ptr<RawReader>> readers;
+  std::vector<std::vector<std::pair<size_t, IntermQuery::QueryWeight>>> found_queries;
+  std::vector<std::vector<std::pair<size_t, IntermQuery::QueryWeight>>> prior_queries;
+  readers.reserve(found.size());
+  found_queries.reserve(found.size());
+  prior_queries.reserve(found.size());
+  for (size_t i = 0; i < found.size(); ++i) {
+    if (found[i]) {
+      readers.push_back(std::move(found[i]));
+      found_queries.emplace_back();
+      prior_queries.emplace_back();
+      bool prior = is_prior(term_ids[i]);
+      for (auto& query: term_queries[i]) {
+        (prior && has_terms[query.first] ? prior_queries : found_queries).back().push_back(std::move(query));
+      }
+    }
+  }
+
+  std::vector<Results> results;
+  read_batch_topn(readers, found_queries, prior_queries, counts, min_scores, stop, stopped, results);
+  LOG_DEBUG(logger, "batch search: %zu queries, %zu terms, %zu distinct terms, %zu found, latency=%ldus",
+      queries.size(), query_terms, term_ids.size(), readers.size(), watch.get_ticks_us());
+  return results;
 }
 
 int DocumentIndexManager::dump(const std::string& snapshot_prefix) {
@@ -1,17 +1,30 @@
 #ifndef SRC_MAIN_INDEX_DOCUMENT_INDEX_MANGER_H_
 #define SRC_MAIN_INDEX_DOCUMENT_INDEX_MANGER_H_
 
+#include <atomic>
+#include <functional>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "core/index/btree_posting_list.h"
+#include "core/index/constant_posting_list.h"
+#include "core/index/quantized_posting_list.h"
+#include "core/index/sequential_posting_list.h"
+#include "core/index/small_posting_list.h"
+#include "core/reader/parallel_reader.h"
+#include "core/reader/wand_reader.h"
 #include "data/document.h"
+#include "data/feature_space.h"
 #include "index/document_index.h"
 #include "index/document_query.h"
 #include "index/index_manager.h"
+#include "index/query_planner.h"
 
 namespace redgiant {
+class IntermQuery;
 class QueryRequest;
 
 class DocumentIndexManager: public IndexManager {
@@ -24,15 +37,61 @@ public:
   typedef DocumentIndex::RowTuple RowTuple;
   typedef DocumentIndex::RawReader RawReader;
   typedef DocumentQuery::Score Score;
+  typedef DocumentQuery::Results Results;
   // the reader type is identical for both doc index and gmp index
   typedef DocumentIndex::Reader<Score> Reader;
   typedef DocumentIndex::ReaderPair<Score> ReaderPair;
+  typedef redgiant::ParallelReader<DocId, Score> ParallelReader;
+  // the WAND reader composed statically over the posting lists of a concrete reader type, either the btree,
+  // the sequential, the constant or the small ones, or the small ones mixed with the btree or the sequential ones,
+  // so that the terms are scored and read without virtual calls.
+  typedef BTreePostingListReader<DocId, TermWeight> BTreeReader;
+  typedef SequentialPostingListReader<DocId, TermWeight> SequentialReader;
+  typedef ConstantPostingListReader<DocId, TermWeight> ConstantReader;
+  typedef SmallPostingListReader<DocId, TermWeight> SmallReader;
+  // the small posting lists mixed with the btree or the sequential ones.
+  typedef SmallOrPostingListReader<DocId, TermWeight, BTreeReader> SmallOrBTreeReader;
+  typedef SmallOrPostingListReader<DocId, TermWeight, SequentialReader> SmallOrSequentialReader;
+  template <typename InputReader>
+  using StaticScoreReader = DocumentQuery::ScoreReader::WithInput<InputReader>;
+  template <typename InputReader>
+  using StaticWandReader = WandReader<DocId, Score, StaticScoreReader<InputReader>>;
+  typedef FeatureSpace::SpaceId SpaceId;
+  // the posting list types of the feature spaces, by names of the types.
+  typedef std::map<SpaceId, std::string> SpaceLists;
+
+  // names of the posting list types
+  // btree: changed in place, the default.
+  // sequential: changed as btree posting lists, and converted into sorted arrays once frozen.
+  // tiered: split into tiers by weights, for features with skewed weights.
+  // constant: as sequential, but only the doc ids are stored if all the weights are the same, for features
+  // without weights.
+  // quantized8, quantized16: as sequential, but the weights are quantized into 8 or 16 bits codes.
+  // prior: as sequential, for query-independent scores like popularity. they are added to the documents found
+  // by the other terms of the queries as priors, instead of being searched like the terms, see WandReader.
+  static const std::string kBTreeList;
+  static const std::string kSequentialList;
+  static const std::string kTieredList;
+  static const std::string kConstantList;
+  static const std::string kQuantized8List;
+  static const std::string kQuantized16List;
+  static const std::string kPriorList;
 
   // create a default index.
-  DocumentIndexManager(size_t doc_initial_buckets, size_t doc_max_size = 0);
+  // posting lists of the features in the spaces of space_lists are of the given types, and others are of
+  // default_list. if small_lists is set, posting lists of a few postings are stored inline in small posting
+  // lists once frozen, except the tiered ones which are not readable until frozen.
+  DocumentIndexManager(size_t doc_initial_buckets, size_t doc_max_size = 0,
+      const SpaceLists& space_lists = SpaceLists(), const std::string& default_list = kBTreeList,
+      bool small_lists = false);
 
   // recover an index from dumped snapshot.
-  DocumentIndexManager(size_t doc_initial_buckets, size_t doc_max_size, const std::string& snapshot_prefix);
+  DocumentIndexManager(size_t doc_initial_buckets, size_t doc_max_size, const std::string& snapshot_prefix,
+      const SpaceLists& space_lists = SpaceLists(), const std::string& default_list = kBTreeList,
+      bool small_lists = false);
+
+  // the factory of the posting list type, or null if the type is unknown.
+  static std::shared_ptr<DocumentIndex::PListFactory> create_list_factory(const std::string& type);
 
   virtual ~DocumentIndexManager() = default;
 
@@ -42,6 +101,11 @@ public:
 
   virtual int do_maintain(time_t time);
 
+  // changed every time updates are applied to the index.
+  uint64_t get_generation() const {
+    return index_.get_generation();
+  }
+
   int dump(const std::string& snapshot_prefix);
 
   int remove(DocId doc_id);
@@ -50,17 +114,65 @@ public:
 
   int update(std::shared_ptr<Document> doc, time_t expire_time);
 
+  int update(const Document& doc, time_t expire_time);
+
   int batch_update(const std::vector<std::shared_ptr<Document>>& docs, time_t expire_time);
 
   std::unique_ptr<RawReader> peek_term(TermId term_id) const;
 
 //  std::shared_ptr<Document> peek_doc(DocId doc_id) const;
 
-  std::unique_ptr<Reader> query(const QueryRequest& request, const DocumentQuery& query) const;
+  // not thread safe, should be set before querying.
+  void set_planner(const QueryPlanner& planner) {
+    planner_ = planner;
+  }
+
+  // the reading algorithm is chosen by the planner, and returned by plan if given.
+  // the reader of the parallel plan is a ParallelReader, which could be read by read_topn_parallel().
+  // the term-at-a-time plan reads the postings here, checking stop() if given, and stopped is set if
+  // it returns true before reading through.
+  std::unique_ptr<Reader> query(const QueryRequest& request, const DocumentQuery& query,
+      QueryPlanner::Plan* plan = nullptr, const std::function<bool ()>& stop = nullptr,
+      bool* stopped = nullptr) const;
+
+  // search a batch of queries together: the posting list of each term is read only once for all
+  // the queries containing it, and the documents are scored document-at-a-time for each query.
+  // the priors are added to the documents found by the other terms of each query, like query().
+  // results[i] are the top counts[i] documents of queries[i] scored greater than min_scores[i], and
+  // null queries have no results. stopped is set if stop() returns true before reading through.
+  std::vector<Results> batch_search(const std::vector<const IntermQuery*>& queries,
+      const std::vector<size_t>& counts, const std::vector<Score>& min_scores, const std::function<bool ()>& stop,
+      bool& stopped) const;
 
 private:
+  // a StaticWandReader if all the terms are read from posting lists of the same type with a static reader,
+  // or a WandReader otherwise. the priors are added to the documents found by the terms.
+  std::unique_ptr<Reader> query_wand(const QueryRequest& request,
+      std::vector<std::unique_ptr<Reader>>&& readers, std::vector<std::unique_ptr<Reader>>&& priors) const;
+
+  // one WAND reader for each partition of the doc ids.
+  std::unique_ptr<Reader> query_parallel(const DocumentQuery& query,
+      const std::vector<std::unique_ptr<Reader>>& readers) const;
+
+  // move the readers of the prior spaces out of readers, unless there are no other terms.
+  std::vector<std::unique_ptr<Reader>> take_priors(std::vector<ReaderPair>& readers) const;
+
+  // true if the term is of a prior space.
+  bool is_prior(TermId term_id) const {
+    SpaceId space_id = FeatureSpace::get_part_space_id(term_id);
+    return space_id < prior_spaces_.size() && prior_spaces_[space_id];
+  }
+
+  // raise the greatest partition key by the doc id updated.
+  void update_partition_key(const DocId& doc_id);
+
   static const std::string kIndexFileNamePrefix;
   DocumentIndex index_;
+  QueryPlanner planner_;
+  // the doc ids are split evenly up to the greatest key into the parallel partitions, see query_parallel().
+  std::atomic<uint64_t> max_partition_key_;
+  // indexed by space ids, true for the spaces of prior posting lists
+  std::vector<bool> prior_spaces_;
 };
 } /* namespace redgiant */
 
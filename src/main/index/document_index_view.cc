@@ -5,7 +5,6 @@
 #include <utility>
 
 #include "data/document.h"
-#include "data/document_id.h"
 #include "data/document_update_request.h"
 #include "index/document_index_manager.h"
 
@@ -24,8 +23,13 @@ void DocumentIndexView::update_document_async(const std::string& uuid, time_t ex
   update_pipeline_->schedule(std::make_shared<DocumentUpdateRequest>(std::move(doc), expire_time));
 }
 
+void DocumentIndexView::update_document_async(const std::string& uuid, time_t expire_time, std::string content,
+    bool binary) {
+  update_pipeline_->schedule(std::make_shared<DocumentUpdateRequest>(uuid, std::move(content), expire_time, binary));
+}
+
 void DocumentIndexView::remove_document(const std::string& uuid) {
-  index_->remove(DocumentId(uuid));
+  index_->remove(Document::DocId(uuid));
 }
 
 void DocumentIndexView::dump(const std::string& snapshot_prefix) {
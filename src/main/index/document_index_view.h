@@ -20,6 +20,10 @@ public:
 
   void update_document_async(const std::string& uuid, time_t expire_time, std::shared_ptr<Document> doc);
 
+  // the raw content is parsed by the update pipeline.
+  void update_document_async(const std::string& uuid, time_t expire_time, std::string content,
+      bool binary = false);
+
   void remove_document(const std::string& uuid);
 
   //void remove_document_async(const std::string& uuid);
@@ -6,13 +6,14 @@
 #include <utility>
 #include <vector>
 
+#include "core/query/dot_product_query.h"
 #include "core/query/posting_list_query.h"
+#include "data/interm_query.h"
 #include "index/document_index.h"
 #include "index/document_traits.h"
 
 namespace redgiant {
 class QueryRequest;
-class IntermQuery;
 
 class DocumentQuery {
 public:
@@ -21,6 +22,10 @@ public:
   typedef typename DocumentIndex::QueryPair<Score> DocQueryPair;
   typedef typename DocumentIndex::Results<Score> Results;
   typedef typename DocumentIndex::TermId TermId;
+  // the terms are scored by the dot product of the document weights and the query weights.
+  typedef DotProductQuery<DocumentTraits::DocId, Score, const DocumentTraits::TermWeight&,
+      IntermQuery::QueryWeight> ConcreteDocQuery;
+  typedef typename ConcreteDocQuery::ScoreReader ScoreReader;
 
   DocumentQuery(const QueryRequest& request, const IntermQuery& interm_query);
 
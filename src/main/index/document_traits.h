@@ -4,7 +4,6 @@
 #include <functional>
 
 #include "data/document.h"
-#include "data/document_id.h"
 #include "data/feature.h"
 #include "data/feature_vector.h"
 
@@ -12,11 +11,17 @@ namespace redgiant {
 class DocumentTraits {
 public:
   typedef Document Doc;
-  typedef DocumentId DocId;
+  typedef Document::DocId DocId;
   typedef Feature::FeatureId TermId;
+#if defined(REDGIANT_FLOAT_WEIGHTS)
+  // the weights of the postings in single precision, e.g. configure --enable-float-weights, which halves the
+  // memory of the weights. the scores are still calculated in double.
+  typedef float TermWeight;
+#else
   typedef FeatureVector::FeatureWeight TermWeight;
+#endif
   typedef int32_t ExpireTime;
-  typedef DocumentId::Hash DocIdHash;
+  typedef DocId::Hash DocIdHash;
   typedef std::hash<TermId> TermIdHash;
 };
 } /* namespace redgiant */
@@ -12,9 +12,12 @@ namespace redgiant {
 DECLARE_LOGGER(logger, __FILE__);
 
 DocumentUpdatePipeline::DocumentUpdatePipeline(size_t thread_num,
-    size_t queue_size, DocumentIndexManager* index) {
+    size_t queue_size, DocumentIndexManager* index,
+    std::shared_ptr<ParserFactory<Document>> parser_factory, Stats* stats)
+: parse_errors_(stats ? stats->get_counter("document.parse_error") : nullptr) {
   feed_document_ = std::make_shared<WorkerExecutor<DocumentUpdateRequest, DocumentUpdateWorker>>(
-      std::make_shared<FeedDocumentWorkerFactory>(index), thread_num, queue_size);
+      std::make_shared<FeedDocumentWorkerFactory>(index, std::move(parser_factory), parse_errors_),
+      thread_num, queue_size);
 }
 
 void DocumentUpdatePipeline::start() {
@@ -3,24 +3,36 @@
 
 #include <memory>
 
+#include "data/parser.h"
 #include "utils/concurrency/job_executor.h"
 #include "utils/concurrency/worker_executor.h"
+#include "utils/stats.h"
 
 namespace redgiant {
+class Document;
 class DocumentIndexManager;
 class DocumentUpdateRequest;
 class DocumentUpdateWorker;
 
 class DocumentUpdatePipeline: public JobExecutor<DocumentUpdateRequest> {
 public:
-  DocumentUpdatePipeline(size_t thread_num, size_t queue_size, DocumentIndexManager* index);
+  // parser_factory is used to parse the raw content of requests in the worker threads.
+  // the requests dropped for parse errors are counted in document.parse_error of stats if given.
+  DocumentUpdatePipeline(size_t thread_num, size_t queue_size, DocumentIndexManager* index,
+      std::shared_ptr<ParserFactory<Document>> parser_factory = nullptr, Stats* stats = nullptr);
   virtual ~DocumentUpdatePipeline() = default;
 
   virtual void start();
   virtual void stop();
   virtual void schedule(std::shared_ptr<DocumentUpdateRequest> job);
 
+  // number of requests dropped by the workers because of parse errors.
+  size_t get_parse_error_count() const {
+    return parse_errors_ ? parse_errors_->load(std::memory_order_relaxed) : 0;
+  }
+
 private:
+  Stats::Counter* parse_errors_;
   std::shared_ptr<WorkerExecutor<DocumentUpdateRequest, DocumentUpdateWorker>> feed_document_;
 };
 } /* namespace redgiant */
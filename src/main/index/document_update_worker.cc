@@ -2,8 +2,8 @@
 
 #include <memory>
 
+#include "data/binary_format.h"
 #include "data/document_update_request.h"
-#include "index/document_update_worker.h"
 #include "index/document_index_manager.h"
 #include "utils/logger.h"
 #include "utils/stop_watch.h"
@@ -21,7 +21,70 @@ void DocumentUpdateWorker::cleanup() {
 
 void DocumentUpdateWorker::execute(DocumentUpdateRequest& job) {
   LOG_DEBUG(logger, "worker received job");
-  index_->update(job.get_doc(), job.get_expire_time());
+  if (job.get_doc()) {
+    index_->update(job.get_doc(), job.get_expire_time());
+    return;
+  }
+
+  if (job.is_binary()) {
+    update_binary(job);
+    return;
+  }
+
+  doc_.clear();
+  if (parse_document(job, doc_) < 0) {
+    Stats::increase(parse_errors_);
+    return;
+  }
+  index_->update(doc_, job.get_expire_time());
+}
+
+int DocumentUpdateWorker::parse_document(const DocumentUpdateRequest& job, Document& doc) {
+  if (!parser_) {
+    LOG_ERROR(logger, "document[%s]: no parser for raw content, dropped.", job.get_uuid().c_str());
+    return -1;
+  }
+
+  // if there is no uuid in post content, use the one from the query param.
+  if (!job.get_uuid().empty()) {
+    doc.set_doc_id(job.get_uuid().data(), job.get_uuid().size());
+  }
+
+  const std::string& content = job.get_content();
+  if (parser_->parse(content.data(), content.size(), doc) < 0) {
+    LOG_ERROR(logger, "document[%s]: parse error, dropped.", job.get_uuid().c_str());
+    return -1;
+  }
+  LOG_TRACE(logger, "document[%s]: parsed, %.3f ms since received.", doc.get_id_str().c_str(),
+      job.get_watch().get_time_ms());
+  return 0;
+}
+
+// the records are all parsed before any of them is applied, so that they are updated only if all are valid.
+void DocumentUpdateWorker::update_binary(const DocumentUpdateRequest& job) {
+  const char* data = job.get_content().data();
+  size_t len = job.get_content().size();
+  size_t count = 0;
+  while (len > 0) {
+    size_t record_size = BinaryFormat::get_record_size(data, len);
+    if (count == binary_docs_.size()) {
+      binary_docs_.emplace_back();
+    }
+    Document& doc = binary_docs_[count];
+    doc.clear();
+    if (record_size == 0 || binary_parser_.parse(data, record_size, doc) < 0) {
+      LOG_ERROR(logger, "binary documents: parse error in record %zu, all %zu bytes dropped.", count,
+          job.get_content().size());
+      Stats::increase(parse_errors_);
+      return;
+    }
+    ++count;
+    data += record_size;
+    len -= record_size;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    index_->update(binary_docs_[i], job.get_expire_time());
+  }
 }
 
 } /* namespace redgiant */
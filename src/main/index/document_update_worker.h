@@ -2,17 +2,24 @@
 #define SRC_MAIN_FEEDING_FEED_DOCUMENT_WORKER_H_
 
 #include <memory>
+#include <utility>
+#include <vector>
 
+#include "data/binary_parser.h"
 #include "data/document_update_request.h"
+#include "data/parser.h"
 #include "utils/concurrency/worker.h"
+#include "utils/stats.h"
 
 namespace redgiant {
 class DocumentIndexManager;
 
 class DocumentUpdateWorker: public Worker<DocumentUpdateRequest> {
 public:
-  DocumentUpdateWorker(DocumentIndexManager* index)
-  : index_(index) {
+  DocumentUpdateWorker(DocumentIndexManager* index,
+      std::unique_ptr<Parser<Document>> parser = nullptr,
+      Stats::Counter* parse_errors = nullptr)
+  : index_(index), parser_(std::move(parser)), parse_errors_(parse_errors) {
   }
 
   virtual ~DocumentUpdateWorker() = default;
@@ -22,23 +29,41 @@ public:
   virtual void execute(DocumentUpdateRequest& job);
 
 private:
+  int parse_document(const DocumentUpdateRequest& job, Document& doc);
+
+  void update_binary(const DocumentUpdateRequest& job);
+
   DocumentIndexManager* index_;
+  // reused by every raw request, to avoid allocations on parsing
+  Document doc_;
+  // parses the raw content of requests, one parser per worker thread
+  std::unique_ptr<Parser<Document>> parser_;
+  BinaryDocumentParser binary_parser_;
+  // the records of binary requests, reused as doc_
+  std::vector<Document> binary_docs_;
+  // shared among all workers of the pipeline
+  Stats::Counter* parse_errors_;
 };
 
 class FeedDocumentWorkerFactory: public WorkerFactory<DocumentUpdateWorker> {
 public:
-  FeedDocumentWorkerFactory(DocumentIndexManager* index)
-  : index_(index) {
+  FeedDocumentWorkerFactory(DocumentIndexManager* index,
+      std::shared_ptr<ParserFactory<Document>> parser_factory = nullptr,
+      Stats::Counter* parse_errors = nullptr)
+  : index_(index), parser_factory_(std::move(parser_factory)), parse_errors_(parse_errors) {
   }
 
   virtual ~FeedDocumentWorkerFactory() = default;
 
   virtual std::unique_ptr<DocumentUpdateWorker> create() {
-    return std::unique_ptr<DocumentUpdateWorker>(new DocumentUpdateWorker(index_));
+    return std::unique_ptr<DocumentUpdateWorker>(new DocumentUpdateWorker(index_,
+        parser_factory_ ? parser_factory_->create_parser() : nullptr, parse_errors_));
   }
 
 private:
   DocumentIndexManager* index_;
+  std::shared_ptr<ParserFactory<Document>> parser_factory_;
+  Stats::Counter* parse_errors_;
 };
 } /* namespace redgiant */
 
@@ -0,0 +1,67 @@
+#include "index/query_planner.h"
+
+#include <algorithm>
+
+namespace redgiant {
+
+auto QueryPlanner::plan(const std::vector<TermStats>& terms, size_t query_count) const
+-> Plan {
+  if (terms.empty()) {
+    return kPlanEmpty;
+  }
+  if (terms.size() == 1) {
+    return kPlanSingle;
+  }
+
+  size_t postings = 0;
+  for (const auto& term: terms) {
+    postings += term.size;
+  }
+  if (postings <= taat_max_postings_ || postings <= query_count * kTaatCountRatio) {
+    return kPlanTaat;
+  }
+
+  if (parallel_min_postings_ > 0 && parallel_partitions_ > 1 && postings >= parallel_min_postings_) {
+    return kPlanParallel;
+  }
+
+  if (terms.size() >= kMaxScoreMinTerms) {
+    // skewed if the lower half of the terms could not beat the greatest one altogether,
+    // then they turn non-essential once the threshold reaches the greatest upper bound.
+    std::vector<Score> upper_bounds;
+    upper_bounds.reserve(terms.size());
+    for (const auto& term: terms) {
+      upper_bounds.push_back(term.upper_bound);
+    }
+    std::sort(upper_bounds.begin(), upper_bounds.end());
+    Score lower_half(0);
+    for (size_t i = 0; i < upper_bounds.size() / 2; ++i) {
+      lower_half += upper_bounds[i];
+    }
+    if (lower_half < upper_bounds.back()) {
+      return kPlanMaxScore;
+    }
+  }
+  return kPlanWand;
+}
+
+const char* QueryPlanner::get_plan_name(Plan plan) {
+  switch (plan) {
+  case kPlanEmpty:
+    return "empty";
+  case kPlanSingle:
+    return "single";
+  case kPlanTaat:
+    return "taat";
+  case kPlanWand:
+    return "wand";
+  case kPlanMaxScore:
+    return "max_score";
+  case kPlanParallel:
+    return "parallel";
+  default:
+    return "unknown";
+  }
+}
+
+} /* namespace redgiant */
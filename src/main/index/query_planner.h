@@ -0,0 +1,74 @@
+#ifndef SRC_MAIN_INDEX_QUERY_PLANNER_H_
+#define SRC_MAIN_INDEX_QUERY_PLANNER_H_
+
+#include <vector>
+
+#include "index/document_query.h"
+
+namespace redgiant {
+/*
+ * Chooses the algorithm reading the terms of a query, by the statistics of
+ * the terms found in the index:
+ * - a single term is read directly, from the head of its posting list if kept.
+ * - a few short posting lists, or queries asking for a large part of the postings,
+ *   are accumulated term-at-a-time, since there is little to skip.
+ * - many terms with skewed upper bounds are read by MaxScore, since the terms
+ *   of low upper bounds become non-essential soon.
+ * - others are read by WAND, and the queries of too many postings are partitioned
+ *   by doc ids and read concurrently, if enabled.
+ */
+class QueryPlanner {
+public:
+  typedef DocumentQuery::Score Score;
+
+  enum Plan {
+    kPlanEmpty = 0,
+    kPlanSingle,
+    kPlanTaat,
+    kPlanWand,
+    kPlanMaxScore,
+    kPlanParallel,
+
+    kPlanCount
+  };
+
+  // statistics of a term found in the index
+  struct TermStats {
+    size_t size;
+    Score upper_bound;
+  };
+
+  static const size_t kDefaultTaatMaxPostings = 4096;
+  // queries asking for more than 1/kTaatCountRatio of the postings hardly skip any
+  static const size_t kTaatCountRatio = 16;
+  // the least number of terms read by MaxScore
+  static const size_t kMaxScoreMinTerms = 8;
+  static const size_t kDefaultParallelPartitions = 16;
+
+  // queries reading no more than taat_max_postings postings in total are accumulated term-at-a-time.
+  // queries reading no less than parallel_min_postings postings in total are read in parallel
+  // by parallel_partitions partitions, 0 for never.
+  QueryPlanner(size_t taat_max_postings = kDefaultTaatMaxPostings, size_t parallel_min_postings = 0,
+      size_t parallel_partitions = kDefaultParallelPartitions)
+  : taat_max_postings_(taat_max_postings), parallel_min_postings_(parallel_min_postings),
+    parallel_partitions_(parallel_partitions) {
+  }
+
+  ~QueryPlanner() = default;
+
+  Plan plan(const std::vector<TermStats>& terms, size_t query_count) const;
+
+  size_t get_parallel_partitions() const {
+    return parallel_partitions_;
+  }
+
+  static const char* get_plan_name(Plan plan);
+
+private:
+  size_t taat_max_postings_;
+  size_t parallel_min_postings_;
+  size_t parallel_partitions_;
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_INDEX_QUERY_PLANNER_H_ */
@@ -4,20 +4,27 @@
 #include <exception>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <libgen.h>
 #include <signal.h>
 
+#include "data/batch_query_request_parser.h"
 #include "data/document_parser.h"
 #include "data/feature_space_manager.h"
 #include "data/query_request_parser.h"
+#include "handler/batch_query_handler.h"
 #include "handler/document_handler.h"
 #include "handler/query_handler.h"
 #include "handler/snapshot_handler.h"
+#include "handler/stats_handler.h"
 #include "handler/test_handler.h"
 #include "index/document_index_manager.h"
 #include "index/document_index_view.h"
 #include "index/document_update_pipeline.h"
+#include "query/query_cache.h"
+#include "query/query_coalescer.h"
+#include "query/query_pipeline.h"
 #include "query/simple_query_executor.h"
 #include "ranking/direct_model.h"
 #include "ranking/feature_mapping_model.h"
@@ -26,10 +33,12 @@
 #include "service/server.h"
 #include "third_party/rapidjson/document.h"
 #include "third_party/rapidjson/filereadstream.h"
+#include "utils/concurrency/task_pool.h"
 #include "utils/json_utils.h"
 #include "utils/logger.h"
 #include "utils/logger-inl.h"
 #include "utils/scope_guard.h"
+#include "utils/stats.h"
 
 using std::string;
 
@@ -43,6 +52,7 @@ static const unsigned int kConfigParseFlags =
 static const char kConfigKeyLoggerConfig    [] = "logger_config";
 static const char kConfigKeyFeatureSpaces   [] = "feature_spaces";
 static const char kConfigKeyIndex           [] = "index";
+static const char kConfigKeyQuery           [] = "query";
 static const char kConfigKeyRanking         [] = "ranking";
 static const char kConfigKeyServer          [] = "server";
 
@@ -110,6 +120,9 @@ static int server_main(const rapidjson::Value& config) {
   signal(SIGTERM, exit_on_signal);
   signal(SIGINT, exit_on_signal);
 
+  // counters reported by the /stats endpoint
+  Stats stats;
+
   /*
    * Initialization:
    * Features initialization
@@ -176,12 +189,63 @@ static int server_main(const rapidjson::Value& config) {
     LOG_DEBUG(logger, "index snapshot prefix not configured, use default: %s", snapshot_prefix.c_str());
   }
 
+  // posting list type of the features in spaces without their own
+  std::string default_list = DocumentIndexManager::kBTreeList;
+  if (config_index && json_try_get_value(*config_index, "posting_list", default_list)) {
+    LOG_DEBUG(logger, "index posting list: %s", default_list.c_str());
+  } else {
+    LOG_DEBUG(logger, "index posting list not configured, use default: %s", default_list.c_str());
+  }
+  if (!DocumentIndexManager::create_list_factory(default_list) || default_list == DocumentIndexManager::kPriorList) {
+    LOG_ERROR(logger, "index posting list %s is not a valid posting list type!", default_list.c_str());
+    return -1;
+  }
+
+  // posting list types of the spaces, configured in the feature spaces
+  DocumentIndexManager::SpaceLists space_lists;
+  for (const auto& space: feature_spaces->get_spaces()) {
+    if (space->get_posting_list().empty()) {
+      continue;
+    }
+    if (!DocumentIndexManager::create_list_factory(space->get_posting_list())) {
+      LOG_ERROR(logger, "posting list %s of space %s is not a valid posting list type!",
+          space->get_posting_list().c_str(), space->get_name().c_str());
+      return -1;
+    }
+    space_lists[space->get_id()] = space->get_posting_list();
+    LOG_DEBUG(logger, "index posting list of space %s: %s", space->get_name().c_str(),
+        space->get_posting_list().c_str());
+  }
+
+  // posting lists of the features in these spaces are split into tiers by weights,
+  // the same as the tiered posting list type of the spaces.
+  const rapidjson::Value* config_tiered_spaces = json_get_array(*config_index, "tiered_spaces");
+  if (config_tiered_spaces) {
+    for (auto it = config_tiered_spaces->Begin(); it != config_tiered_spaces->End(); ++it) {
+      std::shared_ptr<FeatureSpace> space = it->IsString() ? feature_spaces->get_space(it->GetString()) : nullptr;
+      if (!space) {
+        LOG_ERROR(logger, "tiered space is not a valid feature space!");
+        return -1;
+      }
+      space_lists[space->get_id()] = DocumentIndexManager::kTieredList;
+      LOG_DEBUG(logger, "index tiered space: %s", space->get_name().c_str());
+    }
+  }
+
+  // posting lists of a few postings are stored inline once changed
+  bool small_lists = false;
+  if (config_index && json_try_get_value(*config_index, "small_lists", small_lists)) {
+    LOG_DEBUG(logger, "index small lists: %d", (int)small_lists);
+  } else {
+    LOG_DEBUG(logger, "index small lists not configured, use default: %d", (int)small_lists);
+  }
+
   std::unique_ptr<DocumentIndexManager> index;
   if (restore_on_startup) {
     LOG_INFO(logger, "loading index from snapshot %s", snapshot_prefix.c_str());
     try {
       index.reset(new DocumentIndexManager(
-          index_initial_buckets, index_max_size, snapshot_prefix));
+          index_initial_buckets, index_max_size, snapshot_prefix, space_lists, default_list, small_lists));
     } catch (std::ios_base::failure& e) {
       LOG_ERROR(logger, "failed restore index. reason:%s", e.what());
       // continue
@@ -191,7 +255,7 @@ static int server_main(const rapidjson::Value& config) {
   if (!index) {
     LOG_INFO(logger, "creating an empty index ...");
     index.reset(new DocumentIndexManager(
-        index_initial_buckets, index_max_size));
+        index_initial_buckets, index_max_size, space_lists, default_list, small_lists));
   }
 
   index->start_maintain(index_maintain_interval, index_maintain_interval);
@@ -212,6 +276,7 @@ static int server_main(const rapidjson::Value& config) {
   unsigned int document_update_thread_num = 4;
   unsigned int document_update_queue_size = 2048;
   unsigned int default_ttl = 86400;
+  bool document_update_async_parse = true;
 
   if (config_index && json_try_get_value(*config_index, "update_thread_num", document_update_thread_num)) {
     LOG_DEBUG(logger, "feed document pipeline thread num: %u", document_update_thread_num);
@@ -228,12 +293,24 @@ static int server_main(const rapidjson::Value& config) {
   } else {
     LOG_DEBUG(logger, "document update default ttl not configured, use default: %u", default_ttl);
   }
+  if (config_index && json_try_get_value(*config_index, "update_async_parse", document_update_async_parse)) {
+    LOG_DEBUG(logger, "document update async parse: %s", document_update_async_parse ? "true" : "false");
+  } else {
+    LOG_DEBUG(logger, "document update async parse not configured, use default: %s", document_update_async_parse ? "true" : "false");
+  }
 
-  DocumentUpdatePipeline document_update_pipeline(document_update_thread_num, document_update_queue_size, index.get());
+  // shared by the document handlers and the update workers.
+  std::shared_ptr<DocumentParserFactory> document_parser_factory =
+      std::make_shared<DocumentParserFactory>(feature_spaces);
+
+  DocumentUpdatePipeline document_update_pipeline(document_update_thread_num, document_update_queue_size,
+      index.get(), document_parser_factory, &stats);
   document_update_pipeline.start();
   ScopeGuard document_update_pipeline_guard([&document_update_pipeline] {
     LOG_INFO(logger, "feed document pipeline stopping...");
     document_update_pipeline.stop();
+    LOG_INFO(logger, "feed document pipeline stopped, %zu documents dropped for parse errors.",
+        document_update_pipeline.get_parse_error_count());
   });
 
   DocumentIndexView index_view(index.get(), &document_update_pipeline);
@@ -258,6 +335,111 @@ static int server_main(const rapidjson::Value& config) {
     return -1;
   }
 
+  /*
+   * Initialization:
+   * Query executor pool
+   */
+  unsigned int query_thread_num = 4;
+  unsigned int query_queue_size = 1024;
+  unsigned int query_cache_size = 0;
+  unsigned int query_cache_shards = 16;
+  bool query_coalesce = true;
+  unsigned int query_timeout_us = 0;
+  unsigned int query_taat_max_postings = QueryPlanner::kDefaultTaatMaxPostings;
+  unsigned int query_parallel_thread_num = 0;
+  unsigned int query_parallel_min_postings = 1048576;
+  unsigned int query_parallel_partitions = QueryPlanner::kDefaultParallelPartitions;
+
+  const rapidjson::Value* config_query = json_get_object(config, kConfigKeyQuery);
+  if (config_query && json_try_get_value(*config_query, "thread_num", query_thread_num)) {
+    LOG_DEBUG(logger, "query thread num: %u", query_thread_num);
+  } else {
+    LOG_DEBUG(logger, "query thread num not configured, use default: %u", query_thread_num);
+  }
+  if (config_query && json_try_get_value(*config_query, "queue_size", query_queue_size)) {
+    LOG_DEBUG(logger, "query queue size: %u", query_queue_size);
+  } else {
+    LOG_DEBUG(logger, "query queue size not configured, use default: %u", query_queue_size);
+  }
+  if (config_query && json_try_get_value(*config_query, "cache_size", query_cache_size)) {
+    LOG_DEBUG(logger, "query cache size: %u", query_cache_size);
+  } else {
+    LOG_DEBUG(logger, "query cache size not configured, use default: %u", query_cache_size);
+  }
+  if (config_query && json_try_get_value(*config_query, "cache_shards", query_cache_shards)) {
+    LOG_DEBUG(logger, "query cache shards: %u", query_cache_shards);
+  } else {
+    LOG_DEBUG(logger, "query cache shards not configured, use default: %u", query_cache_shards);
+  }
+  if (config_query && json_try_get_value(*config_query, "coalesce", query_coalesce)) {
+    LOG_DEBUG(logger, "query coalesce: %s", query_coalesce ? "true" : "false");
+  } else {
+    LOG_DEBUG(logger, "query coalesce not configured, use default: %s", query_coalesce ? "true" : "false");
+  }
+  if (config_query && json_try_get_value(*config_query, "timeout_us", query_timeout_us)) {
+    LOG_DEBUG(logger, "query timeout: %uus", query_timeout_us);
+  } else {
+    LOG_DEBUG(logger, "query timeout not configured, use default: %uus", query_timeout_us);
+  }
+  if (config_query && json_try_get_value(*config_query, "taat_max_postings", query_taat_max_postings)) {
+    LOG_DEBUG(logger, "query taat max postings: %u", query_taat_max_postings);
+  } else {
+    LOG_DEBUG(logger, "query taat max postings not configured, use default: %u", query_taat_max_postings);
+  }
+  if (config_query && json_try_get_value(*config_query, "parallel_thread_num", query_parallel_thread_num)) {
+    LOG_DEBUG(logger, "query parallel thread num: %u", query_parallel_thread_num);
+  } else {
+    LOG_DEBUG(logger, "query parallel thread num not configured, use default: %u", query_parallel_thread_num);
+  }
+  if (config_query && json_try_get_value(*config_query, "parallel_min_postings", query_parallel_min_postings)) {
+    LOG_DEBUG(logger, "query parallel min postings: %u", query_parallel_min_postings);
+  } else {
+    LOG_DEBUG(logger, "query parallel min postings not configured, use default: %u", query_parallel_min_postings);
+  }
+  if (config_query && json_try_get_value(*config_query, "parallel_partitions", query_parallel_partitions)) {
+    LOG_DEBUG(logger, "query parallel partitions: %u", query_parallel_partitions);
+  } else {
+    LOG_DEBUG(logger, "query parallel partitions not configured, use default: %u", query_parallel_partitions);
+  }
+
+  // no parallel threads: every query is read by a single thread.
+  std::unique_ptr<TaskPool> query_parallel_pool;
+  if (query_parallel_thread_num > 0) {
+    query_parallel_pool.reset(new TaskPool(query_parallel_thread_num));
+    query_parallel_pool->start();
+  } else {
+    query_parallel_min_postings = 0;
+  }
+  index->set_planner(QueryPlanner(query_taat_max_postings, query_parallel_min_postings, query_parallel_partitions));
+
+  // no cache size: query results are not cached.
+  std::unique_ptr<QueryCache> query_cache;
+  if (query_cache_size > 0) {
+    query_cache.reset(new QueryCache(query_cache_size, query_cache_shards, &stats));
+  }
+
+  std::unique_ptr<QueryCoalescer> query_coalescer;
+  if (query_coalesce) {
+    query_coalescer.reset(new QueryCoalescer(query_cache_shards, &stats));
+  }
+
+  std::shared_ptr<QueryExecutorFactory> query_executor_factory =
+      std::make_shared<SimpleQueryExecutorFactory>(index.get(), model.get(), query_cache.get(),
+          query_coalescer.get(), &stats, query_timeout_us, query_parallel_pool.get());
+
+  // no query threads: queries are executed in the server threads.
+  std::unique_ptr<QueryPipeline> query_pipeline;
+  if (query_thread_num > 0) {
+    query_pipeline.reset(new QueryPipeline(query_thread_num, query_queue_size, query_executor_factory));
+    query_pipeline->start();
+  }
+  ScopeGuard query_pipeline_guard([&query_pipeline] {
+    if (query_pipeline) {
+      LOG_INFO(logger, "query pipeline stopping...");
+      query_pipeline->stop();
+    }
+  });
+
   /*
    * Initialization:
    * Server initialization
@@ -266,6 +448,8 @@ static int server_main(const rapidjson::Value& config) {
   int server_port = 19980;
   uint server_thread_num = 4;
   uint max_req_per_thread = 0;
+  bool server_reuse_port = false;
+  bool server_pin_threads = false;
 
   const rapidjson::Value* config_server = json_get_object(config, kConfigKeyServer);
   if (config_server && json_try_get_value(*config_server, "port", server_port)) {
@@ -283,16 +467,32 @@ static int server_main(const rapidjson::Value& config) {
   } else {
     LOG_DEBUG(logger, "max requests per server thread not configured, use default: %u", max_req_per_thread);
   }
+  if (config_server && json_try_get_value(*config_server, "reuse_port", server_reuse_port)) {
+    LOG_DEBUG(logger, "server reuse port: %s", server_reuse_port ? "true" : "false");
+  } else {
+    LOG_DEBUG(logger, "server reuse port not configured, use default: %s", server_reuse_port ? "true" : "false");
+  }
+  if (config_server && json_try_get_value(*config_server, "pin_threads", server_pin_threads)) {
+    LOG_DEBUG(logger, "server pin threads: %s", server_pin_threads ? "true" : "false");
+  } else {
+    LOG_DEBUG(logger, "server pin threads not configured, use default: %s", server_pin_threads ? "true" : "false");
+  }
 
-  Server server(server_port, server_thread_num, max_req_per_thread);
+  Server server(server_port, server_thread_num, max_req_per_thread, server_reuse_port, server_pin_threads);
   server.bind("/test", std::make_shared<TestHandlerFactory>());
   server.bind("/document", std::make_shared<FeedDocumentHandlerFactory>(
-      std::make_shared<DocumentParserFactory>(feature_spaces),
-      &index_view, default_ttl));
+      document_parser_factory, &index_view, default_ttl, document_update_async_parse));
   server.bind("/query", std::make_shared<QueryHandlerFactory>(
       std::make_shared<QueryRequestParserFactory>(feature_spaces),
-      std::make_shared<SimpleQueryExecutorFactory>(index.get(), model.get())));
+      query_executor_factory, query_pipeline.get()));
+  server.bind("/query/batch", std::make_shared<BatchQueryHandlerFactory>(
+      std::make_shared<BatchQueryRequestParserFactory>(feature_spaces),
+      query_executor_factory, query_pipeline.get()));
+  server.bind("/query/bulk", std::make_shared<BatchQueryHandlerFactory>(
+      std::make_shared<BatchQueryRequestParserFactory>(feature_spaces, BatchQueryRequestParser::kMaxBulkQueries),
+      query_executor_factory, query_pipeline.get(), true));
   server.bind("/snapshot", std::make_shared<SnapshotHandlerFactory>(&index_view, snapshot_prefix));
+  server.bind("/stats", std::make_shared<StatsHandlerFactory>(&stats));
 
   if (server.initialize() < 0) {
     LOG_ERROR(logger, "server initialization failed!");
@@ -0,0 +1,109 @@
+#include "query/query_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace redgiant {
+
+const int QueryCache::Key::kWeightBits;
+
+static inline uint64_t mix_hash(uint64_t h, uint64_t v) {
+  // splitmix64 finalizer applied to the combined value
+  uint64_t x = h ^ (v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+QueryCache::Key::Key(const IntermQuery& query, size_t query_count)
+: features_(query.get_features()), query_count_(query_count) {
+  std::sort(features_.begin(), features_.end());
+  hash_ = mix_hash(0, query_count_);
+  for (auto& feature: features_) {
+    // keep kWeightBits of the mantissa, so that nearly identical weights share the entry.
+    int exp = 0;
+    double mantissa = std::frexp(feature.second, &exp);
+    feature.second = std::ldexp(std::round(std::ldexp(mantissa, kWeightBits)), exp - kWeightBits);
+
+    uint64_t weight_bits = 0;
+    std::memcpy(&weight_bits, &feature.second, sizeof(weight_bits));
+    hash_ = mix_hash(hash_, (uint64_t)feature.first);
+    hash_ = mix_hash(hash_, weight_bits);
+  }
+}
+
+QueryCache::QueryCache(size_t capacity, size_t shard_num, Stats* stats)
+: hit_count_(nullptr), miss_count_(nullptr), stale_count_(nullptr), evict_count_(nullptr) {
+  if (shard_num == 0) {
+    shard_num = 1;
+  }
+  shard_capacity_ = std::max<size_t>(1, (capacity + shard_num - 1) / shard_num);
+  shards_.reserve(shard_num);
+  for (size_t i = 0; i < shard_num; ++i) {
+    shards_.emplace_back(new Shard());
+  }
+  if (stats) {
+    hit_count_ = stats->get_counter("query_cache.hit");
+    miss_count_ = stats->get_counter("query_cache.miss");
+    stale_count_ = stats->get_counter("query_cache.stale");
+    evict_count_ = stats->get_counter("query_cache.evict");
+  }
+}
+
+std::shared_ptr<const QueryCache::Results> QueryCache::get(const Key& key, uint64_t generation) {
+  Shard& shard = get_shard(key.get_hash());
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto iter = shard.map.find(key.get_hash());
+  if (iter == shard.map.end() || !(iter->second->key == key)) {
+    Stats::increase(miss_count_);
+    return nullptr;
+  }
+  if (iter->second->generation != generation) {
+    // the index has changed since computed
+    shard.entries.erase(iter->second);
+    shard.map.erase(iter);
+    Stats::increase(stale_count_);
+    Stats::increase(miss_count_);
+    return nullptr;
+  }
+  // move to front
+  shard.entries.splice(shard.entries.begin(), shard.entries, iter->second);
+  Stats::increase(hit_count_);
+  return iter->second->results;
+}
+
+void QueryCache::put(Key key, uint64_t generation, std::shared_ptr<const Results> results) {
+  uint64_t hash = key.get_hash();
+  Shard& shard = get_shard(hash);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto iter = shard.map.find(hash);
+  if (iter != shard.map.end()) {
+    // replace the entry, which may be from another query with the same hash
+    Entry& entry = *iter->second;
+    entry.key = std::move(key);
+    entry.generation = generation;
+    entry.results = std::move(results);
+    shard.entries.splice(shard.entries.begin(), shard.entries, iter->second);
+    return;
+  }
+
+  shard.entries.push_front(Entry { std::move(key), generation, std::move(results) });
+  shard.map.emplace(hash, shard.entries.begin());
+  while (shard.entries.size() > shard_capacity_) {
+    shard.map.erase(shard.entries.back().key.get_hash());
+    shard.entries.pop_back();
+    Stats::increase(evict_count_);
+  }
+}
+
+size_t QueryCache::size() const {
+  size_t size = 0;
+  for (const auto& shard: shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    size += shard->entries.size();
+  }
+  return size;
+}
+
+} /* namespace redgiant */
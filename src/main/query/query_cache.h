@@ -0,0 +1,94 @@
+#ifndef SRC_MAIN_QUERY_QUERY_CACHE_H_
+#define SRC_MAIN_QUERY_QUERY_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "data/interm_query.h"
+#include "data/query_result.h"
+#include "utils/stats.h"
+
+namespace redgiant {
+/*
+ * A sharded LRU cache of query results.
+ * Queries are identified by the features built by the ranking models, so that
+ * the same profile queried with the same model hits the same entry.
+ * Each entry is tagged with the index generation it is computed from, and is
+ * treated as missing once changes are applied to the index.
+ */
+class QueryCache {
+public:
+  typedef IntermQuery::FeatureId FeatureId;
+  typedef IntermQuery::QueryWeight QueryWeight;
+  typedef QueryResult::KeyScores Results;
+
+  /*
+   * The normalized query: features sorted by id, with the weights rounded
+   * to kWeightBits significant bits, and the number of results requested.
+   */
+  class Key {
+  public:
+    static const int kWeightBits = 16;
+
+    Key() = default;
+    Key(const IntermQuery& query, size_t query_count);
+
+    uint64_t get_hash() const {
+      return hash_;
+    }
+
+    bool operator== (const Key& other) const {
+      return hash_ == other.hash_ && query_count_ == other.query_count_ && features_ == other.features_;
+    }
+
+  private:
+    std::vector<std::pair<FeatureId, QueryWeight>> features_;
+    size_t query_count_ = 0;
+    uint64_t hash_ = 0;
+  };
+
+  // capacity is the maximum number of entries in all shards.
+  QueryCache(size_t capacity, size_t shard_num = 16, Stats* stats = nullptr);
+  ~QueryCache() = default;
+
+  // returns nullptr if not found, or computed from an older generation of the index.
+  std::shared_ptr<const Results> get(const Key& key, uint64_t generation);
+
+  void put(Key key, uint64_t generation, std::shared_ptr<const Results> results);
+
+  size_t size() const;
+
+private:
+  struct Entry {
+    Key key;
+    uint64_t generation;
+    std::shared_ptr<const Results> results;
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    // most recently used at front
+    std::list<Entry> entries;
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> map;
+  };
+
+  Shard& get_shard(uint64_t hash) {
+    // the low bits are used by the hash map of the shard
+    return *shards_[(hash >> 32) % shards_.size()];
+  }
+
+  size_t shard_capacity_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  Stats::Counter* hit_count_;
+  Stats::Counter* miss_count_;
+  Stats::Counter* stale_count_;
+  Stats::Counter* evict_count_;
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_QUERY_QUERY_CACHE_H_ */
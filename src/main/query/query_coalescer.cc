@@ -0,0 +1,87 @@
+#include "query/query_coalescer.h"
+
+#include <chrono>
+#include <utility>
+
+#include "utils/scope_guard.h"
+
+namespace redgiant {
+
+QueryCoalescer::QueryCoalescer(size_t shard_num, Stats* stats)
+: shared_count_(nullptr), wait_timeout_count_(nullptr) {
+  if (shard_num == 0) {
+    shard_num = 1;
+  }
+  shards_.reserve(shard_num);
+  for (size_t i = 0; i < shard_num; ++i) {
+    shards_.emplace_back(new Shard());
+  }
+  if (stats) {
+    shared_count_ = stats->get_counter("query_coalescer.shared");
+    wait_timeout_count_ = stats->get_counter("query_coalescer.wait_timeout");
+  }
+}
+
+std::shared_ptr<const QueryCoalescer::Results> QueryCoalescer::execute(const Key& key, uint64_t generation,
+    const Search& search, bool* leader, long wait_us) {
+  uint64_t hash = key.get_hash();
+  Shard& shard = get_shard(hash);
+  std::shared_ptr<Flight> flight;
+  {
+    std::unique_lock<std::mutex> lock(shard.mutex);
+    auto iter = shard.flights.find(hash);
+    if (iter == shard.flights.end()) {
+      flight = std::make_shared<Flight>(key, generation);
+      shard.flights.emplace(hash, flight);
+    } else if (iter->second->generation == generation && iter->second->key == key) {
+      // wait for the one in flight
+      std::shared_ptr<Flight> other = iter->second;
+      auto done = [&other] { return other->done; };
+      bool shared = true;
+      if (wait_us > 0) {
+        shared = shard.cond.wait_for(lock, std::chrono::microseconds(wait_us), done);
+      } else {
+        shard.cond.wait(lock, done);
+      }
+      if (shared) {
+        if (leader) {
+          *leader = false;
+        }
+        Stats::increase(shared_count_);
+        return other->results;
+      }
+      Stats::increase(wait_timeout_count_);
+    }
+    // otherwise a different query with the same hash is in flight, or the one in flight takes too long,
+    // execute without sharing.
+  }
+
+  if (leader) {
+    *leader = true;
+  }
+  if (!flight) {
+    return search();
+  }
+
+  // waiters are always woken up, even if search throws.
+  // the results are published by the mutex when the flight is done.
+  ScopeGuard done_guard([&] {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    flight->done = true;
+    shard.flights.erase(hash);
+    shard.cond.notify_all();
+  });
+  flight->results = search();
+  return flight->results;
+}
+
+size_t QueryCoalescer::size() const {
+  size_t size = 0;
+  for (const auto& shard: shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    size += shard->flights.size();
+  }
+  return size;
+}
+
+} /* namespace redgiant */
@@ -0,0 +1,69 @@
+#ifndef SRC_MAIN_QUERY_QUERY_COALESCER_H_
+#define SRC_MAIN_QUERY_QUERY_COALESCER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "query/query_cache.h"
+#include "utils/stats.h"
+
+namespace redgiant {
+/*
+ * Single-flight execution of identical queries.
+ * While a query is being executed, identical queries on the same index
+ * generation wait for it and share its results instead of executing again.
+ */
+class QueryCoalescer {
+public:
+  typedef QueryCache::Key Key;
+  typedef QueryCache::Results Results;
+  typedef std::function<std::shared_ptr<const Results> ()> Search;
+
+  QueryCoalescer(size_t shard_num = 16, Stats* stats = nullptr);
+  ~QueryCoalescer() = default;
+
+  // executes search if no identical query is in flight, otherwise waits for its results.
+  // if they are not done in wait_us (0 for no limit), search is executed by this call without sharing.
+  // leader is set to whether search is executed by this call.
+  // returns nullptr if the query in flight failed.
+  std::shared_ptr<const Results> execute(const Key& key, uint64_t generation, const Search& search,
+      bool* leader = nullptr, long wait_us = 0);
+
+  // number of queries in flight
+  size_t size() const;
+
+private:
+  struct Flight {
+    Flight(const Key& key, uint64_t generation)
+    : key(key), generation(generation), done(false) {
+    }
+
+    const Key key;
+    const uint64_t generation;
+    // protected by the mutex of the shard
+    bool done;
+    std::shared_ptr<const Results> results;
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+    std::unordered_map<uint64_t, std::shared_ptr<Flight>> flights;
+  };
+
+  Shard& get_shard(uint64_t hash) {
+    return *shards_[(hash >> 32) % shards_.size()];
+  }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  Stats::Counter* shared_count_;
+  Stats::Counter* wait_timeout_count_;
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_QUERY_QUERY_COALESCER_H_ */
@@ -4,10 +4,12 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
+
+#include "data/query_request.h"
+#include "data/query_result.h"
 
 namespace redgiant {
-class QueryRequest;
-class QueryResult;
 
 class QueryExecutor {
 public:
@@ -15,6 +17,16 @@ public:
   virtual ~QueryExecutor() = default;
 
   virtual std::unique_ptr<QueryResult> execute(const QueryRequest& request) = 0;
+
+  // execute a batch of queries and return the results in the same order, one by one by default.
+  virtual std::vector<std::unique_ptr<QueryResult>> execute_batch(const std::vector<QueryRequest>& requests) {
+    std::vector<std::unique_ptr<QueryResult>> results;
+    results.reserve(requests.size());
+    for (const auto& request: requests) {
+      results.push_back(execute(request));
+    }
+    return results;
+  }
 };
 
 class QueryExecutorFactory {
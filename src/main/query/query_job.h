@@ -0,0 +1,61 @@
+#ifndef SRC_MAIN_QUERY_QUERY_JOB_H_
+#define SRC_MAIN_QUERY_QUERY_JOB_H_
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "data/query_request.h"
+#include "data/query_result.h"
+
+namespace redgiant {
+/*
+ * A parsed query to be executed by the query workers.
+ * The callback is invoked in the worker thread with the result, which may be null on errors.
+ * A batch job holds a batch of queries executed together by one worker, see QueryExecutor::execute_batch(),
+ * and the batch callback is invoked with the results of all the queries instead.
+ */
+class QueryJob {
+public:
+  typedef std::function<void (const QueryRequest& request, std::unique_ptr<QueryResult> result)> Callback;
+  typedef std::function<void (std::vector<std::unique_ptr<QueryResult>> results)> BatchCallback;
+
+  QueryJob(QueryRequest request, Callback callback)
+  : callback_(std::move(callback)) {
+    requests_.push_back(std::move(request));
+  }
+
+  QueryJob(std::vector<QueryRequest> requests, BatchCallback callback)
+  : requests_(std::move(requests)), batch_callback_(std::move(callback)) {
+  }
+
+  bool is_batch() const {
+    return !!batch_callback_;
+  }
+
+  // the query of a single job.
+  const QueryRequest& get_request() const {
+    return requests_.front();
+  }
+
+  const std::vector<QueryRequest>& get_requests() const {
+    return requests_;
+  }
+
+  void done(std::unique_ptr<QueryResult> result) {
+    callback_(requests_.front(), std::move(result));
+  }
+
+  void done_batch(std::vector<std::unique_ptr<QueryResult>> results) {
+    batch_callback_(std::move(results));
+  }
+
+private:
+  std::vector<QueryRequest> requests_;
+  Callback callback_;
+  BatchCallback batch_callback_;
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_QUERY_QUERY_JOB_H_ */
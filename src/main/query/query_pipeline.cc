@@ -0,0 +1,42 @@
+#include "query/query_pipeline.h"
+
+#include <memory>
+#include <utility>
+
+#include "query/query_job.h"
+#include "query/query_worker.h"
+#include "utils/logger.h"
+
+namespace redgiant {
+
+DECLARE_LOGGER(logger, __FILE__);
+
+QueryPipeline::QueryPipeline(size_t thread_num, size_t queue_size,
+    std::shared_ptr<QueryExecutorFactory> executor_factory) {
+  query_ = std::make_shared<WorkerExecutor<QueryJob, QueryWorker>>(
+      std::make_shared<QueryWorkerFactory>(std::move(executor_factory)),
+      thread_num, queue_size);
+}
+
+void QueryPipeline::start() {
+  query_->start();
+}
+
+void QueryPipeline::stop() {
+  query_->stop();
+}
+
+void QueryPipeline::schedule(std::shared_ptr<QueryJob> job) {
+  query_->schedule(std::move(job));
+  LOG_TRACE(logger, "query job pushed, queue size: %zu", query_->get_queue_size());
+}
+
+bool QueryPipeline::try_schedule(std::shared_ptr<QueryJob> job) {
+  if (!query_->try_schedule(std::move(job))) {
+    LOG_TRACE(logger, "query queue full, job rejected.");
+    return false;
+  }
+  return true;
+}
+
+} /* namespace redgiant */
@@ -0,0 +1,34 @@
+#ifndef SRC_MAIN_QUERY_QUERY_PIPELINE_H_
+#define SRC_MAIN_QUERY_QUERY_PIPELINE_H_
+
+#include <memory>
+
+#include "utils/concurrency/job_executor.h"
+#include "utils/concurrency/worker_executor.h"
+
+namespace redgiant {
+class QueryExecutorFactory;
+class QueryJob;
+class QueryWorker;
+
+/*
+ * Executes queries in a pool of worker threads, separated from the network threads,
+ * so that a slow query does not block the other requests of the same event loop.
+ */
+class QueryPipeline: public JobExecutor<QueryJob> {
+public:
+  QueryPipeline(size_t thread_num, size_t queue_size,
+      std::shared_ptr<QueryExecutorFactory> executor_factory);
+  virtual ~QueryPipeline() = default;
+
+  virtual void start();
+  virtual void stop();
+  virtual void schedule(std::shared_ptr<QueryJob> job);
+  virtual bool try_schedule(std::shared_ptr<QueryJob> job);
+
+private:
+  std::shared_ptr<WorkerExecutor<QueryJob, QueryWorker>> query_;
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_QUERY_QUERY_PIPELINE_H_ */
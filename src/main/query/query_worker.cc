@@ -0,0 +1,32 @@
+#include "query/query_worker.h"
+
+#include <memory>
+#include <utility>
+
+#include "data/query_request.h"
+#include "data/query_result.h"
+#include "utils/logger.h"
+
+namespace redgiant {
+
+DECLARE_LOGGER(logger, __FILE__);
+
+void QueryWorker::prepare() {
+  LOG_DEBUG(logger, "query worker started.");
+}
+
+void QueryWorker::cleanup() {
+}
+
+void QueryWorker::execute(QueryJob& job) {
+  if (job.is_batch()) {
+    LOG_TRACE(logger, "query worker received batch job of %zu queries", job.get_requests().size());
+    job.done_batch(executor_->execute_batch(job.get_requests()));
+    return;
+  }
+  LOG_TRACE(logger, "[query:%s] query worker received job, queued for %ldus",
+      job.get_request().get_request_id().c_str(), job.get_request().get_watch().get_ticks_us());
+  job.done(executor_->execute(job.get_request()));
+}
+
+} /* namespace redgiant */
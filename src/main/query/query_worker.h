@@ -0,0 +1,46 @@
+#ifndef SRC_MAIN_QUERY_QUERY_WORKER_H_
+#define SRC_MAIN_QUERY_QUERY_WORKER_H_
+
+#include <memory>
+#include <utility>
+
+#include "query/query_executor.h"
+#include "query/query_job.h"
+#include "utils/concurrency/worker.h"
+
+namespace redgiant {
+class QueryWorker: public Worker<QueryJob> {
+public:
+  QueryWorker(std::unique_ptr<QueryExecutor> executor)
+  : executor_(std::move(executor)) {
+  }
+
+  virtual ~QueryWorker() = default;
+
+  virtual void prepare();
+  virtual void cleanup();
+  virtual void execute(QueryJob& job);
+
+private:
+  // one executor per worker thread
+  std::unique_ptr<QueryExecutor> executor_;
+};
+
+class QueryWorkerFactory: public WorkerFactory<QueryWorker> {
+public:
+  QueryWorkerFactory(std::shared_ptr<QueryExecutorFactory> executor_factory)
+  : executor_factory_(std::move(executor_factory)) {
+  }
+
+  virtual ~QueryWorkerFactory() = default;
+
+  virtual std::unique_ptr<QueryWorker> create() {
+    return std::unique_ptr<QueryWorker>(new QueryWorker(executor_factory_->create_executor()));
+  }
+
+private:
+  std::shared_ptr<QueryExecutorFactory> executor_factory_;
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_QUERY_QUERY_WORKER_H_ */
@@ -1,11 +1,21 @@
 #include "query/simple_query_executor.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
 #include "core/reader/reader_utils.h"
 #include "data/interm_query.h"
 #include "data/query_request.h"
 #include "data/query_result.h"
 #include "index/document_index_manager.h"
+#include "query/query_cache.h"
+#include "query/query_coalescer.h"
+#include "utils/concurrency/task_pool.h"
 #include "utils/logger.h"
+#include "utils/stop_watch.h"
 
 namespace redgiant {
 
@@ -33,24 +43,215 @@ std::unique_ptr<QueryResult> SimpleQueryExecutor::execute(const QueryRequest& re
   }
   result->track_latency(QueryResult::kLoadModel);
 
-  DocumentQuery query(request, *interm_query);
-  result->track_latency(QueryResult::kBuildQuery);
-  result->track_latency(QueryResult::kQueryStart);
+  // identical queries share the results, except for debug requests which log the details,
+  // and requests with min_score whose results may be truncated.
+  // the generation is read before querying: if the index changes meanwhile,
+  // the results are tagged with the older generation and never hit.
+  if ((!cache_ && !coalescer_) || request.is_debug() || request.get_min_score() > 0) {
+    search(request, *interm_query, *result);
+    result->track_latency(QueryResult::kFinalize);
+    return result;
+  }
+
+  uint64_t generation = index_->get_generation();
+  QueryCache::Key key(*interm_query, request.get_query_count());
+  if (cache_) {
+    std::shared_ptr<const QueryCache::Results> cached = cache_->get(key, generation);
+    if (cached) {
+      result->get_results() = *cached;
+      result->track_latency(QueryResult::kFinalize);
+      return result;
+    }
+  }
 
-  // execute document query
-  std::unique_ptr<DocumentIndexManager::Reader> results_reader = index_->query(request, query);
+  // partial results are neither shared nor cached
+  auto search_shared = [&] () {
+    search(request, *interm_query, *result);
+    return result->is_partial() ? nullptr
+        : std::make_shared<const QueryCache::Results>(result->get_results());
+  };
+
+  std::shared_ptr<const QueryCache::Results> results;
+  if (coalescer_) {
+    // wait for the identical query in flight no longer than the budget left, then search with the rest of it,
+    // which is truncated at once if nothing is left.
+    long timeout_us = request.get_timeout_us() > 0 ? request.get_timeout_us() : default_timeout_us_;
+    long wait_us = timeout_us > 0 ? std::max(timeout_us - request.get_watch().get_ticks_us(), 1L) : 0;
+    bool leader = false;
+    results = coalescer_->execute(key, generation, search_shared, &leader, wait_us);
+    if (!leader) {
+      if (results) {
+        result->get_results() = *results;
+      } else {
+        // the query in flight failed or was truncated, search again
+        search(request, *interm_query, *result);
+      }
+      result->track_latency(QueryResult::kFinalize);
+      return result;
+    }
+  } else {
+    results = search_shared();
+  }
+
+  if (cache_ && results) {
+    cache_->put(std::move(key), generation, std::move(results));
+  }
+  result->track_latency(QueryResult::kFinalize);
+  return result;
+}
+
+std::vector<std::unique_ptr<QueryResult>> SimpleQueryExecutor::execute_batch(
+    const std::vector<QueryRequest>& requests) {
+  std::vector<std::unique_ptr<QueryResult>> results;
+  if (requests.empty()) {
+    return results;
+  }
+  results.reserve(requests.size());
+  std::vector<std::unique_ptr<IntermQuery>> interm_queries;
+  interm_queries.reserve(requests.size());
+  std::vector<const IntermQuery*> queries;
+  queries.reserve(requests.size());
+  std::vector<size_t> counts;
+  counts.reserve(requests.size());
+  std::vector<DocumentIndexManager::Score> min_scores;
+  min_scores.reserve(requests.size());
+  for (const auto& request: requests) {
+    results.push_back(request.create_result());
+    results.back()->track_latency(QueryResult::kStart);
+    interm_queries.push_back(model_->process(request));
+    if (!interm_queries.back()) {
+      if (request.is_debug()) {
+        LOG_INFO(logger, "[query:%s] ranking model not found!", request.get_request_id().c_str());
+      }
+      results.back()->set_error_status(true);
+    }
+    results.back()->track_latency(QueryResult::kLoadModel);
+    queries.push_back(interm_queries.back().get());
+    counts.push_back(request.get_query_count());
+    min_scores.push_back(request.get_min_score());
+  }
+
+  // the queries are read together, so the batch is stopped when the least budget left runs out.
+  long timeout_us = 0;
+  for (const auto& request: requests) {
+    long request_timeout_us = request.get_timeout_us() > 0 ? request.get_timeout_us() : default_timeout_us_;
+    if (request_timeout_us > 0) {
+      long left_us = std::max(request_timeout_us - request.get_watch().get_ticks_us(), 1L);
+      if (timeout_us == 0 || left_us < timeout_us) {
+        timeout_us = left_us;
+      }
+    }
+  }
+  StopWatch watch;
+  bool truncated = false;
+  std::vector<DocumentIndexManager::Results> topn_results = index_->batch_search(queries, counts, min_scores,
+      [&watch, timeout_us] { return timeout_us > 0 && watch.get_ticks_us() >= timeout_us; }, truncated);
+  Stats::increase(batch_count_, requests.size());
+  if (truncated) {
+    Stats::increase(truncated_count_, requests.size());
+  }
+
+  for (size_t i = 0; i < requests.size(); ++i) {
+    QueryResult& result = *results[i];
+    if (result.is_error_status()) {
+      result.track_latency(QueryResult::kFinalize);
+      continue;
+    }
+    result.track_latency(QueryResult::kQueryRead);
+    if (truncated) {
+      result.set_partial(true);
+    }
+    if (requests[i].is_debug()) {
+      LOG_INFO(logger, "[query:%s] searched in a batch of %zu queries, %zu results%s.",
+          requests[i].get_request_id().c_str(), requests.size(), topn_results[i].size(),
+          truncated ? ", truncated" : "");
+    }
+    for (const auto& r: topn_results[i]) {
+      result.get_results().emplace_back(r.first.to_string(), r.second);
+    }
+    result.track_latency(QueryResult::kResultConvert);
+    result.track_latency(QueryResult::kFinalize);
+  }
+  return results;
+}
+
+void SimpleQueryExecutor::search(const QueryRequest& request, const IntermQuery& interm_query,
+    QueryResult& result) {
+  DocumentQuery query(request, interm_query);
+  result.track_latency(QueryResult::kBuildQuery);
+  result.track_latency(QueryResult::kQueryStart);
+
+  // stop reading when the latency budget of the request runs out, and return the best so far.
+  long timeout_us = request.get_timeout_us() > 0 ? request.get_timeout_us() : default_timeout_us_;
+  const StopWatch& watch = request.get_watch();
+  std::function<bool ()> timed_out = [&watch, timeout_us] {
+    return timeout_us > 0 && watch.get_ticks_us() >= timeout_us;
+  };
+
+  // execute document query, the postings of the term-at-a-time plan are read here.
+  QueryPlanner::Plan plan = QueryPlanner::kPlanEmpty;
+  bool truncated = false;
+  std::unique_ptr<DocumentIndexManager::Reader> results_reader = index_->query(request, query, &plan,
+      timed_out, &truncated);
   size_t query_count = request.get_query_count();
-  result->track_latency(QueryResult::kQueryExecute);
+  Stats::increase(plan_counts_[plan]);
+  result.track_latency(QueryResult::kQueryExecute);
 
   if (!results_reader) {
     if (request.is_debug()) {
       LOG_INFO(logger, "[query:%s] received empty document result.", request.get_request_id().c_str());
     }
-    result->track_latency(QueryResult::kFinalize);
-    return result;
+    return;
   }
 
-  auto topn_results = read_topn(*results_reader, query_count);
+  // the top results are read directly if the reader keeps them, e.g. the head of the posting list
+  // of a single term, or the scores accumulated term-at-a-time. otherwise the reader is iterated.
+  std::vector<std::pair<DocumentIndexManager::DocId, DocumentIndexManager::Score>> topn_results;
+  if (results_reader->read_head(query_count, topn_results)) {
+    if (request.is_debug()) {
+      LOG_INFO(logger, "[query:%s] read the top results directly.", request.get_request_id().c_str());
+    }
+  } else {
+    // start with a threshold as high as possible, so that the reader prunes from the first document.
+    // the estimated k-th score is a lower bound of the k-th score of the results, and it is lowered
+    // a little bit so that documents with exactly the same score are still read.
+    DocumentIndexManager::Score min_score = request.get_min_score();
+    DocumentIndexManager::Score estimated_score;
+    if (results_reader->estimate_kth_weight(query_count, estimated_score)) {
+      estimated_score = std::nextafter(estimated_score,
+          -std::numeric_limits<DocumentIndexManager::Score>::infinity());
+      if (estimated_score > min_score) {
+        min_score = estimated_score;
+      }
+    }
+    if (request.is_debug()) {
+      LOG_INFO(logger, "[query:%s] initial threshold: %lf.", request.get_request_id().c_str(), min_score);
+    }
+
+    if (plan == QueryPlanner::kPlanParallel && parallel_pool_) {
+      // the partitions are read by the threads of the pool, sharing the threshold.
+      topn_results = read_topn_parallel(static_cast<DocumentIndexManager::ParallelReader&>(*results_reader),
+          query_count, min_score, [this] (size_t n, const TaskPool::Task& task) { parallel_pool_->run(n, task); },
+          timed_out, truncated);
+    } else if (!results_reader->read_topn_static(query_count, min_score, timed_out, truncated, topn_results)) {
+      // the reader could not read itself by its concrete type, so it is iterated through the virtual calls.
+      topn_results = read_topn_until(*results_reader, query_count, min_score, timed_out, truncated);
+    }
+  }
+  // the readers only skip by min_score as a hint, and the heads are read regardless of it, so the results
+  // are filtered here to be the same whichever plan is taken.
+  DocumentIndexManager::Score request_min_score = request.get_min_score();
+  topn_results.erase(std::remove_if(topn_results.begin(), topn_results.end(),
+      [request_min_score] (const std::pair<DocumentIndexManager::DocId, DocumentIndexManager::Score>& r) {
+        return !(r.second > request_min_score);
+      }), topn_results.end());
+  if (truncated) {
+    result.set_partial(true);
+    Stats::increase(truncated_count_);
+    if (request.is_debug()) {
+      LOG_INFO(logger, "[query:%s] truncated by timeout %ldus.", request.get_request_id().c_str(), timeout_us);
+    }
+  }
   if (request.is_debug()) {
     size_t n = 0;
     for (const auto& r: topn_results) {
@@ -58,15 +259,12 @@ std::unique_ptr<QueryResult> SimpleQueryExecutor::execute(const QueryRequest& re
           request.get_request_id().c_str(), n++, r.first.to_string().c_str(), r.second);
     }
   }
-  result->track_latency(QueryResult::kQueryRead);
+  result.track_latency(QueryResult::kQueryRead);
 
   for (const auto& r: topn_results) {
-    result->get_results().emplace_back(r.first.to_string(), r.second);
+    result.get_results().emplace_back(r.first.to_string(), r.second);
   }
-  result->track_latency(QueryResult::kResultConvert);
-  result->track_latency(QueryResult::kFinalize);
-
-  return result;
+  result.track_latency(QueryResult::kResultConvert);
 }
 
 } /* namespace redgiant */
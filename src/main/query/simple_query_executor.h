@@ -1,42 +1,91 @@
 #ifndef SRC_MAIN_QUERY_SIMPLE_QUERY_EXECUTOR_H_
 #define SRC_MAIN_QUERY_SIMPLE_QUERY_EXECUTOR_H_
 
+#include <string>
+#include <vector>
+
+#include "index/query_planner.h"
 #include "query/query_executor.h"
 #include "ranking/ranking_model.h"
+#include "utils/stats.h"
 
 namespace redgiant {
 class DocumentIndexManager;
+class IntermQuery;
+class QueryCache;
+class QueryCoalescer;
+class TaskPool;
 
 class SimpleQueryExecutor: public QueryExecutor {
 public:
-  SimpleQueryExecutor(DocumentIndexManager* index, RankingModel* model)
-  : index_(index), model_(model) {
+  // results are cached if cache is given, and identical queries executed concurrently
+  // share the results if coalescer is given. debug requests are always executed.
+  // requests without a latency budget use the default timeout, 0 for unlimited.
+  // the partitions of queries planned parallel are read by the threads of parallel_pool if given.
+  SimpleQueryExecutor(DocumentIndexManager* index, RankingModel* model, QueryCache* cache = nullptr,
+      QueryCoalescer* coalescer = nullptr, Stats* stats = nullptr, long default_timeout_us = 0,
+      TaskPool* parallel_pool = nullptr)
+  : index_(index), model_(model), cache_(cache), coalescer_(coalescer), parallel_pool_(parallel_pool),
+    truncated_count_(stats ? stats->get_counter("query.truncated") : nullptr),
+    batch_count_(stats ? stats->get_counter("query.batch_searched") : nullptr),
+    plan_counts_(QueryPlanner::kPlanCount, nullptr), default_timeout_us_(default_timeout_us) {
+    if (stats) {
+      for (int plan = 0; plan < QueryPlanner::kPlanCount; ++plan) {
+        plan_counts_[plan] = stats->get_counter(std::string("query.plan.")
+            + QueryPlanner::get_plan_name((QueryPlanner::Plan)plan));
+      }
+    }
   }
 
   virtual ~SimpleQueryExecutor() = default;
 
   virtual std::unique_ptr<QueryResult> execute(const QueryRequest& request);
 
+  // the queries are searched together, reading each term once for all of them. the batch is
+  // stopped by the least latency budget left of the queries, and the results are neither cached
+  // nor shared.
+  virtual std::vector<std::unique_ptr<QueryResult>> execute_batch(const std::vector<QueryRequest>& requests);
+
 private:
+  void search(const QueryRequest& request, const IntermQuery& interm_query, QueryResult& result);
+
   DocumentIndexManager* index_;
   RankingModel* model_;
+  QueryCache* cache_;
+  QueryCoalescer* coalescer_;
+  TaskPool* parallel_pool_;
+  Stats::Counter* truncated_count_;
+  // number of queries searched in batches
+  Stats::Counter* batch_count_;
+  // number of queries executed by each plan
+  std::vector<Stats::Counter*> plan_counts_;
+  long default_timeout_us_;
 };
 
 class SimpleQueryExecutorFactory: public QueryExecutorFactory {
 public:
-  SimpleQueryExecutorFactory(DocumentIndexManager* index, RankingModel* model)
-  : index_(index), model_(model) {
+  SimpleQueryExecutorFactory(DocumentIndexManager* index, RankingModel* model, QueryCache* cache = nullptr,
+      QueryCoalescer* coalescer = nullptr, Stats* stats = nullptr, long default_timeout_us = 0,
+      TaskPool* parallel_pool = nullptr)
+  : index_(index), model_(model), cache_(cache), coalescer_(coalescer), stats_(stats),
+    default_timeout_us_(default_timeout_us), parallel_pool_(parallel_pool) {
   }
 
   virtual ~SimpleQueryExecutorFactory() = default;
 
   virtual std::unique_ptr<QueryExecutor> create_executor() {
-    return std::unique_ptr<QueryExecutor>(new SimpleQueryExecutor(index_, model_));
+    return std::unique_ptr<QueryExecutor>(new SimpleQueryExecutor(index_, model_, cache_, coalescer_,
+        stats_, default_timeout_us_, parallel_pool_));
   }
 
 private:
   DocumentIndexManager* index_;
   RankingModel* model_;
+  QueryCache* cache_;
+  QueryCoalescer* coalescer_;
+  Stats* stats_;
+  long default_timeout_us_;
+  TaskPool* parallel_pool_;
 };
 } /* namespace redgiant */
 
@@ -19,13 +19,12 @@ std::unique_ptr<IntermQuery> DirectModel::process(const QueryRequest& request) c
   }
 
   IntermQuery::QueryFeatures terms;
-  for (const auto& fv: request.get_feature_vectors()) {
-    for (const auto& f: fv.get_features()) {
-      terms.emplace_back(f.first->get_id(), static_cast<IntermQuery::QueryWeight>(f.second));
-      if (request.is_debug()) {
-        LOG_TRACE(logger, "[query:%s] build feature 0x%016llx with weight %lf",
-            request.get_request_id().c_str(), (unsigned long long)(f.first->get_id()), (double)(f.second));
-      }
+  terms.reserve(request.get_terms().size());
+  for (const auto& f: request.get_terms()) {
+    terms.emplace_back(f.first, static_cast<IntermQuery::QueryWeight>(f.second));
+    if (request.is_debug()) {
+      LOG_TRACE(logger, "[query:%s] build feature 0x%016llx with weight %lf",
+          request.get_request_id().c_str(), (unsigned long long)(f.first), (double)(f.second));
     }
   }
   return std::unique_ptr<IntermQuery>(new IntermQuery(std::move(terms)));
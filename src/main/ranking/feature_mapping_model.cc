@@ -23,15 +23,23 @@ std::unique_ptr<IntermQuery> FeatureMappingModel::process(const QueryRequest& re
         request.get_request_id().c_str());
   }
 
-  for (const FeatureVector& fv: request.get_feature_vectors()) {
+  // features of the same space are usually adjacent, so look up the mappings once for them.
+  const QueryRequest::Terms& request_terms = request.get_terms();
+  auto space_begin = request_terms.begin();
+  while (space_begin != request_terms.end()) {
+    FeatureSpace::SpaceId space_id = FeatureSpace::get_part_space_id(space_begin->first);
+    auto space_end = space_begin;
+    while (space_end != request_terms.end() && FeatureSpace::get_part_space_id(space_end->first) == space_id) {
+      ++space_end;
+    }
+
     // find the mapped feature spaces. there may be multiple target spaces
-    auto range = mappings_.equal_range(fv.get_space().get_id());
+    auto range = mappings_.equal_range(space_id);
     if (range.first == mappings_.end()) {
       if (request.is_debug()) {
-        LOG_WARN(logger, "[query:%s] feature space %s not found in model mappings!",
-            request.get_request_id().c_str(), fv.get_space_name().c_str());
+        LOG_WARN(logger, "[query:%s] feature space %u not found in model mappings!",
+            request.get_request_id().c_str(), (unsigned)space_id);
       }
-      continue;
     }
 
     // for all mapped spaces
@@ -41,16 +49,16 @@ std::unique_ptr<IntermQuery> FeatureMappingModel::process(const QueryRequest& re
       if (weight <= 0) {
         if (request.is_debug()) {
           LOG_WARN(logger, "[query:%s] feature space %s weight %lf is not positive!",
-              request.get_request_id().c_str(), fv.get_space_name().c_str(), weight);
+              request.get_request_id().c_str(), std::get<0>(iter->second)->get_name().c_str(), weight);
         }
         continue;
       }
 
       // load features from request
-      for (const FeatureVector::FeaturePair& feature_pair: fv.get_features()) {
+      for (auto feature_pair = space_begin; feature_pair != space_end; ++feature_pair) {
         // project the feature to the mapped space
-        Feature::FeatureId id = space.project_to_space(feature_pair.first->get_id());
-        Score s = static_cast<Score>(feature_pair.second) * weight;
+        Feature::FeatureId id = space.project_to_space(feature_pair->first);
+        Score s = static_cast<Score>(feature_pair->second) * weight;
         // try insert the score if exists.
         auto insert_ret = terms.emplace(id, s);
         // or add the score to the existing scores
@@ -59,18 +67,19 @@ std::unique_ptr<IntermQuery> FeatureMappingModel::process(const QueryRequest& re
           if (request.is_debug()) {
             LOG_TRACE(logger, "[query:%s] build feature 0x%016llx from 0x%016llx, update weight to %lf",
                 request.get_request_id().c_str(), (unsigned long long)id,
-                (unsigned long long)(feature_pair.first->get_id()), insert_ret.first->second);
+                (unsigned long long)(feature_pair->first), insert_ret.first->second);
           }
         } else {
           if (request.is_debug()) {
             LOG_TRACE(logger, "[query:%s] build feature 0x%016llx from 0x%016llx, insert with weight %lf",
                 request.get_request_id().c_str(), (unsigned long long)id,
-                (unsigned long long)(feature_pair.first->get_id()), insert_ret.first->second);
+                (unsigned long long)(feature_pair->first), insert_ret.first->second);
           }
         } // terms.emplace
       } // for feature_pair
     } // for iter in range
-  } // for fv
+    space_begin = space_end;
+  } // for space
   return std::unique_ptr<IntermQuery>(new IntermQuery({terms.begin(), terms.end()}));
 }
 
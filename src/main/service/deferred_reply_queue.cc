@@ -0,0 +1,132 @@
+#include "service/deferred_reply_queue.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <event2/buffer.h>
+
+#include "utils/logger.h"
+
+namespace redgiant {
+
+DECLARE_LOGGER(logger, __FILE__);
+
+DeferredReplyQueue::DeferredReplyQueue()
+: notified_(false), closed_(true), notify_fd_{-1, -1}, notify_ev_(NULL) {
+}
+
+DeferredReplyQueue::~DeferredReplyQueue() {
+  if (notify_ev_) {
+    event_free(notify_ev_);
+  }
+  if (notify_fd_[0] != -1) {
+    ::close(notify_fd_[0]);
+    ::close(notify_fd_[1]);
+  }
+}
+
+int DeferredReplyQueue::initialize(event_base* ev_base) {
+  if (socketpair(AF_UNIX, SOCK_STREAM, 0, notify_fd_) == -1) {
+    LOG_ERROR(logger, "failed create reply notify socket");
+    notify_fd_[0] = -1;
+    notify_fd_[1] = -1;
+    return -1;
+  }
+
+  for (int fd: notify_fd_) {
+    int flags;
+    if ((flags = fcntl(fd, F_GETFL, 0)) < 0
+      || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+      LOG_ERROR(logger, "change reply notify socket to nonblocking failed");
+      return -1;
+    }
+  }
+
+  notify_ev_ = event_new(ev_base, notify_fd_[0], EV_READ | EV_PERSIST, on_notify_cb, this);
+  if (notify_ev_ == NULL) {
+    LOG_ERROR(logger, "failed to add reply notify event");
+    return -1;
+  }
+  event_add(notify_ev_, NULL);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  closed_ = false;
+  return 0;
+}
+
+void DeferredReplyQueue::close() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!closed_) {
+    closed_ = true;
+    if (!replies_.empty()) {
+      LOG_INFO(logger, "%zu deferred replies dropped on close", replies_.size());
+      replies_.clear();
+    }
+  }
+  if (notify_ev_) {
+    event_free(notify_ev_);
+    notify_ev_ = NULL;
+  }
+}
+
+int DeferredReplyQueue::push(DeferredReply reply) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (closed_) {
+    return -1;
+  }
+  replies_.push_back(std::move(reply));
+  if (!notified_) {
+    // one wakeup is enough for all the replies queued before it is consumed
+    char c = 0;
+    if (::write(notify_fd_[1], &c, 1) < 0 && errno != EAGAIN) {
+      LOG_ERROR(logger, "failed to notify deferred reply, error: %d", errno);
+      replies_.pop_back();
+      return -1;
+    }
+    notified_ = true;
+  }
+  return 0;
+}
+
+void DeferredReplyQueue::on_notify_cb(evutil_socket_t fd, short what, void* arg) {
+  (void) what;
+  ((DeferredReplyQueue*)arg)->on_notify(fd);
+}
+
+void DeferredReplyQueue::on_notify(evutil_socket_t fd) {
+  char buf[64];
+  while (::read(fd, buf, sizeof(buf)) > 0) {
+    // drain the socket
+  }
+
+  std::vector<DeferredReply> replies;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    replies.swap(replies_);
+    notified_ = false;
+  }
+
+  for (auto& reply: replies) {
+    send_reply(reply);
+  }
+}
+
+void DeferredReplyQueue::send_reply(DeferredReply& reply) {
+  const char* status_msg = reply.has_status_msg ? reply.status_msg.c_str() : NULL;
+  evkeyvalq* output_headers = evhttp_request_get_output_headers(reply.req);
+  for (auto& header: reply.headers) {
+    evhttp_add_header(output_headers, header.first.c_str(), header.second.c_str());
+  }
+  if (reply.empty) {
+    evhttp_send_error(reply.req, reply.status_code, status_msg);
+    return;
+  }
+  evbuffer* buf = evbuffer_new();
+  evbuffer_add(buf, reply.body.data(), reply.body.size());
+  evhttp_send_reply(reply.req, reply.status_code, status_msg, buf);
+  evbuffer_free(buf);
+}
+
+} // namespace redgiant
@@ -0,0 +1,63 @@
+#ifndef _REDGIANT_SERVICE_DEFERRED_REPLY_QUEUE_H_
+#define _REDGIANT_SERVICE_DEFERRED_REPLY_QUEUE_H_
+
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <event2/event.h>
+#include <evhttp.h>
+
+namespace redgiant {
+/*
+ * A reply prepared outside of the event loop.
+ */
+struct DeferredReply {
+  evhttp_request* req = nullptr;
+  int status_code = 0;
+  std::string status_msg;
+  bool has_status_msg = false;
+  bool empty = false;
+  std::vector<std::pair<std::string, std::string>> headers;
+  std::string body;
+};
+
+/*
+ * Replies pushed by any thread and sent by the event loop owning the requests.
+ * The loop is woken up through a socket pair registered in the event base.
+ *
+ * libevent keeps a request alive until it is replied, even if the client has
+ * gone away, so every deferred request shall be replied exactly once.
+ */
+class DeferredReplyQueue {
+public:
+  DeferredReplyQueue();
+  ~DeferredReplyQueue();
+
+  // called in the loop thread
+  int initialize(event_base* ev_base);
+  // called in the loop thread before the event base is freed.
+  // the replies pushed afterwards are dropped.
+  void close();
+
+  // called in any thread
+  int push(DeferredReply reply);
+
+private:
+  static void on_notify_cb(evutil_socket_t fd, short what, void* arg);
+  void on_notify(evutil_socket_t fd);
+
+  static void send_reply(DeferredReply& reply);
+
+private:
+  std::mutex mutex_;
+  std::vector<DeferredReply> replies_;
+  // whether a wakeup is written but not consumed yet
+  bool notified_;
+  bool closed_;
+  int notify_fd_[2];
+  event* notify_ev_;
+};
+} // namespace redgiant
+
+#endif // _REDGIANT_SERVICE_DEFERRED_REPLY_QUEUE_H_
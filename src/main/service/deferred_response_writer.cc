@@ -0,0 +1,53 @@
+#include "service/deferred_response_writer.h"
+
+#include <utility>
+
+namespace redgiant {
+
+DeferredResponseWriter::DeferredResponseWriter(std::shared_ptr<DeferredReplyQueue> reply_queue,
+    evhttp_request* req)
+: reply_queue_(std::move(reply_queue)), sent_(false) {
+  reply_.req = req;
+}
+
+DeferredResponseWriter::~DeferredResponseWriter() {
+  if (!sent_) {
+    // never leave the request hanging
+    reply_.headers.clear();
+    push(500, NULL, true);
+  }
+}
+
+void DeferredResponseWriter::add_header(const char* key, const char* value) {
+  reply_.headers.emplace_back(key, value);
+}
+
+void DeferredResponseWriter::add_body(const void* body, size_t size) {
+  if (body && size > 0) {
+    reply_.body.append((const char*)body, size);
+  }
+}
+
+void DeferredResponseWriter::send(int status_code, const char* status_msg) {
+  push(status_code, status_msg, false);
+}
+
+void DeferredResponseWriter::send_empty(int status_code, const char* status_msg) {
+  push(status_code, status_msg, true);
+}
+
+void DeferredResponseWriter::push(int status_code, const char* status_msg, bool empty) {
+  if (sent_) {
+    return;
+  }
+  sent_ = true;
+  reply_.status_code = status_code;
+  if (status_msg) {
+    reply_.status_msg = status_msg;
+    reply_.has_status_msg = true;
+  }
+  reply_.empty = empty;
+  reply_queue_->push(std::move(reply_));
+}
+
+} // namespace redgiant
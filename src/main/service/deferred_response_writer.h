@@ -0,0 +1,34 @@
+#ifndef _REDGIANT_SERVICE_DEFERRED_RESPONSE_WRITER_H_
+#define _REDGIANT_SERVICE_DEFERRED_RESPONSE_WRITER_H_
+
+#include <memory>
+#include <evhttp.h>
+#include "service/deferred_reply_queue.h"
+#include "service/response_writer.h"
+
+namespace redgiant {
+/*
+ * A response writer detached from the request callback, which could be used in any thread.
+ * The response is handed over to the event loop owning the request when sent.
+ * If destroyed without being sent, an empty 500 response is sent instead.
+ */
+class DeferredResponseWriter: public ResponseWriter {
+public:
+  DeferredResponseWriter(std::shared_ptr<DeferredReplyQueue> reply_queue, evhttp_request* req);
+  virtual ~DeferredResponseWriter();
+
+  virtual void add_header(const char* key, const char* value);
+  virtual void add_body(const void* body, size_t size);
+  virtual void send(int status_code, const char* status_msg);
+  virtual void send_empty(int status_code, const char* status_msg);
+
+private:
+  void push(int status_code, const char* status_msg, bool empty);
+
+  std::shared_ptr<DeferredReplyQueue> reply_queue_;
+  DeferredReply reply_;
+  bool sent_;
+};
+} // namespace redgiant
+
+#endif // _REDGIANT_SERVICE_DEFERRED_RESPONSE_WRITER_H_
@@ -113,6 +113,20 @@ int EventRequestContext::get_content(char* out_buf, int max_len) const {
   return evbuffer_remove(buf, out_buf, ret_len);
 }
 
+int EventRequestContext::get_content(std::string& out) const {
+  evbuffer* buf = evhttp_request_get_input_buffer(ev_req_);
+  if (!buf) {
+    out.clear();
+    return -1;
+  }
+  // drain the evbuffer chain directly into the string, no extra staging buffer.
+  size_t post_len = evbuffer_get_length(buf);
+  out.resize(post_len);
+  int ret_len = post_len > 0 ? evbuffer_remove(buf, &out[0], post_len) : 0;
+  out.resize(ret_len > 0 ? ret_len : 0);
+  return ret_len;
+}
+
 std::string EventRequestContext::get_header(const char* key) const {
   evkeyvalq *headers = ev_req_->input_headers;
   const char* ret = evhttp_find_header(headers, key);
@@ -20,6 +20,7 @@ public:
   virtual int get_method() const;
   virtual int get_content_length() const;
   virtual int get_content(char* out_buf, int max_len) const;
+  virtual int get_content(std::string& out) const;
 
 private:
   evhttp_request* ev_req_;
@@ -1,11 +1,14 @@
 #include "service/event_response_writer.h"
 
 #include <string.h>
+#include <utility>
+
+#include "service/deferred_response_writer.h"
 
 namespace redgiant {
 
-EventResponseWriter::EventResponseWriter(evhttp_request* req)
-: ev_req_(req), ev_buf_(evbuffer_new(), evbuffer_free) {
+EventResponseWriter::EventResponseWriter(evhttp_request* req, std::shared_ptr<DeferredReplyQueue> reply_queue)
+: ev_req_(req), ev_buf_(evbuffer_new(), evbuffer_free), reply_queue_(std::move(reply_queue)) {
 }
 
 void EventResponseWriter::add_header(const char* key, const char* value) {
@@ -26,5 +29,12 @@ void EventResponseWriter::send_empty(int status_code, const char* status_msg) {
   evhttp_send_error(ev_req_, status_code, status_msg);
 }
 
+std::shared_ptr<ResponseWriter> EventResponseWriter::defer() {
+  if (!reply_queue_) {
+    return nullptr;
+  }
+  return std::make_shared<DeferredResponseWriter>(reply_queue_, ev_req_);
+}
+
 } // namespace redgiant
 
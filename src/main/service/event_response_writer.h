@@ -4,22 +4,26 @@
 #include <memory>
 #include <event2/buffer.h>
 #include <evhttp.h>
+#include "service/deferred_reply_queue.h"
 #include "service/response_writer.h"
 
 namespace redgiant {
 class EventResponseWriter: public ResponseWriter {
 public:
-  EventResponseWriter(evhttp_request* req);
+  // the response could be deferred only if a reply queue of the event loop is given.
+  EventResponseWriter(evhttp_request* req, std::shared_ptr<DeferredReplyQueue> reply_queue = nullptr);
   virtual ~EventResponseWriter() = default;
 
   virtual void add_header(const char* key, const char* value);
   virtual void add_body(const void* body, size_t size);
   virtual void send(int status_code, const char* status_msg);
   virtual void send_empty(int status_code, const char* status_msg);
+  virtual std::shared_ptr<ResponseWriter> defer();
 
 private:
   evhttp_request* ev_req_;
   std::shared_ptr<evbuffer> ev_buf_;
+  std::shared_ptr<DeferredReplyQueue> reply_queue_;
 };
 } // namespace redgiant
 
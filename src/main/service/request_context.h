@@ -33,6 +33,20 @@ public:
   virtual int get_method() const = 0;
   virtual int get_content_length() const = 0;
   virtual int get_content(char* out_buf, int max_len) const = 0;
+
+  // move the whole content into a string. implementations may override it to avoid
+  // the intermediate buffer.
+  virtual int get_content(std::string& out) const {
+    int len = get_content_length();
+    if (len <= 0) {
+      out.clear();
+      return len;
+    }
+    out.resize(len);
+    int ret_len = get_content(&out[0], len);
+    out.resize(ret_len > 0 ? ret_len : 0);
+    return ret_len;
+  }
 };
 } // namespace redgiant
 
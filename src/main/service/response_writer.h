@@ -2,6 +2,7 @@
 #define _REDGIANT_SERVICE_RESPONSE_WRITER_H_
 
 #include <cstring>
+#include <memory>
 #include <string>
 
 namespace redgiant {
@@ -25,6 +26,14 @@ public:
 
   virtual void send(int status_code, const char* status_msg) = 0;
   virtual void send_empty(int status_code, const char* status_msg) = 0;
+
+  // Detach the response from the current request callback, so that it could be
+  // sent later from any thread. Headers already added are kept, the body is not.
+  // After a successful call only the returned writer shall be used.
+  // Returns nullptr if not supported, and the response must be sent in place.
+  virtual std::shared_ptr<ResponseWriter> defer() {
+    return nullptr;
+  }
 };
 } // namespace redgiant
 
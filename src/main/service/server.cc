@@ -6,6 +6,8 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <netinet/in.h>
+#include <pthread.h>
+#include <sched.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -19,17 +21,30 @@ using namespace std;
 DECLARE_LOGGER(logger, __FILE__);
 
 namespace redgiant {
-Server::Server(int port, size_t thread_num, size_t max_req_per_thread)
-: port_(port), thread_num_(thread_num), max_req_per_thread_(max_req_per_thread) {
+Server::Server(int port, size_t thread_num, size_t max_req_per_thread,
+    bool reuse_port, bool pin_threads)
+: port_(port), thread_num_(thread_num), max_req_per_thread_(max_req_per_thread),
+  reuse_port_(reuse_port), pin_threads_(pin_threads) {
 }
 
 Server::~Server() {
+  close_sockets();
+}
+
+void Server::close_sockets() {
   if (fd_ != -1) {
     ::close(fd_);
+    fd_ = -1;
   }
+  for (int fd: reuse_fds_) {
+    ::close(fd);
+  }
+  reuse_fds_.clear();
   if (notify_fd_[0] != -1) {
     ::close(notify_fd_[0]);
+    notify_fd_[0] = -1;
     ::close(notify_fd_[1]);
+    notify_fd_[1] = -1;
   }
 }
 
@@ -44,32 +59,45 @@ int Server::bind(const std::string& uri, std::shared_ptr<RequestHandlerFactory>
 
 int Server::initialize() {
   int backlog = 10240;
-  LOG_INFO(logger, "Starting server at port=%d, worker threads=%zu, max_req_per_thread=%zu",
-      port_, thread_num_, max_req_per_thread_);
+  LOG_INFO(logger, "Starting server at port=%d, worker threads=%zu, max_req_per_thread=%zu, "
+      "reuse_port=%s, pin_threads=%s", port_, thread_num_, max_req_per_thread_,
+      reuse_port_ ? "true" : "false", pin_threads_ ? "true" : "false");
 
-  fd_ = bind_socket(port_, backlog);
+  fd_ = bind_socket(port_, backlog, reuse_port_);
   if (fd_ < 0) {
     LOG_ERROR(logger, "failed bind socket");
     return -1;
   }
 
+  if (reuse_port_) {
+    for (size_t i = 1; i < thread_num_; ++i) {
+      int fd = bind_socket(port_, backlog, true);
+      if (fd < 0) {
+        LOG_ERROR(logger, "failed bind socket for server thread %zu", i);
+        close_sockets();
+        return -1;
+      }
+      reuse_fds_.push_back(fd);
+    }
+  }
+
   if(socketpair(AF_UNIX, SOCK_STREAM, 0, notify_fd_) == -1){
     LOG_ERROR(logger, "failed create signal socket");
-    ::close(fd_);
-    fd_ = -1;
     notify_fd_[0] = -1;
     notify_fd_[1] = -1;
+    close_sockets();
     return -1;
   }
 
   int ret = 0;
   for (size_t i = 0; i < thread_num_; ++i) {
+    int fd = (reuse_port_ && i > 0) ? reuse_fds_[i - 1] : fd_;
     std::unordered_map<std::string, std::unique_ptr<RequestHandler>> route_map;
     for (auto& factory: routes_) {
       route_map.emplace(factory.first, factory.second->create_handler());
     }
     std::shared_ptr<ServerInstance> instance(new ServerInstance(
-        fd_, notify_fd_[0], max_req_per_thread_, std::move(route_map)));
+        fd, notify_fd_[0], max_req_per_thread_, std::move(route_map)));
     ret = instance->initialize(i);
     if (ret < 0) {
       break;
@@ -80,12 +108,7 @@ int Server::initialize() {
   if (ret < 0) {
     LOG_ERROR(logger, "failed during initialize server context");
     instances_.clear();
-    ::close(fd_);
-    fd_ = -1;
-    ::close(notify_fd_[0]);
-    notify_fd_[0] = -1;
-    ::close(notify_fd_[1]);
-    notify_fd_[1] = -1;
+    close_sockets();
     return -1;
   }
   return 0;
@@ -98,8 +121,15 @@ int Server::start() {
   }
 
   LOG_DEBUG(logger, "Server at port=%d init done, starting handler threads.", port_);
+  size_t cpu_num = std::thread::hardware_concurrency();
   for (auto& instance: instances_) {
     instance_threads_.emplace_back(&ServerInstance::run, instance);
+    if (pin_threads_ && cpu_num > 0) {
+      size_t cpu = (instance_threads_.size() - 1) % cpu_num;
+      if (pin_thread(instance_threads_.back(), cpu) < 0) {
+        LOG_WARN(logger, "failed to pin server thread %zu to cpu %zu", instance_threads_.size() - 1, cpu);
+      }
+    }
   }
 
   LOG_INFO(logger, "Server at port=%d started.", port_);
@@ -124,18 +154,20 @@ int Server::stop() {
   instance_threads_.clear();
   instances_.clear();
 
-  ::close(fd_);
-  fd_ = -1;
-  ::close(notify_fd_[0]);
-  notify_fd_[0] = -1;
-  ::close(notify_fd_[1]);
-  notify_fd_[1] = -1;
+  close_sockets();
 
   LOG_INFO(logger, "Server at port=%d stopped.", port_);
   return 0;
 }
 
-int Server::bind_socket(int port, int backlog) {
+int Server::pin_thread(std::thread& thread, size_t cpu) {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+  return pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set) == 0 ? 0 : -1;
+}
+
+int Server::bind_socket(int port, int backlog, bool reuse_port) {
   int ret;
   int nfd;
   nfd = socket(AF_INET, SOCK_STREAM, 0);
@@ -146,6 +178,14 @@ int Server::bind_socket(int port, int backlog) {
 
   int one = 1;
   ret = setsockopt(nfd, SOL_SOCKET, SO_REUSEADDR, (char *)&one, sizeof(int));
+  if (reuse_port) {
+    ret = setsockopt(nfd, SOL_SOCKET, SO_REUSEPORT, (char *)&one, sizeof(int));
+    if (ret < 0) {
+      LOG_ERROR(logger, "set SO_REUSEPORT failed");
+      ::close(nfd);
+      return -1;
+    }
+  }
 
   struct sockaddr_in addr;
   memset(&addr, 0, sizeof(addr));
@@ -156,12 +196,14 @@ int Server::bind_socket(int port, int backlog) {
   ret = ::bind(nfd, (struct sockaddr*)&addr, sizeof(addr));
   if (ret < 0) {
     LOG_ERROR (logger, "bind to port %d failed", port);
+    ::close(nfd);
     return -1;
   }
 
   ret = ::listen(nfd, backlog);
   if (ret < 0) {
     LOG_ERROR (logger, "listen failed");
+    ::close(nfd);
     return -1;
   }
 
@@ -169,6 +211,7 @@ int Server::bind_socket(int port, int backlog) {
   if ((flags = fcntl(nfd, F_GETFL, 0)) < 0
     || fcntl(nfd, F_SETFL, flags | O_NONBLOCK) < 0) {
     LOG_ERROR (logger, "change to nonblocking failed");
+    ::close(nfd);
     return -1;
   }
   return nfd;
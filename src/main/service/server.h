@@ -16,7 +16,11 @@ public:
 
   typedef std::unordered_map<std::string, std::shared_ptr<RequestHandlerFactory>> RouteFactoryMap;
 
-  Server(int port, size_t thread_num, size_t max_req_per_thread);
+  // reuse_port: each server thread listens on its own socket bound with SO_REUSEPORT,
+  //   so that the kernel balances the connections among the threads.
+  // pin_threads: bind the server threads to CPUs, thread i to CPU i mod number of CPUs.
+  Server(int port, size_t thread_num, size_t max_req_per_thread,
+      bool reuse_port = false, bool pin_threads = false);
   ~Server();
 
 public:
@@ -26,16 +30,24 @@ public:
   int stop();
 
 private:
-  static int bind_socket(int port, int backlog);
+  static int bind_socket(int port, int backlog, bool reuse_port);
+  static int pin_thread(std::thread& thread, size_t cpu);
+  void close_sockets();
 
 private:
   int port_;
   size_t thread_num_;
   size_t max_req_per_thread_;
+  bool reuse_port_;
+  bool pin_threads_;
   RouteFactoryMap routes_;
   std::vector<std::shared_ptr<ServerInstance>> instances_;
   std::vector<std::thread> instance_threads_;
+  // the listening socket, shared by all instances unless reuse_port is set,
+  // in which case it belongs to the first instance.
   int fd_ = -1;
+  // sockets of the other instances if reuse_port is set
+  std::vector<int> reuse_fds_;
   int notify_fd_[2] { -1, -1 };
 };
 } // namespace redgiant
@@ -27,6 +27,10 @@ ServerInstance::ServerInstance(int fd, int notify_fd, size_t max_req_per_thread_
 }
 
 ServerInstance::~ServerInstance() {
+  if (reply_queue_) {
+    // the deferred writers may still be alive in other threads
+    reply_queue_->close();
+  }
   if (ev_http_) {
     evhttp_free(ev_http_);
   }
@@ -65,7 +69,7 @@ void ServerInstance::on_request(evhttp_request *req) {
   }
 
   EventRequestContext request_ctx(req);
-  EventResponseWriter response_writer(req);
+  EventResponseWriter response_writer(req, reply_queue_);
   // close the connection after such amount of requests
   handle_count_++;
   if (max_req_per_thread_ > 0 && handle_count_ > max_req_per_thread_) {
@@ -125,6 +129,12 @@ int ServerInstance::initialize(size_t id) {
 
   evhttp_set_gencb(ev_http_, on_request_cb, this);
 
+  reply_queue_ = std::make_shared<DeferredReplyQueue>();
+  if (reply_queue_->initialize(ev_base_) < 0) {
+    LOG_ERROR(logger, "failed to initialize deferred reply queue");
+    return -1;
+  }
+
   // this event will be used to notify exit
   struct event *notify_ev = event_new(ev_base_, notify_fd_, EV_TIMEOUT | EV_READ | EV_PERSIST, on_notify_cb, this);
   if (notify_ev == NULL) {
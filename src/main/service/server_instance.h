@@ -6,6 +6,7 @@
 #include <unordered_map>
 #include <event2/event.h>
 #include <evhttp.h>
+#include "service/deferred_reply_queue.h"
 #include "service/request_handler.h"
 
 namespace redgiant {
@@ -39,6 +40,8 @@ private:
 
   event_base* ev_base_;
   evhttp* ev_http_;
+  // replies of the requests deferred by the handlers
+  std::shared_ptr<DeferredReplyQueue> reply_queue_;
   size_t handle_count_;
 };
 
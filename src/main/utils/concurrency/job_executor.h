@@ -2,6 +2,7 @@
 #define SRC_MAIN_UTILS_CONCURRENCY_JOB_EXECUTOR_H_
 
 #include <memory>
+#include <utility>
 
 namespace redgiant {
 /*
@@ -20,6 +21,13 @@ public:
   virtual void start() = 0;
   virtual void stop() = 0;
   virtual void schedule(std::shared_ptr<Job> job) = 0;
+
+  // schedule the job without blocking the caller, returns false if it could not be scheduled at once,
+  // e.g. the queue is full. the default implementation is to schedule it anyway.
+  virtual bool try_schedule(std::shared_ptr<Job> job) {
+    schedule(std::move(job));
+    return true;
+  }
 };
 } /* namespace redgiant */
 
@@ -65,6 +65,18 @@ public:
     return -1;
   }
 
+  // move push without waiting, returns -1 and keeps the item if the queue is full.
+  int try_push(T&& item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!alive_ || max_size_ == 0 || queue_.size() >= max_size_) {
+      return -1;
+    }
+    queue_.push(std::move(item));
+    lock.unlock();
+    cond_empty_.notify_one();
+    return 0;
+  }
+
   // exit elegantly
   void flush() {
     std::unique_lock<std::mutex> lock(mutex_);
@@ -0,0 +1,121 @@
+#ifndef SRC_MAIN_UTILS_CONCURRENCY_TASK_POOL_H_
+#define SRC_MAIN_UTILS_CONCURRENCY_TASK_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "utils/concurrency/message_queue.h"
+
+namespace redgiant {
+/*
+ * A pool of threads helping the callers run a batch of small tasks.
+ * - The caller runs the tasks itself, and the idle threads of the pool join in: each of them
+ *   takes the next task not taken yet, until all are taken. So the busy threads never block
+ *   the others, and run() never waits for a free thread.
+ * - The pool is shared by the callers, and a thread helps one batch at a time.
+ */
+class TaskPool {
+public:
+  typedef std::function<void (size_t)> Task;
+
+  TaskPool(size_t thread_num)
+  : thread_num_(thread_num), queue_(thread_num * 4) {
+  }
+
+  ~TaskPool() {
+    stop();
+  }
+
+  void start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (threads_.empty()) {
+      for (size_t i = 0; i < thread_num_; ++i) {
+        threads_.emplace_back(&TaskPool::run_helper, this);
+      }
+    }
+  }
+
+  void stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!threads_.empty()) {
+      queue_.flush();
+      for (auto& thread: threads_) {
+        thread.join();
+      }
+      threads_.clear();
+    }
+  }
+
+  size_t get_thread_num() const {
+    return thread_num_;
+  }
+
+  // call task(i) for each i in [0, task_num), and return after all of them completed.
+  void run(size_t task_num, const Task& task) {
+    if (task_num == 0) {
+      return;
+    }
+    std::shared_ptr<Batch> batch = std::make_shared<Batch>(task_num, task);
+    // do not queue up more helpers than the idle threads, or they may arrive too late to help.
+    size_t helpers = std::min(task_num - 1, thread_num_);
+    for (size_t i = 0; i < helpers && queue_.size() < thread_num_; ++i) {
+      if (queue_.push(batch) < 0) {
+        break;
+      }
+    }
+    batch->run();
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    while (batch->done < batch->task_num) {
+      batch->cond.wait(lock);
+    }
+  }
+
+private:
+  struct Batch {
+    Batch(size_t task_num, const Task& task)
+    : task_num(task_num), task(task), next(0), done(0) {
+    }
+
+    // take and run the tasks, until all are taken.
+    void run() {
+      for (size_t i = next++; i < task_num; i = next++) {
+        task(i);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (++done == task_num) {
+          cond.notify_all();
+        }
+      }
+    }
+
+    const size_t task_num;
+    // refers to the caller's task, only called before the caller returns.
+    const Task& task;
+    std::atomic<size_t> next;
+    // protected by mutex
+    size_t done;
+    std::mutex mutex;
+    std::condition_variable cond;
+  };
+
+  void run_helper() {
+    std::shared_ptr<Batch> batch;
+    // a batch completed before being picked up has no task left to take.
+    while (queue_.pop(batch) >= 0) {
+      batch->run();
+      batch.reset();
+    }
+  }
+
+  const size_t thread_num_;
+  MessageQueue<std::shared_ptr<Batch>> queue_;
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_UTILS_CONCURRENCY_TASK_POOL_H_ */
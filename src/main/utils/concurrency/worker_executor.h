@@ -51,6 +51,10 @@ public:
     queue_.push(std::move(job));
   }
 
+  virtual bool try_schedule(std::shared_ptr<Job> job) {
+    return queue_.try_push(std::move(job)) == 0;
+  }
+
   void set_next(std::shared_ptr<JobExecutor<Job>> next) {
     next_ = std::move(next);
   }
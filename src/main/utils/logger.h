@@ -41,6 +41,10 @@ inline char* log_format_internal__(char* buf, size_t n, const char* fmt, ...) {
 #define LOG_ERROR(logger, ...)  LOG_INTERNAL__(logger, LOG_INTERNAL_MAX_SIZE_INFO__,  log4cxx::Level::getError(), __VA_ARGS__)
 #define LOG_FATAL(logger, ...)  LOG_INTERNAL__(logger, LOG_INTERNAL_MAX_SIZE_INFO__,  log4cxx::Level::getFatal(), __VA_ARGS__)
 
+// check the level before collecting extra information only used in logs
+#define LOG_TRACE_ENABLED(logger) ((logger)->isTraceEnabled())
+#define LOG_DEBUG_ENABLED(logger) ((logger)->isDebugEnabled())
+
 } // namespace redgiant
 
 #endif /* SRC_MAIN_UTILS_LOGGER_H_ */
@@ -0,0 +1,62 @@
+#ifndef SRC_MAIN_UTILS_STATS_H_
+#define SRC_MAIN_UTILS_STATS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace redgiant {
+/*
+ * Named counters shared by the components of the service.
+ * Counters are created on first use and never removed, so the returned
+ * pointers are valid as long as the Stats object.
+ */
+class Stats {
+public:
+  typedef std::atomic<uint64_t> Counter;
+
+  Stats() = default;
+  ~Stats() = default;
+
+  // no copy
+  Stats(const Stats&) = delete;
+  Stats& operator= (const Stats&) = delete;
+
+  Counter* get_counter(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& counter = counters_[name];
+    if (!counter) {
+      counter.reset(new Counter(0));
+    }
+    return counter.get();
+  }
+
+  // values of all the counters, sorted by names
+  std::vector<std::pair<std::string, uint64_t>> get_values() const {
+    std::vector<std::pair<std::string, uint64_t>> values;
+    std::lock_guard<std::mutex> lock(mutex_);
+    values.reserve(counters_.size());
+    for (const auto& counter: counters_) {
+      values.emplace_back(counter.first, counter.second->load(std::memory_order_relaxed));
+    }
+    return values;
+  }
+
+  static void increase(Counter* counter, uint64_t value = 1) {
+    if (counter) {
+      counter->fetch_add(value, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::map<std::string, std::unique_ptr<Counter>> counters_;
+};
+} /* namespace redgiant */
+
+#endif /* SRC_MAIN_UTILS_STATS_H_ */
@@ -46,11 +46,17 @@ protected:
     CPPUNIT_ASSERT_EQUAL(1, ret);
     // changes not applied
     CPPUNIT_ASSERT_EQUAL(0, (int)index->get_term_count());
+    uint64_t generation = index->get_generation();
 
     // apply changes
     index->apply_internal();
     // changes applied
     CPPUNIT_ASSERT_EQUAL(2, (int)index->get_term_count());
+    CPPUNIT_ASSERT_EQUAL(generation + 1, index->get_generation());
+
+    // nothing to apply, generation unchanged
+    index->apply_internal();
+    CPPUNIT_ASSERT_EQUAL(generation + 1, index->get_generation());
 
     auto reader = index->peek(103);
     std::vector<std::pair<int, int>> results = read_all(*reader);
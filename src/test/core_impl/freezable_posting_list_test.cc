@@ -117,7 +117,7 @@ protected:
 
 private:
   std::shared_ptr<FreezablePostingList<int, int>> create_case_empty() {
-    return std::make_shared<FreezablePostingList<int, int>>(*create_factory());
+    return std::make_shared<FreezablePostingList<int, int>>(get_factory());
   }
 
   std::shared_ptr<FreezablePostingList<int, int>> create_case_1() {
@@ -126,12 +126,22 @@ private:
           {1, 8}, {2, 2}, {5, 4}, {8, 4}, {10, 2}
         }));
     // create with a factory and an existing instance
-    return std::make_shared<FreezablePostingList<int, int>>(*create_factory(), std::move(raw_reader));
+    return std::make_shared<FreezablePostingList<int, int>>(get_factory(), std::move(raw_reader));
   }
 
   virtual std::unique_ptr<PostingListFactory<int, int>> create_factory() {
     return std::unique_ptr<PostingListFactory<int, int>>(new BTreePostingListFactory<int, int>());
   }
+
+  // the factory lives as long as the posting lists created by it
+  const PostingListFactory<int, int>& get_factory() {
+    if (!factory_) {
+      factory_ = create_factory();
+    }
+    return *factory_;
+  }
+
+  std::unique_ptr<PostingListFactory<int, int>> factory_;
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(FreezablePostingListTest);
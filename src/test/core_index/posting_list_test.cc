@@ -9,10 +9,20 @@
 #include "../core_reader/mock_reader.h"
 
 #include "core/index/posting_list.h"
+#include "core/index/constant_posting_list.h"
 #include "core/index/map_posting_list.h"
+#include "core/index/quantized_posting_list.h"
+#include "core/index/sequential_posting_list.h"
+#include "core/index/small_posting_list.h"
 #include "core/index/btree_posting_list.h"
+#include "core/index/tiered_posting_list.h"
+#include "core/reader/dot_product_reader.h"
+#include "core/reader/max_score_reader.h"
+#include "core/reader/max_score_reader-inl.h"
 #include "core/reader/posting_list_reader.h"
 #include "core/reader/reader_utils.h"
+#include "core/reader/wand_reader.h"
+#include "core/reader/wand_reader-inl.h"
 
 namespace redgiant {
 class PostingListTest: public CppUnit::TestFixture {
@@ -61,6 +71,32 @@ protected:
     CPPUNIT_ASSERT_EQUAL(5, results[0].second.w2);
   }
 
+  void test_next_block() {
+    auto plist_1 = create_case_1();
+    auto reader = create_reader_shared(plist_1);
+    int doc_ids[3];
+    int weights[3];
+    CPPUNIT_ASSERT_EQUAL(3, (int)reader->next_block(0, doc_ids, weights, 3));
+    CPPUNIT_ASSERT_EQUAL(1, doc_ids[0]);
+    CPPUNIT_ASSERT_EQUAL(8, weights[0]);
+    CPPUNIT_ASSERT_EQUAL(5, doc_ids[2]);
+    CPPUNIT_ASSERT_EQUAL(4, weights[2]);
+    // the cursor is at the last item read
+    CPPUNIT_ASSERT_EQUAL(4, (int)reader->read());
+    CPPUNIT_ASSERT_EQUAL(2, (int)reader->next_block(5, doc_ids, weights, 3));
+    CPPUNIT_ASSERT_EQUAL(8, doc_ids[0]);
+    CPPUNIT_ASSERT_EQUAL(10, doc_ids[1]);
+    CPPUNIT_ASSERT_EQUAL(2, weights[1]);
+    CPPUNIT_ASSERT_EQUAL(0, (int)reader->next_block(10, doc_ids, weights, 3));
+
+    // skipping ahead, and continued one by one
+    reader = create_reader_shared(plist_1);
+    CPPUNIT_ASSERT_EQUAL(1, (int)reader->next_block(6, doc_ids, weights, 1));
+    CPPUNIT_ASSERT_EQUAL(8, doc_ids[0]);
+    CPPUNIT_ASSERT_EQUAL(10, reader->next(8));
+    CPPUNIT_ASSERT_EQUAL(2, (int)reader->read());
+  }
+
   void test_update() {
     auto plist_1 = create_case_1();
     int ret;
@@ -146,6 +182,71 @@ protected:
     reader->threshold(10); // no effect
   }
 
+  void test_estimate_kth_weight() {
+    // weights: 8, 4, 4, 2, 2
+    auto plist_1 = create_case_1();
+    int weight = 0;
+    // not estimated before frozen
+    CPPUNIT_ASSERT(!create_reader_shared(plist_1)->estimate_kth_weight(1, weight));
+
+    plist_1->freeze();
+    auto reader = create_reader_shared(plist_1);
+    CPPUNIT_ASSERT(!reader->estimate_kth_weight(0, weight));
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(1, weight));
+    CPPUNIT_ASSERT_EQUAL(8, weight);
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(2, weight));
+    CPPUNIT_ASSERT_EQUAL(4, weight);
+    // the 4th is used for the 3rd
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(3, weight));
+    CPPUNIT_ASSERT_EQUAL(2, weight);
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(4, weight));
+    CPPUNIT_ASSERT_EQUAL(2, weight);
+    // the least one is used beyond the stored ranks
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(5, weight));
+    CPPUNIT_ASSERT_EQUAL(2, weight);
+    CPPUNIT_ASSERT(!reader->estimate_kth_weight(6, weight));
+
+    // dropped once changed
+    plist_1->update(3, 1);
+    CPPUNIT_ASSERT(!create_reader_shared(plist_1)->estimate_kth_weight(1, weight));
+  }
+
+  void test_read_head() {
+    // short posting lists keep no head
+    auto plist_1 = create_case_1();
+    plist_1->freeze();
+    std::vector<std::pair<int, int>> head;
+    CPPUNIT_ASSERT(!create_reader_shared(plist_1)->read_head(1, head));
+
+    // weights: 1, 2, ..., 999, 0, 1, 2, ..., 999, 0
+    auto plist = create_factory()->create_posting_list();
+    for (int i = 1; i <= 2000; ++i) {
+      plist->update(i, i % 1000);
+    }
+    plist->freeze();
+    auto reader = create_reader_shared(plist);
+    CPPUNIT_ASSERT(!reader->read_head(0, head));
+    CPPUNIT_ASSERT(reader->read_head(3, head));
+    CPPUNIT_ASSERT_EQUAL(3, (int)head.size());
+    // earlier documents first if weights tie
+    CPPUNIT_ASSERT_EQUAL(999, head[0].first);
+    CPPUNIT_ASSERT_EQUAL(999, head[0].second);
+    CPPUNIT_ASSERT_EQUAL(1999, head[1].first);
+    CPPUNIT_ASSERT_EQUAL(999, head[1].second);
+    CPPUNIT_ASSERT_EQUAL(998, head[2].first);
+    CPPUNIT_ASSERT_EQUAL(998, head[2].second);
+    // the cursor is not moved
+    CPPUNIT_ASSERT_EQUAL(1, reader->next(0));
+
+    // the exact k-th weight is estimated from the head
+    int weight = 0;
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(3, weight));
+    CPPUNIT_ASSERT_EQUAL(998, weight);
+
+    // not enough postings in the head
+    CPPUNIT_ASSERT(!reader->read_head(1000, head));
+  }
+
   virtual std::unique_ptr<PostingListFactory<int, int>> create_factory() = 0;
 
   virtual std::unique_ptr<PostingListFactory<int, MockWeight>> create_factory_weight() = 0;
@@ -183,6 +284,9 @@ class BTreePostingListTest: public PostingListTest {
   CPPUNIT_TEST(test_upper_bound);
   CPPUNIT_TEST(test_upper_bound_2);
   CPPUNIT_TEST(test_threshold);
+  CPPUNIT_TEST(test_estimate_kth_weight);
+  CPPUNIT_TEST(test_read_head);
+  CPPUNIT_TEST(test_next_block);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -210,6 +314,7 @@ class MapPostingListTest: public PostingListTest {
   CPPUNIT_TEST(test_upper_bound);
   CPPUNIT_TEST(test_upper_bound_2);
   CPPUNIT_TEST(test_threshold);
+  CPPUNIT_TEST(test_next_block);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -226,7 +331,613 @@ protected:
   }
 };
 
+class SequentialPostingListTest: public PostingListTest {
+  CPPUNIT_TEST_SUITE(SequentialPostingListTest);
+  CPPUNIT_TEST(test_read);
+  CPPUNIT_TEST(test_read_2);
+  CPPUNIT_TEST(test_size);
+  CPPUNIT_TEST(test_next_block);
+  CPPUNIT_TEST(test_seek);
+  CPPUNIT_TEST(test_freezing_factory);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  SequentialPostingListTest() = default;
+  virtual ~SequentialPostingListTest() = default;
+
+protected:
+  void test_seek() {
+    // several blocks of samples, the doc ids are the even numbers and the weights are the doc ids
+    std::vector<std::pair<int, int>> posting;
+    for (int doc_id = 2; doc_id <= 1000; doc_id += 2) {
+      posting.emplace_back(doc_id, doc_id);
+    }
+    auto plist = create_factory()->create_posting_list(
+        std::unique_ptr<PostingListReader<int, int>>(new MockReader<int, int>(posting)));
+    auto reader = create_reader_shared(plist);
+    // within the block
+    CPPUNIT_ASSERT_EQUAL(2, reader->next(0));
+    CPPUNIT_ASSERT_EQUAL(4, reader->next(2));
+    CPPUNIT_ASSERT_EQUAL(6, reader->next(5));
+    // across one block, and several blocks
+    CPPUNIT_ASSERT_EQUAL(130, reader->next(128));
+    CPPUNIT_ASSERT_EQUAL(130, (int)reader->read());
+    CPPUNIT_ASSERT_EQUAL(702, reader->next(701));
+    // at the boundaries of the blocks
+    CPPUNIT_ASSERT_EQUAL(770, reader->next(768));
+    CPPUNIT_ASSERT_EQUAL(1000, reader->next(999));
+    CPPUNIT_ASSERT_EQUAL(0, reader->next(1000));
+
+    // the same postings as skipping one by one
+    reader = create_reader_shared(plist);
+    for (int current = 0, expected = 2; expected <= 1000; current += 7) {
+      while (expected <= current) {
+        expected += 2;
+      }
+      int doc_id = reader->next(current);
+      CPPUNIT_ASSERT_EQUAL(expected <= 1000 ? expected : 0, doc_id);
+      CPPUNIT_ASSERT(!doc_id || doc_id == reader->read());
+    }
+  }
+
+  void test_freezing_factory() {
+    SequentialFreezingFactory<int, int> factory(
+        std::unique_ptr<PostingListFactory<int, int>>(new BTreePostingListFactory<int, int>()));
+    auto plist = factory.create_posting_list();
+    CPPUNIT_ASSERT((dynamic_cast<BTreePostingList<int, int>*>(plist.get())));
+    plist->update(5, 4);
+    plist->update(1, 8);
+    plist->update(2, 2);
+    auto frozen = factory.freeze_posting_list(plist);
+    CPPUNIT_ASSERT((dynamic_cast<SequentialPostingList<int, int>*>(frozen.get())));
+    // the changes are made to a new posting list created from the frozen one
+    auto changed = factory.create_posting_list(create_reader_shared(frozen));
+    CPPUNIT_ASSERT_EQUAL(1, changed->remove(2));
+    auto reader = create_reader_shared(factory.freeze_posting_list(changed));
+    std::vector<std::pair<int, int>> results = read_all(*reader);
+    CPPUNIT_ASSERT_EQUAL(2, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(1, results[0].first);
+    CPPUNIT_ASSERT_EQUAL(8, results[0].second);
+    CPPUNIT_ASSERT_EQUAL(5, results[1].first);
+    CPPUNIT_ASSERT_EQUAL(8, (int)reader->upper_bound());
+  }
+
+  virtual std::unique_ptr<PostingListFactory<int, int>> create_factory() {
+    return std::unique_ptr<PostingListFactory<int, int>>(new SequentialPostingListFactory<int, int>());
+  }
+
+  virtual std::unique_ptr<PostingListFactory<int, MockWeight>> create_factory_weight() {
+    return std::unique_ptr<PostingListFactory<int, MockWeight>>(new SequentialPostingListFactory<int, MockWeight>());
+  }
+};
+
+class TieredPostingListTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TieredPostingListTest);
+  CPPUNIT_TEST(test_read_short);
+  CPPUNIT_TEST(test_update);
+  CPPUNIT_TEST(test_tiers);
+  CPPUNIT_TEST(test_tier_readers);
+  CPPUNIT_TEST(test_wand);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  TieredPostingListTest() = default;
+  virtual ~TieredPostingListTest() = default;
+
+protected:
+  typedef TieredPostingList<int, int> TieredList;
+
+  void test_read_short() {
+    // short posting lists are not split
+    auto plist = create_case(5, 8);
+    CPPUNIT_ASSERT_EQUAL(1, (int)plist->get_tier_count());
+    auto reader = create_reader_shared(plist);
+    std::vector<std::pair<int, int>> results = read_all(*reader);
+    CPPUNIT_ASSERT_EQUAL(5, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(1, results[0].first);
+    CPPUNIT_ASSERT_EQUAL(1, results[0].second);
+    CPPUNIT_ASSERT_EQUAL(5, results[4].first);
+    CPPUNIT_ASSERT_EQUAL(5, results[4].second);
+    CPPUNIT_ASSERT_EQUAL(5, (int)reader->upper_bound());
+    CPPUNIT_ASSERT_EQUAL(1, (int)plist->create_tier_readers(plist).size());
+  }
+
+  void test_update() {
+    auto plist = create_case(5, 8);
+    CPPUNIT_ASSERT_EQUAL(1, plist->update(3, 9));
+    CPPUNIT_ASSERT_EQUAL(1, plist->update(6, 2));
+    CPPUNIT_ASSERT_EQUAL(0, plist->update(0, 1));
+    CPPUNIT_ASSERT_EQUAL(1, plist->remove(1));
+    CPPUNIT_ASSERT_EQUAL(0, plist->remove(7));
+    // not readable until frozen
+    CPPUNIT_ASSERT(!create_reader_shared(plist));
+    CPPUNIT_ASSERT(plist->create_tier_readers(plist).empty());
+
+    plist->freeze();
+    auto reader = create_reader_shared(plist);
+    std::vector<std::pair<int, int>> results = read_all(*reader);
+    CPPUNIT_ASSERT_EQUAL(5, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(2, results[0].first);
+    CPPUNIT_ASSERT_EQUAL(3, results[1].first);
+    CPPUNIT_ASSERT_EQUAL(9, results[1].second);
+    CPPUNIT_ASSERT_EQUAL(6, results[4].first);
+    CPPUNIT_ASSERT_EQUAL(9, (int)reader->upper_bound());
+
+    // removing all
+    for (int i = 2; i <= 6; ++i) {
+      plist->remove(i);
+    }
+    plist->freeze();
+    CPPUNIT_ASSERT(plist->empty());
+  }
+
+  void test_tiers() {
+    // weights: 1, 2, ..., 999, 0, 1, 2, ..., 999, 0, ...
+    auto plist = create_case(10000, 1000);
+    // tiers of the weights not less than 984 (the 156th), 875 (the 1250th), and the others
+    CPPUNIT_ASSERT_EQUAL(3, (int)plist->get_tier_count());
+
+    // reading all tiers merged
+    auto reader = create_reader_shared(plist);
+    CPPUNIT_ASSERT_EQUAL(10000, (int)reader->size());
+    CPPUNIT_ASSERT_EQUAL(999, (int)reader->upper_bound());
+    std::vector<std::pair<int, int>> results = read_all(*reader);
+    CPPUNIT_ASSERT_EQUAL(10000, (int)results.size());
+    for (int i = 0; i < 10000; ++i) {
+      CPPUNIT_ASSERT_EQUAL(i + 1, results[i].first);
+      CPPUNIT_ASSERT_EQUAL((i + 1) % 1000, results[i].second);
+    }
+
+    // the k-th weight is bounded by the least weight of the tiers holding k postings
+    int weight = 0;
+    CPPUNIT_ASSERT(!reader->estimate_kth_weight(0, weight));
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(10, weight));
+    CPPUNIT_ASSERT_EQUAL(984, weight);
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(1000, weight));
+    CPPUNIT_ASSERT_EQUAL(875, weight);
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(10000, weight));
+    CPPUNIT_ASSERT_EQUAL(0, weight);
+    CPPUNIT_ASSERT(!reader->estimate_kth_weight(10001, weight));
+  }
+
+  void test_tier_readers() {
+    auto plist = create_case(10000, 1000);
+    auto readers = plist->create_tier_readers(plist);
+    CPPUNIT_ASSERT_EQUAL(3, (int)readers.size());
+
+    size_t total = 0;
+    int last_lower_bound = 1000;
+    for (auto& reader: readers) {
+      total += reader->size();
+      // tiers from top to bottom, sorted by doc id
+      CPPUNIT_ASSERT(reader->upper_bound() <= last_lower_bound);
+      int lower_bound = 0;
+      CPPUNIT_ASSERT(reader->estimate_kth_weight(reader->size(), lower_bound));
+      std::vector<std::pair<int, int>> results = read_all(*reader);
+      CPPUNIT_ASSERT_EQUAL(reader->size(), results.size());
+      for (size_t i = 0; i < results.size(); ++i) {
+        CPPUNIT_ASSERT(i == 0 || results[i - 1].first < results[i].first);
+        CPPUNIT_ASSERT(results[i].second >= lower_bound);
+        CPPUNIT_ASSERT(results[i].second <= reader->upper_bound());
+      }
+      last_lower_bound = lower_bound;
+    }
+    CPPUNIT_ASSERT_EQUAL(10000, (int)total);
+
+    // skipping ahead
+    readers = plist->create_tier_readers(plist);
+    CPPUNIT_ASSERT_EQUAL(984, readers[0]->next(0));
+    CPPUNIT_ASSERT_EQUAL(5984, readers[0]->next(5000));
+    CPPUNIT_ASSERT_EQUAL(984, readers[0]->read());
+    CPPUNIT_ASSERT_EQUAL(5985, readers[0]->next(5984));
+    CPPUNIT_ASSERT_EQUAL(0, readers[0]->next(9999));
+
+    // read by blocks, the same as one by one
+    readers = plist->create_tier_readers(plist);
+    auto expected_readers = plist->create_tier_readers(plist);
+    for (size_t t = 0; t < readers.size(); ++t) {
+      std::vector<std::pair<int, int>> expected = read_all(*expected_readers[t]);
+      std::vector<std::pair<int, int>> results;
+      int doc_ids[64];
+      int weights[64];
+      int current = 0;
+      for (size_t n = readers[t]->next_block(current, doc_ids, weights, 64); n > 0;
+          n = readers[t]->next_block(current, doc_ids, weights, 64)) {
+        for (size_t i = 0; i < n; ++i) {
+          results.emplace_back(doc_ids[i], weights[i]);
+        }
+        current = doc_ids[n - 1];
+      }
+      CPPUNIT_ASSERT(expected == results);
+    }
+  }
+
+  void test_wand() {
+    // the tiers read by WAND make the same top results as the whole posting list
+    auto plist = create_case(10000, 997);
+    auto expected_reader = create_reader_shared(plist);
+    auto expected = read_topn(*expected_reader, 100);
+
+    std::vector<std::unique_ptr<PostingListReader<int, int>>> readers;
+    for (auto& reader: plist->create_tier_readers(plist)) {
+      readers.emplace_back(new ReaderWrapper(std::move(reader)));
+    }
+    WandReader<int, int> wand(std::move(readers));
+    auto results = read_topn(wand, 100);
+    CPPUNIT_ASSERT_EQUAL(expected.size(), results.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      CPPUNIT_ASSERT_EQUAL(expected[i].second, results[i].second);
+    }
+  }
+
+private:
+  // converts the weights to scores
+  class ReaderWrapper: public PostingListReader<int, int> {
+  public:
+    ReaderWrapper(std::unique_ptr<PostingListReader<int, const int&>> reader)
+    : reader_(std::move(reader)) {
+    }
+
+    virtual int next(int current) {
+      return reader_->next(current);
+    }
+
+    virtual int read() {
+      return reader_->read();
+    }
+
+    virtual int upper_bound() {
+      return reader_->upper_bound();
+    }
+
+    virtual size_t size() const {
+      return reader_->size();
+    }
+
+  private:
+    std::unique_ptr<PostingListReader<int, const int&>> reader_;
+  };
+
+  // weights of docs 1, 2, ..., size are doc_id % mod.
+  std::shared_ptr<TieredList> create_case(int size, int mod) {
+    auto plist = std::make_shared<TieredList>();
+    for (int i = 1; i <= size; ++i) {
+      plist->update(i, i % mod);
+    }
+    plist->freeze();
+    return plist;
+  }
+};
+
+class ConstantPostingListTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(ConstantPostingListTest);
+  CPPUNIT_TEST(test_read);
+  CPPUNIT_TEST(test_seek);
+  CPPUNIT_TEST(test_next_block);
+  CPPUNIT_TEST(test_head);
+  CPPUNIT_TEST(test_not_constant);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  ConstantPostingListTest() = default;
+  virtual ~ConstantPostingListTest() = default;
+
+protected:
+  typedef PostingList<int, int> PList;
+
+  void test_read() {
+    auto plist = create_case(5);
+    CPPUNIT_ASSERT((dynamic_cast<ConstantPostingList<int, int>*>(plist.get())));
+    auto reader = create_reader_shared(plist);
+    std::vector<std::pair<int, int>> results = read_all(*reader);
+    CPPUNIT_ASSERT_EQUAL(5, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(3, results[0].first);
+    CPPUNIT_ASSERT_EQUAL(1, results[0].second);
+    CPPUNIT_ASSERT_EQUAL(15, results[4].first);
+    CPPUNIT_ASSERT_EQUAL(1, results[4].second);
+    CPPUNIT_ASSERT_EQUAL(1, (int)reader->upper_bound());
+    CPPUNIT_ASSERT_EQUAL(5, (int)reader->size());
+    // read-only
+    CPPUNIT_ASSERT_EQUAL(0, plist->update(4, 1));
+    CPPUNIT_ASSERT_EQUAL(0, plist->remove(3));
+  }
+
+  void test_seek() {
+    // several blocks of doc ids
+    auto plist = create_case(500);
+    auto reader = create_reader_shared(plist);
+    CPPUNIT_ASSERT_EQUAL(3, reader->next(0));
+    CPPUNIT_ASSERT_EQUAL(195, reader->next(192));
+    CPPUNIT_ASSERT_EQUAL(1200, reader->next(1199));
+    CPPUNIT_ASSERT_EQUAL(1, (int)reader->read());
+    CPPUNIT_ASSERT_EQUAL(1500, reader->next(1497));
+    CPPUNIT_ASSERT_EQUAL(0, reader->next(1500));
+  }
+
+  void test_next_block() {
+    auto plist = create_case(5);
+    auto reader = create_reader_shared(plist);
+    int doc_ids[3];
+    int weights[3];
+    CPPUNIT_ASSERT_EQUAL(3, (int)reader->next_block(4, doc_ids, weights, 3));
+    CPPUNIT_ASSERT_EQUAL(6, doc_ids[0]);
+    CPPUNIT_ASSERT_EQUAL(12, doc_ids[2]);
+    CPPUNIT_ASSERT_EQUAL(1, weights[2]);
+    CPPUNIT_ASSERT_EQUAL(1, (int)reader->next_block(12, doc_ids, weights, 3));
+    CPPUNIT_ASSERT_EQUAL(15, doc_ids[0]);
+    CPPUNIT_ASSERT_EQUAL(0, (int)reader->next_block(15, doc_ids, weights, 3));
+  }
+
+  void test_head() {
+    auto plist = create_case(5);
+    auto reader = create_reader_shared(plist);
+    int weight = 0;
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(5, weight));
+    CPPUNIT_ASSERT_EQUAL(1, weight);
+    CPPUNIT_ASSERT(!reader->estimate_kth_weight(6, weight));
+    std::vector<std::pair<int, int>> head;
+    CPPUNIT_ASSERT(reader->read_head(2, head));
+    CPPUNIT_ASSERT_EQUAL(2, (int)head.size());
+    CPPUNIT_ASSERT_EQUAL(3, head[0].first);
+    CPPUNIT_ASSERT_EQUAL(6, head[1].first);
+    CPPUNIT_ASSERT_EQUAL(1, head[1].second);
+  }
+
+  void test_not_constant() {
+    ConstantFreezingFactory<int, int> factory(
+        std::unique_ptr<PostingListFactory<int, int>>(new BTreePostingListFactory<int, int>()));
+    auto plist = factory.create_posting_list();
+    plist->update(1, 1);
+    plist->update(2, 3);
+    auto frozen = factory.freeze_posting_list(plist);
+    // converted into a sequential posting list keeping the weights
+    CPPUNIT_ASSERT((dynamic_cast<SequentialPostingList<int, int>*>(frozen.get())));
+    auto reader = create_reader_shared(frozen);
+    CPPUNIT_ASSERT_EQUAL(2, reader->next(1));
+    CPPUNIT_ASSERT_EQUAL(3, (int)reader->read());
+  }
+
+private:
+  // the multiples of 3 up to 3 * size, all of weight 1
+  std::shared_ptr<PList> create_case(int size) {
+    ConstantFreezingFactory<int, int> factory(
+        std::unique_ptr<PostingListFactory<int, int>>(new BTreePostingListFactory<int, int>()));
+    auto plist = factory.create_posting_list();
+    for (int i = 1; i <= size; ++i) {
+      plist->update(i * 3, 1);
+    }
+    return factory.freeze_posting_list(plist);
+  }
+};
+
+class SmallPostingListTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(SmallPostingListTest);
+  CPPUNIT_TEST(test_read);
+  CPPUNIT_TEST(test_next_block);
+  CPPUNIT_TEST(test_estimate_kth_weight);
+  CPPUNIT_TEST(test_promote);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  SmallPostingListTest() = default;
+  virtual ~SmallPostingListTest() = default;
+
+protected:
+  typedef SmallPostingList<int, int> SmallList;
+
+  void test_read() {
+    auto plist = create_case(5);
+    CPPUNIT_ASSERT((dynamic_cast<SmallList*>(plist.get())));
+    auto reader = create_reader_shared(plist);
+    std::vector<std::pair<int, int>> results = read_all(*reader);
+    CPPUNIT_ASSERT_EQUAL(5, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(2, results[0].first);
+    CPPUNIT_ASSERT_EQUAL(1, results[0].second);
+    CPPUNIT_ASSERT_EQUAL(10, results[4].first);
+    CPPUNIT_ASSERT_EQUAL(5, results[4].second);
+    CPPUNIT_ASSERT_EQUAL(5, (int)reader->upper_bound());
+    CPPUNIT_ASSERT_EQUAL(5, (int)reader->size());
+
+    // skipping
+    reader = create_reader_shared(plist);
+    CPPUNIT_ASSERT_EQUAL(6, reader->next(5));
+    CPPUNIT_ASSERT_EQUAL(3, (int)reader->read());
+    CPPUNIT_ASSERT_EQUAL(6, reader->next(4));
+    CPPUNIT_ASSERT_EQUAL(10, reader->next(9));
+    CPPUNIT_ASSERT_EQUAL(0, reader->next(10));
+    // read-only
+    CPPUNIT_ASSERT_EQUAL(0, plist->update(3, 1));
+    CPPUNIT_ASSERT_EQUAL(0, plist->remove(2));
+  }
+
+  void test_next_block() {
+    auto plist = create_case(5);
+    auto reader = create_reader_shared(plist);
+    int doc_ids[4];
+    int weights[4];
+    CPPUNIT_ASSERT_EQUAL(4, (int)reader->next_block(3, doc_ids, weights, 4));
+    CPPUNIT_ASSERT_EQUAL(4, doc_ids[0]);
+    CPPUNIT_ASSERT_EQUAL(2, weights[0]);
+    CPPUNIT_ASSERT_EQUAL(10, doc_ids[3]);
+    CPPUNIT_ASSERT_EQUAL(5, (int)reader->read());
+    CPPUNIT_ASSERT_EQUAL(0, (int)reader->next_block(10, doc_ids, weights, 4));
+  }
+
+  void test_estimate_kth_weight() {
+    auto plist = create_case(5);
+    auto reader = create_reader_shared(plist);
+    int weight = 0;
+    CPPUNIT_ASSERT(!reader->estimate_kth_weight(0, weight));
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(1, weight));
+    CPPUNIT_ASSERT_EQUAL(5, weight);
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(2, weight));
+    CPPUNIT_ASSERT_EQUAL(4, weight);
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(5, weight));
+    CPPUNIT_ASSERT_EQUAL(1, weight);
+    CPPUNIT_ASSERT(!reader->estimate_kth_weight(6, weight));
+
+    // the same weights are counted one by one
+    auto same = factory_.create_posting_list();
+    same->update(1, 3);
+    same->update(2, 7);
+    same->update(3, 3);
+    reader = create_reader_shared(factory_.freeze_posting_list(same));
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(2, weight));
+    CPPUNIT_ASSERT_EQUAL(3, weight);
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(3, weight));
+    CPPUNIT_ASSERT_EQUAL(3, weight);
+
+    // the threshold of MaxScore over small posting lists starts from the estimation
+    typedef DotProductReader<int, int, const int&> TermReader;
+    std::vector<std::unique_ptr<PostingListReader<int, int>>> readers;
+    readers.emplace_back(new TermReader(create_reader_shared(plist), 1));
+    readers.emplace_back(new TermReader(create_reader_shared(create_case(3)), 1));
+    MaxScoreReader<int, int> max_score(std::move(readers));
+    int score = 0;
+    CPPUNIT_ASSERT(max_score.estimate_kth_weight(2, score));
+    CPPUNIT_ASSERT_EQUAL(4, score);
+  }
+
+  void test_promote() {
+    // too many postings for a small posting list
+    auto plist = create_case(SmallList::kMaxSize + 1);
+    CPPUNIT_ASSERT((dynamic_cast<BTreePostingList<int, int>*>(plist.get())));
+    CPPUNIT_ASSERT_EQUAL((int)SmallList::kMaxSize + 1, (int)create_reader_shared(plist)->size());
+
+    // a small posting list growing larger, changed by the other factory
+    plist = create_case(SmallList::kMaxSize);
+    CPPUNIT_ASSERT((dynamic_cast<SmallList*>(plist.get())));
+    auto changed = factory_.create_posting_list(create_reader_shared(plist));
+    CPPUNIT_ASSERT_EQUAL(1, changed->update(100, 7));
+    plist = factory_.freeze_posting_list(changed);
+    CPPUNIT_ASSERT((dynamic_cast<BTreePostingList<int, int>*>(plist.get())));
+    auto reader = create_reader_shared(plist);
+    CPPUNIT_ASSERT_EQUAL(100, reader->next(2 * (int)SmallList::kMaxSize));
+    CPPUNIT_ASSERT_EQUAL(7, (int)reader->read());
+  }
+
+private:
+  // doc ids 2, 4, ..., 2 * size, of weights 1, 2, ..., size
+  std::shared_ptr<PostingList<int, int>> create_case(size_t size) {
+    auto plist = factory_.create_posting_list();
+    for (int i = 1; i <= (int)size; ++i) {
+      plist->update(i * 2, i);
+    }
+    return factory_.freeze_posting_list(plist);
+  }
+
+  SmallFreezingFactory<int, int> factory_{std::make_shared<BTreePostingListFactory<int, int>>()};
+};
+
+class QuantizedPostingListTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(QuantizedPostingListTest);
+  CPPUNIT_TEST(test_read);
+  CPPUNIT_TEST(test_next_block);
+  CPPUNIT_TEST(test_same_weights);
+  CPPUNIT_TEST(test_change);
+  CPPUNIT_TEST(test_change_range);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  QuantizedPostingListTest() = default;
+  virtual ~QuantizedPostingListTest() = default;
+
+protected:
+  typedef PostingList<int, double> PList;
+  typedef QuantizedFreezingFactory<int, double, uint8_t> Factory;
+
+  void test_read() {
+    // weights from 0.5 to 3.0, by a step of 1/64 for each code
+    auto plist = create_case({{1, 0.5}, {3, 3.0}, {4, 1.234}, {7, 2.0}, {9, 0.5}});
+    CPPUNIT_ASSERT((dynamic_cast<QuantizedPostingList<int, double, uint8_t>*>(plist.get())));
+    auto reader = create_reader_shared(plist);
+    std::vector<std::pair<int, double>> results = read_all(*reader);
+    CPPUNIT_ASSERT_EQUAL(5, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(1, results[0].first);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, results[0].second, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, results[1].second, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.234, results[2].second, 1.0 / 64 / 2);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, results[3].second, 1e-9);
+    CPPUNIT_ASSERT_EQUAL(9, results[4].first);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, reader->upper_bound(), 1e-9);
+
+    reader = create_reader_shared(plist);
+    CPPUNIT_ASSERT_EQUAL(4, reader->next(3));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(results[2].second, reader->read(), 1e-12);
+    CPPUNIT_ASSERT_EQUAL(9, reader->next(8));
+    CPPUNIT_ASSERT_EQUAL(0, reader->next(9));
+  }
+
+  void test_next_block() {
+    auto plist = create_case({{1, 0.5}, {3, 3.0}, {4, 1.234}, {7, 2.0}, {9, 0.5}});
+    auto reader = create_reader_shared(plist);
+    int doc_ids[3];
+    double weights[3];
+    CPPUNIT_ASSERT_EQUAL(3, (int)reader->next_block(2, doc_ids, weights, 3));
+    CPPUNIT_ASSERT_EQUAL(3, doc_ids[0]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, weights[0], 1e-9);
+    CPPUNIT_ASSERT_EQUAL(7, doc_ids[2]);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(reader->read(), weights[2], 1e-12);
+  }
+
+  void test_same_weights() {
+    auto plist = create_case({{1, 0.7}, {2, 0.7}});
+    auto reader = create_reader_shared(plist);
+    CPPUNIT_ASSERT_EQUAL(1, reader->next(0));
+    CPPUNIT_ASSERT_EQUAL(0.7, reader->read());
+    CPPUNIT_ASSERT_EQUAL(0.7, reader->upper_bound());
+  }
+
+  void test_change() {
+    // changes start from the decoded weights, which are not quantized again by the same range
+    auto plist = create_case({{1, 0.5}, {3, 3.0}, {4, 1.234}});
+    auto reader = create_reader_shared(plist);
+    CPPUNIT_ASSERT_EQUAL(4, reader->next(3));
+    double decoded = reader->read();
+    auto changed = factory_.create_posting_list(create_reader_shared(plist));
+    CPPUNIT_ASSERT_EQUAL(1, changed->remove(1));
+    CPPUNIT_ASSERT_EQUAL(1, changed->update(2, 0.5));
+    reader = create_reader_shared(factory_.freeze_posting_list(changed));
+    CPPUNIT_ASSERT_EQUAL(4, reader->next(3));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(decoded, reader->read(), 1e-9);
+  }
+
+  void test_change_range() {
+    // the range is changed by each change, and the errors of the weights not changed are not compounded
+    std::vector<std::pair<int, double>> exact = {{1, 0.5}, {2, 0.731}, {3, 1.234}, {4, 2.0}, {5, 2.987}};
+    auto plist = create_case(exact);
+    for (int i = 0; i < 100; ++i) {
+      auto changed = factory_.create_posting_list(create_reader_shared(plist));
+      CPPUNIT_ASSERT_EQUAL(1, changed->update(100, i % 2 ? 0.2 + i * 0.013 : 3.0 + i * 0.021));
+      plist = factory_.freeze_posting_list(changed);
+    }
+    // the greatest range is less than 6.0, by a step of 1/32 for each code
+    auto results = read_all(*create_reader_shared(plist));
+    CPPUNIT_ASSERT_EQUAL(6, (int)results.size());
+    for (size_t i = 0; i < exact.size(); ++i) {
+      CPPUNIT_ASSERT_EQUAL(exact[i].first, results[i].first);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(exact[i].second, results[i].second, 1.0 / 32);
+    }
+  }
+
+private:
+  std::shared_ptr<PList> create_case(const std::vector<std::pair<int, double>>& posting) {
+    auto plist = factory_.create_posting_list();
+    for (const auto& pair: posting) {
+      plist->update(pair.first, pair.second);
+    }
+    return factory_.freeze_posting_list(plist);
+  }
+
+  Factory factory_{std::unique_ptr<PostingListFactory<int, double>>(new BTreePostingListFactory<int, double>())};
+};
+
 CPPUNIT_TEST_SUITE_REGISTRATION(BTreePostingListTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(MapPostingListTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(SequentialPostingListTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(TieredPostingListTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(ConstantPostingListTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(SmallPostingListTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(QuantizedPostingListTest);
 
 } /* namespace redgiant */
@@ -0,0 +1,190 @@
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "mock_reader.h"
+
+#include "core/reader/batch_reader.h"
+#include "core/reader/dot_product_reader.h"
+#include "core/reader/reader_utils.h"
+#include "core/reader/taat_reader.h"
+
+namespace redgiant {
+class BatchReaderTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(BatchReaderTest);
+  CPPUNIT_TEST(test_read_batch);
+  CPPUNIT_TEST(test_min_score);
+  CPPUNIT_TEST(test_priors);
+  CPPUNIT_TEST(test_random);
+  CPPUNIT_TEST(test_stop);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  typedef PostingListReader<int, int> Reader;
+  typedef std::vector<std::pair<int, int>> Posting;
+  typedef std::vector<std::vector<std::pair<size_t, int>>> TermQueries;
+
+  BatchReaderTest() = default;
+  virtual ~BatchReaderTest() = default;
+
+protected:
+  void test_read_batch() {
+    std::vector<std::unique_ptr<Reader>> readers = create_readers({
+      {{1, 1}, {2, 2}, {4, 3}},
+      {{2, 1}, {3, 5}},
+      {{1, 2}, {4, 1}},
+    });
+    // query 0: term 0 * 1 + term 1 * 2, query 1: term 1 * 1 + term 2 * 3, query 2: none
+    TermQueries term_queries = {{{0, 1}}, {{0, 2}, {1, 1}}, {{1, 3}}};
+    std::vector<std::vector<std::pair<int, int>>> results;
+    bool stopped = true;
+    read_batch_topn(readers, term_queries, {2, 10, 5}, {0, 0, 0}, [] { return false; }, stopped, results);
+
+    CPPUNIT_ASSERT(!stopped);
+    CPPUNIT_ASSERT_EQUAL(3, (int)results.size());
+    // query 0: 1 -> 1, 2 -> 4, 3 -> 10, 4 -> 3
+    CPPUNIT_ASSERT_EQUAL(2, (int)results[0].size());
+    CPPUNIT_ASSERT_EQUAL(3, results[0][0].first);
+    CPPUNIT_ASSERT_EQUAL(10, results[0][0].second);
+    CPPUNIT_ASSERT_EQUAL(2, results[0][1].first);
+    CPPUNIT_ASSERT_EQUAL(4, results[0][1].second);
+    // query 1: 1 -> 6, 2 -> 1, 3 -> 5, 4 -> 3
+    CPPUNIT_ASSERT_EQUAL(4, (int)results[1].size());
+    CPPUNIT_ASSERT_EQUAL(1, results[1][0].first);
+    CPPUNIT_ASSERT_EQUAL(6, results[1][0].second);
+    CPPUNIT_ASSERT_EQUAL(2, results[1][3].first);
+    CPPUNIT_ASSERT_EQUAL(1, results[1][3].second);
+    CPPUNIT_ASSERT_EQUAL(0, (int)results[2].size());
+  }
+
+  void test_min_score() {
+    std::vector<std::unique_ptr<Reader>> readers = create_readers({
+      {{1, 1}, {2, 2}, {4, 3}},
+    });
+    // the same query, with different min scores
+    TermQueries term_queries = {{{0, 1}, {1, 1}}};
+    std::vector<std::vector<std::pair<int, int>>> results;
+    bool stopped = true;
+    read_batch_topn(readers, term_queries, {10, 10}, {1, 2}, [] { return false; }, stopped, results);
+    CPPUNIT_ASSERT_EQUAL(2, (int)results[0].size());
+    CPPUNIT_ASSERT_EQUAL(3, results[0][0].second);
+    CPPUNIT_ASSERT_EQUAL(2, results[0][1].second);
+    CPPUNIT_ASSERT_EQUAL(1, (int)results[1].size());
+    CPPUNIT_ASSERT_EQUAL(3, results[1][0].second);
+  }
+
+  void test_priors() {
+    std::vector<std::unique_ptr<Reader>> readers = create_readers({
+      {{1, 1}, {2, 2}, {4, 3}},
+      {{1, 10}, {3, 20}, {4, 30}, {5, 40}},
+    });
+    // query 0: term 0 * 1 + prior term 1 * 1, query 1: term 1 * 2 without other terms
+    TermQueries term_queries = {{{0, 1}}, {{1, 2}}};
+    TermQueries prior_queries = {{}, {{0, 1}}};
+    std::vector<std::vector<std::pair<int, int>>> results;
+    bool stopped = true;
+    read_batch_topn(readers, term_queries, prior_queries, {10, 10}, {0, 0}, [] { return false; }, stopped, results);
+    CPPUNIT_ASSERT(!stopped);
+    // query 0: 1 -> 11, 2 -> 2, 4 -> 33, the documents found by the prior only are not read
+    CPPUNIT_ASSERT_EQUAL(3, (int)results[0].size());
+    CPPUNIT_ASSERT_EQUAL(4, results[0][0].first);
+    CPPUNIT_ASSERT_EQUAL(33, results[0][0].second);
+    CPPUNIT_ASSERT_EQUAL(1, results[0][1].first);
+    CPPUNIT_ASSERT_EQUAL(11, results[0][1].second);
+    CPPUNIT_ASSERT_EQUAL(2, results[0][2].second);
+    // query 1: 1 -> 20, 3 -> 40, 4 -> 60, 5 -> 80
+    CPPUNIT_ASSERT_EQUAL(4, (int)results[1].size());
+    CPPUNIT_ASSERT_EQUAL(5, results[1][0].first);
+    CPPUNIT_ASSERT_EQUAL(80, results[1][0].second);
+
+    // the prior is not searched by any query
+    readers = create_readers({
+      {{1, 1}, {2, 2}, {4, 3}},
+      {{1, 10}, {3, 20}, {4, 30}, {5, 40}},
+    });
+    term_queries = {{{0, 1}}, {}};
+    read_batch_topn(readers, term_queries, prior_queries, {10}, {0}, [] { return false; }, stopped, results);
+    CPPUNIT_ASSERT_EQUAL(3, (int)results[0].size());
+    CPPUNIT_ASSERT_EQUAL(4, results[0][0].first);
+    CPPUNIT_ASSERT_EQUAL(33, results[0][0].second);
+    CPPUNIT_ASSERT_EQUAL(11, results[0][1].second);
+    CPPUNIT_ASSERT_EQUAL(2, results[0][2].second);
+  }
+
+  void test_random() {
+    // the same top scores as executing the queries one by one
+    srand(13);
+    std::vector<Posting> postings(20);
+    for (auto& posting: postings) {
+      for (int doc_id = 1; doc_id <= 500; ++doc_id) {
+        if (rand() % 5 == 0) {
+          posting.emplace_back(doc_id, 1 + rand() % 10);
+        }
+      }
+    }
+    size_t query_num = 30;
+    TermQueries term_queries(postings.size());
+    std::vector<std::vector<std::pair<size_t, int>>> query_terms(query_num);
+    for (size_t query = 0; query < query_num; ++query) {
+      for (size_t term = 0; term < postings.size(); ++term) {
+        if (rand() % 4 == 0) {
+          int weight = 1 + rand() % 5;
+          term_queries[term].emplace_back(query, weight);
+          query_terms[query].emplace_back(term, weight);
+        }
+      }
+    }
+    std::vector<std::unique_ptr<Reader>> readers = create_readers(postings);
+    std::vector<std::vector<std::pair<int, int>>> results;
+    bool stopped = true;
+    read_batch_topn(readers, term_queries, std::vector<size_t>(query_num, 10), std::vector<int>(query_num, 0),
+        [] { return false; }, stopped, results);
+
+    for (size_t query = 0; query < query_num; ++query) {
+      std::vector<std::unique_ptr<Reader>> query_readers;
+      for (auto& term: query_terms[query]) {
+        query_readers.emplace_back(new DotProductReader<int, int, int, int>(
+            std::unique_ptr<Reader>(new MockReader<int, int>(postings[term.first])), term.second));
+      }
+      TaatReader<int, int> expected_reader(std::move(query_readers));
+      auto expected = read_topn(expected_reader, 10);
+      CPPUNIT_ASSERT_EQUAL(expected.size(), results[query].size());
+      for (size_t i = 0; i < expected.size(); ++i) {
+        CPPUNIT_ASSERT_EQUAL(expected[i].second, results[query][i].second);
+      }
+    }
+  }
+
+  void test_stop() {
+    std::vector<std::unique_ptr<Reader>> readers = create_readers({
+      {{1, 1}, {2, 2}, {4, 3}},
+      {{2, 1}, {3, 5}},
+    });
+    TermQueries term_queries = {{{0, 1}}, {{0, 1}}};
+    std::vector<std::vector<std::pair<int, int>>> results;
+    bool stopped = false;
+    // stopped after the second document
+    read_batch_topn(readers, term_queries, {10}, {0}, [] { return true; }, stopped, results, 2);
+    CPPUNIT_ASSERT(stopped);
+    CPPUNIT_ASSERT_EQUAL(2, (int)results[0].size());
+    CPPUNIT_ASSERT_EQUAL(2, results[0][0].first);
+    CPPUNIT_ASSERT_EQUAL(3, results[0][0].second);
+  }
+
+private:
+  std::vector<std::unique_ptr<Reader>> create_readers(const std::vector<Posting>& postings) {
+    std::vector<std::unique_ptr<Reader>> readers;
+    for (auto& posting: postings) {
+      readers.emplace_back(new MockReader<int, int>(posting));
+    }
+    return readers;
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BatchReaderTest);
+
+} /* namespace redgiant */
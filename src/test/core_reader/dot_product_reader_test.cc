@@ -16,6 +16,8 @@ class DotProductReaderTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(test_read_all);
   CPPUNIT_TEST(test_upper_bound);
   CPPUNIT_TEST(test_size);
+  CPPUNIT_TEST(test_next_block);
+  CPPUNIT_TEST(test_multiply_block);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -53,6 +55,62 @@ protected:
     CPPUNIT_ASSERT_EQUAL(5, size);
   }
 
+  void test_next_block() {
+    auto reader = create_case_1(5);
+    int doc_ids[4];
+    int scores[4];
+    CPPUNIT_ASSERT_EQUAL(4, (int)reader->next_block(0, doc_ids, scores, 4));
+    CPPUNIT_ASSERT_EQUAL(1, doc_ids[0]);
+    CPPUNIT_ASSERT_EQUAL(40, scores[0]);
+    CPPUNIT_ASSERT_EQUAL(8, doc_ids[3]);
+    CPPUNIT_ASSERT_EQUAL(20, scores[3]);
+    CPPUNIT_ASSERT_EQUAL(1, (int)reader->next_block(8, doc_ids, scores, 4));
+    CPPUNIT_ASSERT_EQUAL(10, doc_ids[0]);
+    CPPUNIT_ASSERT_EQUAL(10, scores[0]);
+    CPPUNIT_ASSERT_EQUAL(0, (int)reader->next_block(10, doc_ids, scores, 4));
+  }
+
+  void test_multiply_block() {
+    // vectorized and the remaining ones
+    std::vector<double> weights;
+    for (int i = 0; i < 11; ++i) {
+      weights.push_back(i * 0.5);
+    }
+    std::vector<double> scores(weights.size());
+    multiply_block(weights.data(), weights.size(), 3.0, scores.data());
+    for (size_t i = 0; i < weights.size(); ++i) {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(weights[i] * 3.0, scores[i], 1e-12);
+    }
+
+    // single precision weights scored in double
+    std::vector<float> float_weights(weights.begin(), weights.end());
+    multiply_block(float_weights.data(), float_weights.size(), 0.1, scores.data());
+    for (size_t i = 0; i < float_weights.size(); ++i) {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL((double)float_weights[i] * 0.1, scores[i], 1e-12);
+    }
+
+    // scored by blocks, the same as one by one
+    std::vector<std::pair<int, double>> posting;
+    for (int i = 1; i <= 100; ++i) {
+      posting.emplace_back(i, i * 0.25);
+    }
+    DotProductReader<int, double, double> reader(
+        std::unique_ptr<PostingListReader<int, double>>(new MockReader<int, double>(posting)), 2.0);
+    int doc_ids[7];
+    double block_scores[7];
+    int current = 0;
+    size_t total = 0;
+    for (size_t n = reader.next_block(current, doc_ids, block_scores, 7); n > 0;
+        n = reader.next_block(current, doc_ids, block_scores, 7)) {
+      for (size_t i = 0; i < n; ++i) {
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(doc_ids[i] * 0.5, block_scores[i], 1e-12);
+      }
+      current = doc_ids[n - 1];
+      total += n;
+    }
+    CPPUNIT_ASSERT_EQUAL(100, (int)total);
+  }
+
 private:
   std::unique_ptr<DotProductReader<int, int, int>> create_case_1(int query) {
     std::unique_ptr<PostingListReader<int, int>> raw_reader (
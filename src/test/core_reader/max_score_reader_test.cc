@@ -0,0 +1,146 @@
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "mock_reader.h"
+
+#include "core/reader/max_score_reader.h"
+#include "core/reader/max_score_reader-inl.h"
+#include "core/reader/reader_utils.h"
+#include "core/reader/taat_reader.h"
+
+namespace redgiant {
+class MaxScoreReaderTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(MaxScoreReaderTest);
+  CPPUNIT_TEST(test_read_all);
+  CPPUNIT_TEST(test_upper_bound);
+  CPPUNIT_TEST(test_threshold);
+  CPPUNIT_TEST(test_essential);
+  CPPUNIT_TEST(test_read_topn);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  MaxScoreReaderTest() = default;
+  virtual ~MaxScoreReaderTest() = default;
+
+protected:
+  void test_read_all() {
+    auto reader = create_case_1();
+    std::vector<std::pair<int, int>> results = read_all(*reader);
+
+    CPPUNIT_ASSERT_EQUAL(8, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(1, results[0].first);
+    CPPUNIT_ASSERT_EQUAL(10, results[0].second);
+    CPPUNIT_ASSERT_EQUAL(2, results[1].first);
+    CPPUNIT_ASSERT_EQUAL(2, results[1].second);
+    CPPUNIT_ASSERT_EQUAL(3, results[2].first);
+    CPPUNIT_ASSERT_EQUAL(2, results[2].second);
+    CPPUNIT_ASSERT_EQUAL(5, results[3].first);
+    CPPUNIT_ASSERT_EQUAL(20, results[3].second);
+    CPPUNIT_ASSERT_EQUAL(7, results[4].first);
+    CPPUNIT_ASSERT_EQUAL(2, results[4].second);
+    CPPUNIT_ASSERT_EQUAL(8, results[5].first);
+    CPPUNIT_ASSERT_EQUAL(5, results[5].second);
+    CPPUNIT_ASSERT_EQUAL(9, results[6].first);
+    CPPUNIT_ASSERT_EQUAL(22, results[6].second);
+    CPPUNIT_ASSERT_EQUAL(10, results[7].first);
+    CPPUNIT_ASSERT_EQUAL(7, results[7].second);
+  }
+
+  void test_upper_bound() {
+    auto reader = create_case_1();
+    CPPUNIT_ASSERT_EQUAL(30, reader->upper_bound());
+  }
+
+  void test_threshold() {
+    auto reader = create_case_1();
+    reader->threshold(5);
+    std::vector<std::pair<int, int>> results = read_all(*reader);
+
+    // only the documents scored greater than threshold
+    CPPUNIT_ASSERT_EQUAL(4, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(1, results[0].first);
+    CPPUNIT_ASSERT_EQUAL(10, results[0].second);
+    CPPUNIT_ASSERT_EQUAL(5, results[1].first);
+    CPPUNIT_ASSERT_EQUAL(20, results[1].second);
+    CPPUNIT_ASSERT_EQUAL(9, results[2].first);
+    CPPUNIT_ASSERT_EQUAL(22, results[2].second);
+    CPPUNIT_ASSERT_EQUAL(10, results[3].first);
+    CPPUNIT_ASSERT_EQUAL(7, results[3].second);
+  }
+
+  void test_essential() {
+    auto reader = create_case_1();
+    // upper bounds sorted: 2, 8, 10, 10
+    CPPUNIT_ASSERT_EQUAL(0, (int)reader->essential_);
+    CPPUNIT_ASSERT_EQUAL(2, reader->acc_upper_bounds_[0]);
+    CPPUNIT_ASSERT_EQUAL(10, reader->acc_upper_bounds_[1]);
+    CPPUNIT_ASSERT_EQUAL(30, reader->acc_upper_bounds_[3]);
+    reader->threshold(2);
+    CPPUNIT_ASSERT_EQUAL(1, (int)reader->essential_);
+    reader->threshold(10);
+    CPPUNIT_ASSERT_EQUAL(2, (int)reader->essential_);
+
+    // no document could beat the threshold
+    reader->threshold(30);
+    CPPUNIT_ASSERT_EQUAL(4, (int)reader->essential_);
+    CPPUNIT_ASSERT_EQUAL(0, reader->next(0));
+  }
+
+  void test_read_topn() {
+    // the same top scores as accumulating all postings
+    srand(7);
+    for (int round = 0; round < 20; ++round) {
+      std::vector<std::vector<std::pair<int, int>>> postings(10);
+      for (size_t i = 0; i < postings.size(); ++i) {
+        int max_weight = 1 + rand() % (i < 2 ? 100 : 10);
+        for (int doc_id = 1; doc_id <= 1000; ++doc_id) {
+          if (rand() % 4 == 0) {
+            postings[i].emplace_back(doc_id, 1 + rand() % max_weight);
+          }
+        }
+      }
+      std::vector<std::unique_ptr<PostingListReader<int, int>>> readers;
+      std::vector<std::unique_ptr<PostingListReader<int, int>>> expected_readers;
+      for (auto& posting: postings) {
+        readers.emplace_back(new MockReader<int, int>(posting));
+        expected_readers.emplace_back(new MockReader<int, int>(posting));
+      }
+      MaxScoreReader<int, int> reader(std::move(readers));
+      TaatReader<int, int> expected_reader(std::move(expected_readers));
+
+      auto results = read_topn(reader, 20);
+      auto expected = read_topn(expected_reader, 20);
+      CPPUNIT_ASSERT_EQUAL(expected.size(), results.size());
+      for (size_t i = 0; i < expected.size(); ++i) {
+        CPPUNIT_ASSERT_EQUAL(expected[i].second, results[i].second);
+      }
+    }
+  }
+
+private:
+  std::unique_ptr<MaxScoreReader<int, int>> create_case_1() {
+    std::vector<std::unique_ptr<PostingListReader<int, int>>> readers;
+    readers.emplace_back(new MockReader<int, int>({ // upper bound: 8
+      {1, 8}, {2, 2}, {5, 4}, {8, 4}, {10, 2}
+    }));
+    readers.emplace_back(new MockReader<int, int>({ // upper bound: 2
+      {1, 2}, {3, 1}, {5, 1}, {7, 2}, {8, 1}, {9, 2}
+    }));
+    readers.emplace_back(new MockReader<int, int>({ // upper bound 10
+      {3, 1}, {5, 5}, {9, 10}, {10, 5}
+    }));
+    readers.emplace_back(new MockReader<int, int>({ // upper bound 10
+      {5, 10}, {9, 10}
+    }));
+    return std::unique_ptr<MaxScoreReader<int, int>>(new MaxScoreReader<int, int>(std::move(readers)));
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MaxScoreReaderTest);
+
+} /* namespace redgiant */
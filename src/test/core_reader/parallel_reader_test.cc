@@ -0,0 +1,174 @@
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "mock_reader.h"
+
+#include "core/reader/parallel_reader.h"
+#include "core/reader/range_reader.h"
+#include "core/reader/reader_utils.h"
+#include "core/reader/taat_reader.h"
+#include "core/reader/wand_reader.h"
+#include "core/reader/wand_reader-inl.h"
+#include "utils/concurrency/task_pool.h"
+
+namespace redgiant {
+class ParallelReaderTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(ParallelReaderTest);
+  CPPUNIT_TEST(test_range_reader);
+  CPPUNIT_TEST(test_read_all);
+  CPPUNIT_TEST(test_estimate);
+  CPPUNIT_TEST(test_read_topn_parallel);
+  CPPUNIT_TEST(test_stop);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  typedef PostingListReader<int, int> Reader;
+
+  ParallelReaderTest() = default;
+  virtual ~ParallelReaderTest() = default;
+
+protected:
+  void test_range_reader() {
+    std::vector<std::pair<int, int>> posting = {{1, 1}, {3, 2}, {5, 3}, {7, 4}, {9, 5}};
+    RangeReader<int, int> first(std::unique_ptr<Reader>(new MockReader<int, int>(posting)), 0, 5);
+    std::vector<std::pair<int, int>> results = read_all(first);
+    CPPUNIT_ASSERT_EQUAL(3, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(1, results[0].first);
+    CPPUNIT_ASSERT_EQUAL(5, results[2].first);
+    CPPUNIT_ASSERT_EQUAL(3, results[2].second);
+    CPPUNIT_ASSERT_EQUAL(0, first.next(5));
+
+    RangeReader<int, int> middle(std::unique_ptr<Reader>(new MockReader<int, int>(posting)), 2, 7);
+    results = read_all(middle);
+    CPPUNIT_ASSERT_EQUAL(3, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(3, results[0].first);
+    CPPUNIT_ASSERT_EQUAL(7, results[2].first);
+
+    RangeReader<int, int> last(std::unique_ptr<Reader>(new MockReader<int, int>(posting)), 7, 0);
+    results = read_all(last);
+    CPPUNIT_ASSERT_EQUAL(1, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(9, results[0].first);
+    CPPUNIT_ASSERT_EQUAL(5, last.upper_bound());
+  }
+
+  void test_read_all() {
+    // iterated as a reader, the partitions are read one after another
+    auto postings = create_postings(1, 100);
+    auto reader = create_parallel_reader(postings, 4, 100);
+    auto expected_reader = create_wand_reader(postings);
+    CPPUNIT_ASSERT_EQUAL(expected_reader->upper_bound(), reader->upper_bound());
+    std::vector<std::pair<int, int>> results = read_all(*reader);
+    std::vector<std::pair<int, int>> expected = read_all(*expected_reader);
+    CPPUNIT_ASSERT_EQUAL(expected.size(), results.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      CPPUNIT_ASSERT_EQUAL(expected[i].first, results[i].first);
+      CPPUNIT_ASSERT_EQUAL(expected[i].second, results[i].second);
+    }
+  }
+
+  void test_estimate() {
+    std::vector<std::unique_ptr<Reader>> partitions;
+    ParallelReader<int, int> reader(std::move(partitions), 10, 5);
+    int score = 0;
+    CPPUNIT_ASSERT(reader.estimate_kth_weight(10, score));
+    CPPUNIT_ASSERT_EQUAL(5, score);
+    CPPUNIT_ASSERT(reader.estimate_kth_weight(3, score));
+    CPPUNIT_ASSERT(!reader.estimate_kth_weight(11, score));
+
+    ParallelReader<int, int> no_estimate(std::vector<std::unique_ptr<Reader>>(), 0, 0);
+    CPPUNIT_ASSERT(!no_estimate.estimate_kth_weight(1, score));
+  }
+
+  void test_read_topn_parallel() {
+    // the same top scores as accumulating all postings
+    TaskPool pool(3);
+    pool.start();
+    auto run = [&pool] (size_t n, const TaskPool::Task& task) { pool.run(n, task); };
+    srand(11);
+    for (int round = 0; round < 20; ++round) {
+      auto postings = create_postings(5, 2000);
+      auto reader = create_parallel_reader(postings, 8, 2000);
+      auto expected_reader = create_taat_reader(postings);
+      bool stopped = true;
+      auto results = read_topn_parallel(*reader, 20, 0, run, [] { return false; }, stopped);
+      auto expected = read_topn(*expected_reader, 20);
+      CPPUNIT_ASSERT(!stopped);
+      CPPUNIT_ASSERT_EQUAL(expected.size(), results.size());
+      for (size_t i = 0; i < expected.size(); ++i) {
+        CPPUNIT_ASSERT_EQUAL(expected[i].second, results[i].second);
+      }
+    }
+    pool.stop();
+  }
+
+  void test_stop() {
+    // stopped at the first check of each partition, and the documents read so far are returned
+    auto postings = create_postings(3, 1000);
+    auto reader = create_parallel_reader(postings, 4, 1000);
+    auto run = [] (size_t n, const std::function<void (size_t)>& task) {
+      for (size_t i = 0; i < n; ++i) {
+        task(i);
+      }
+    };
+    bool stopped = false;
+    auto results = read_topn_parallel(*reader, 10, 0, run, [] { return true; }, stopped, 1);
+    CPPUNIT_ASSERT(stopped);
+    CPPUNIT_ASSERT_EQUAL(4, (int)results.size());
+  }
+
+private:
+  std::vector<std::vector<std::pair<int, int>>> create_postings(size_t terms, int max_doc_id) {
+    std::vector<std::vector<std::pair<int, int>>> postings(terms);
+    for (size_t i = 0; i < postings.size(); ++i) {
+      int max_weight = 1 + rand() % 100;
+      for (int doc_id = 1; doc_id <= max_doc_id; ++doc_id) {
+        if (rand() % 3 == 0) {
+          postings[i].emplace_back(doc_id, 1 + rand() % max_weight);
+        }
+      }
+    }
+    return postings;
+  }
+
+  std::unique_ptr<ParallelReader<int, int>> create_parallel_reader(
+      const std::vector<std::vector<std::pair<int, int>>>& postings, int partition_num, int max_doc_id) {
+    std::vector<std::unique_ptr<Reader>> partitions;
+    for (int i = 0; i < partition_num; ++i) {
+      int after = max_doc_id * i / partition_num;
+      int last = i + 1 < partition_num ? max_doc_id * (i + 1) / partition_num : 0;
+      std::vector<std::unique_ptr<Reader>> readers;
+      for (auto& posting: postings) {
+        readers.emplace_back(new RangeReader<int, int>(
+            std::unique_ptr<Reader>(new MockReader<int, int>(posting)), after, last));
+      }
+      partitions.emplace_back(new WandReader<int, int>(std::move(readers)));
+    }
+    return std::unique_ptr<ParallelReader<int, int>>(new ParallelReader<int, int>(std::move(partitions)));
+  }
+
+  std::unique_ptr<Reader> create_wand_reader(const std::vector<std::vector<std::pair<int, int>>>& postings) {
+    std::vector<std::unique_ptr<Reader>> readers;
+    for (auto& posting: postings) {
+      readers.emplace_back(new MockReader<int, int>(posting));
+    }
+    return std::unique_ptr<Reader>(new WandReader<int, int>(std::move(readers)));
+  }
+
+  std::unique_ptr<Reader> create_taat_reader(const std::vector<std::vector<std::pair<int, int>>>& postings) {
+    std::vector<std::unique_ptr<Reader>> readers;
+    for (auto& posting: postings) {
+      readers.emplace_back(new MockReader<int, int>(posting));
+    }
+    return std::unique_ptr<Reader>(new TaatReader<int, int>(std::move(readers)));
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ParallelReaderTest);
+
+} /* namespace redgiant */
@@ -0,0 +1,101 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "mock_reader.h"
+
+#include "core/reader/reader_utils.h"
+
+namespace redgiant {
+class ReaderUtilsTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(ReaderUtilsTest);
+  CPPUNIT_TEST(test_read_topn);
+  CPPUNIT_TEST(test_read_topn_until);
+  CPPUNIT_TEST(test_read_topn_min_score);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  ReaderUtilsTest() = default;
+  virtual ~ReaderUtilsTest() = default;
+
+protected:
+  void test_read_topn() {
+    auto reader = create_reader();
+    std::vector<std::pair<int, int>> results = read_topn(*reader, 3);
+
+    CPPUNIT_ASSERT_EQUAL(3, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(9, results[0].first);
+    CPPUNIT_ASSERT_EQUAL(9, results[0].second);
+    CPPUNIT_ASSERT_EQUAL(5, results[1].first);
+    CPPUNIT_ASSERT_EQUAL(8, results[1].second);
+    CPPUNIT_ASSERT_EQUAL(2, results[2].first);
+    CPPUNIT_ASSERT_EQUAL(7, results[2].second);
+  }
+
+  void test_read_topn_until() {
+    auto reader = create_reader();
+    bool stopped = true;
+    int checks = 0;
+    std::vector<std::pair<int, int>> results = read_topn_until(*reader, 3, 0, [] { return false; },
+        stopped, 2);
+    CPPUNIT_ASSERT(!stopped);
+    CPPUNIT_ASSERT_EQUAL(0, checks);
+    CPPUNIT_ASSERT_EQUAL(3, (int)results.size());
+
+    // stopped at the second check, after 4 documents are read
+    reader = create_reader();
+    results = read_topn_until(*reader, 3, 0, [&checks] { return ++checks == 2; }, stopped, 2);
+    CPPUNIT_ASSERT(stopped);
+    CPPUNIT_ASSERT_EQUAL(2, checks);
+    CPPUNIT_ASSERT_EQUAL(3, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(2, results[0].first);
+    CPPUNIT_ASSERT_EQUAL(7, results[0].second);
+    CPPUNIT_ASSERT_EQUAL(4, results[1].first);
+    CPPUNIT_ASSERT_EQUAL(3, results[1].second);
+    CPPUNIT_ASSERT_EQUAL(1, results[2].first);
+    CPPUNIT_ASSERT_EQUAL(2, results[2].second);
+  }
+
+  void test_read_topn_min_score() {
+    // the threshold given to the reader never drops below min_score
+    std::unique_ptr<ThresholdReader> reader(new ThresholdReader(
+        {{1, 2}, {2, 7}, {3, 1}, {4, 3}, {5, 8}, {6, 1}, {7, 4}, {8, 2}, {9, 9}, {10, 5}}));
+    bool stopped;
+    std::vector<std::pair<int, int>> results = read_topn_until(*reader, 3, 4, [] { return false; }, stopped);
+    CPPUNIT_ASSERT_EQUAL(3, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(9, results[0].first);
+    CPPUNIT_ASSERT_EQUAL(5, results[1].first);
+    CPPUNIT_ASSERT_EQUAL(2, results[2].first);
+    // 4 (given), 7 (doc 2, 5, 9 are the top 3)
+    CPPUNIT_ASSERT_EQUAL(2, (int)reader->thresholds.size());
+    CPPUNIT_ASSERT_EQUAL(4, reader->thresholds[0]);
+    CPPUNIT_ASSERT_EQUAL(7, reader->thresholds[1]);
+  }
+
+private:
+  // records the thresholds set
+  class ThresholdReader: public MockReader<int, int> {
+  public:
+    ThresholdReader(const PostingVec& posting)
+    : MockReader<int, int>(posting) {
+    }
+
+    virtual void threshold(const int& weight) {
+      thresholds.push_back(weight);
+    }
+
+    std::vector<int> thresholds;
+  };
+
+  static std::unique_ptr<MockReader<int, int>> create_reader() {
+    return std::unique_ptr<MockReader<int, int>>(new MockReader<int, int>(
+        {{1, 2}, {2, 7}, {3, 1}, {4, 3}, {5, 8}, {6, 1}, {7, 4}, {8, 2}, {9, 9}, {10, 5}}));
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ReaderUtilsTest);
+
+} /* namespace redgiant */
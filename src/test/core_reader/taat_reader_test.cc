@@ -0,0 +1,169 @@
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "mock_reader.h"
+
+#include "core/reader/reader_utils.h"
+#include "core/reader/score_accumulator.h"
+#include "core/reader/taat_reader.h"
+
+namespace redgiant {
+class TaatReaderTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TaatReaderTest);
+  CPPUNIT_TEST(test_read_all);
+  CPPUNIT_TEST(test_upper_bound);
+  CPPUNIT_TEST(test_estimate_kth_weight);
+  CPPUNIT_TEST(test_read_head);
+  CPPUNIT_TEST(test_stop);
+  CPPUNIT_TEST(test_accumulator);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  TaatReaderTest() = default;
+  virtual ~TaatReaderTest() = default;
+
+protected:
+  void test_read_all() {
+    auto reader = create_case_1();
+    CPPUNIT_ASSERT_EQUAL(8, (int)reader->size());
+    std::vector<std::pair<int, int>> results = read_all(*reader);
+
+    CPPUNIT_ASSERT_EQUAL(8, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(1, results[0].first);
+    CPPUNIT_ASSERT_EQUAL(10, results[0].second);
+    CPPUNIT_ASSERT_EQUAL(3, results[2].first);
+    CPPUNIT_ASSERT_EQUAL(2, results[2].second);
+    CPPUNIT_ASSERT_EQUAL(5, results[3].first);
+    CPPUNIT_ASSERT_EQUAL(20, results[3].second);
+    CPPUNIT_ASSERT_EQUAL(9, results[6].first);
+    CPPUNIT_ASSERT_EQUAL(22, results[6].second);
+    CPPUNIT_ASSERT_EQUAL(10, results[7].first);
+    CPPUNIT_ASSERT_EQUAL(7, results[7].second);
+  }
+
+  void test_upper_bound() {
+    // the greatest accumulated score
+    auto reader = create_case_1();
+    CPPUNIT_ASSERT_EQUAL(22, reader->upper_bound());
+  }
+
+  void test_estimate_kth_weight() {
+    // scores: 22, 20, 10, 7, 5, 2, 2, 2
+    auto reader = create_case_1();
+    int score = 0;
+    CPPUNIT_ASSERT(!reader->estimate_kth_weight(0, score));
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(1, score));
+    CPPUNIT_ASSERT_EQUAL(22, score);
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(3, score));
+    CPPUNIT_ASSERT_EQUAL(10, score);
+    CPPUNIT_ASSERT(reader->estimate_kth_weight(8, score));
+    CPPUNIT_ASSERT_EQUAL(2, score);
+    CPPUNIT_ASSERT(!reader->estimate_kth_weight(9, score));
+  }
+
+  void test_read_head() {
+    // scores: 22, 20, 10, 7, 5, 2, 2, 2
+    auto reader = create_case_1();
+    std::vector<std::pair<int, int>> head;
+    CPPUNIT_ASSERT(!reader->read_head(0, head));
+    CPPUNIT_ASSERT(reader->read_head(3, head));
+    CPPUNIT_ASSERT_EQUAL(3, (int)head.size());
+    CPPUNIT_ASSERT_EQUAL(9, head[0].first);
+    CPPUNIT_ASSERT_EQUAL(22, head[0].second);
+    CPPUNIT_ASSERT_EQUAL(5, head[1].first);
+    CPPUNIT_ASSERT_EQUAL(20, head[1].second);
+    CPPUNIT_ASSERT_EQUAL(1, head[2].first);
+    CPPUNIT_ASSERT_EQUAL(10, head[2].second);
+
+    // earlier documents first if scores tie
+    CPPUNIT_ASSERT(reader->read_head(7, head));
+    CPPUNIT_ASSERT_EQUAL(7, (int)head.size());
+    CPPUNIT_ASSERT_EQUAL(2, head[5].first);
+    CPPUNIT_ASSERT_EQUAL(2, head[5].second);
+    CPPUNIT_ASSERT_EQUAL(3, head[6].first);
+    CPPUNIT_ASSERT_EQUAL(2, head[6].second);
+
+    // all documents if less than k
+    CPPUNIT_ASSERT(reader->read_head(100, head));
+    CPPUNIT_ASSERT_EQUAL(8, (int)head.size());
+    CPPUNIT_ASSERT_EQUAL(7, head[7].first);
+
+    // still readable in the order of doc ids
+    CPPUNIT_ASSERT_EQUAL(1, reader->next(0));
+    CPPUNIT_ASSERT_EQUAL(10, reader->read());
+  }
+
+  void test_stop() {
+    bool stopped = true;
+    auto reader = create_case_1([] { return false; }, stopped);
+    CPPUNIT_ASSERT(!stopped);
+    CPPUNIT_ASSERT_EQUAL(8, (int)reader->size());
+
+    // stopped after the first block, which is the whole of the first term
+    int checks = 0;
+    reader = create_case_1([&checks] { return ++checks >= 1; }, stopped);
+    CPPUNIT_ASSERT(stopped);
+    CPPUNIT_ASSERT_EQUAL(1, checks);
+    CPPUNIT_ASSERT_EQUAL(5, (int)reader->size());
+    CPPUNIT_ASSERT_EQUAL(8, reader->upper_bound());
+    std::vector<std::pair<int, int>> head;
+    CPPUNIT_ASSERT(reader->read_head(1, head));
+    CPPUNIT_ASSERT_EQUAL(1, head[0].first);
+  }
+
+  void test_accumulator() {
+    ScoreAccumulator<int, int, std::hash<int>> accumulator;
+    // more documents than expected
+    accumulator.reset(1);
+    for (int round = 0; round < 3; ++round) {
+      for (int doc_id = 1; doc_id <= 1000; ++doc_id) {
+        accumulator.add(doc_id * 1024, doc_id);
+      }
+    }
+    CPPUNIT_ASSERT_EQUAL(1000, (int)accumulator.size());
+    for (int i = 0; i < 1000; ++i) {
+      CPPUNIT_ASSERT_EQUAL((i + 1) * 1024, accumulator.get_doc_ids()[i]);
+      CPPUNIT_ASSERT_EQUAL((i + 1) * 3, accumulator.get_scores()[i]);
+    }
+
+    // reused
+    accumulator.reset(10);
+    CPPUNIT_ASSERT_EQUAL(0, (int)accumulator.size());
+    accumulator.add(5, 1);
+    accumulator.add(5, 2);
+    CPPUNIT_ASSERT_EQUAL(1, (int)accumulator.size());
+    CPPUNIT_ASSERT_EQUAL(3, accumulator.get_scores()[0]);
+  }
+
+private:
+  std::unique_ptr<TaatReader<int, int>> create_case_1() {
+    bool stopped;
+    return create_case_1([] { return false; }, stopped);
+  }
+
+  std::unique_ptr<TaatReader<int, int>> create_case_1(const std::function<bool ()>& stop, bool& stopped) {
+    std::vector<std::unique_ptr<PostingListReader<int, int>>> readers;
+    readers.emplace_back(new MockReader<int, int>({
+      {1, 8}, {2, 2}, {5, 4}, {8, 4}, {10, 2}
+    }));
+    readers.emplace_back(new MockReader<int, int>({
+      {1, 2}, {3, 1}, {5, 1}, {7, 2}, {8, 1}, {9, 2}
+    }));
+    readers.emplace_back(new MockReader<int, int>({
+      {3, 1}, {5, 5}, {9, 10}, {10, 5}
+    }));
+    readers.emplace_back(new MockReader<int, int>({
+      {5, 10}, {9, 10}
+    }));
+    return std::unique_ptr<TaatReader<int, int>>(new TaatReader<int, int>(std::move(readers), stop, stopped));
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TaatReaderTest);
+
+} /* namespace redgiant */
@@ -22,6 +22,11 @@ class WandReaderTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(test_move_term);
   CPPUNIT_TEST(test_move_term_no_move);
   CPPUNIT_TEST(test_size);
+  CPPUNIT_TEST(test_threshold);
+  CPPUNIT_TEST(test_estimate_kth_weight);
+  CPPUNIT_TEST(test_read_topn_static);
+  CPPUNIT_TEST(test_typed_terms);
+  CPPUNIT_TEST(test_priors);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -220,7 +225,144 @@ protected:
     reader->size(); // no meaning
   }
 
+  void test_threshold() {
+    auto reader = create_case_1();
+    // set by the base class, like read_topn
+    PostingListReader<int, int>& base_reader = *reader;
+    base_reader.threshold(12);
+    CPPUNIT_ASSERT_EQUAL(12, reader->threshold_);
+  }
+
+  void test_estimate_kth_weight() {
+    std::vector<std::unique_ptr<PostingListReader<int, int>>> readers;
+    readers.emplace_back(new EstimateReader({{1, 8}, {2, 2}, {5, 4}, {8, 4}, {10, 2}}, 4));
+    readers.emplace_back(new EstimateReader({{5, 10}, {9, 10}}, 10));
+    readers.emplace_back(new EstimateReader({{3, 1}, {5, 5}, {9, 10}, {10, 5}}, 1));
+    WandReader<int, int> reader(std::move(readers));
+
+    int score = 0;
+    // the greatest of the terms
+    CPPUNIT_ASSERT(reader.estimate_kth_weight(2, score));
+    CPPUNIT_ASSERT_EQUAL(10, score);
+    CPPUNIT_ASSERT(reader.estimate_kth_weight(3, score));
+    CPPUNIT_ASSERT_EQUAL(4, score);
+    CPPUNIT_ASSERT(!reader.estimate_kth_weight(6, score));
+
+    // not estimated if any term may score negative
+    readers.clear();
+    readers.emplace_back(new EstimateReader({{1, 8}, {2, 2}, {5, 4}, {8, 4}, {10, 2}}, 4));
+    readers.emplace_back(new EstimateReader({{5, 10}, {9, -1}}, -1));
+    WandReader<int, int> negative_reader(std::move(readers));
+    CPPUNIT_ASSERT(!negative_reader.estimate_kth_weight(2, score));
+
+    // not estimated if any term is not estimated
+    readers.clear();
+    readers.emplace_back(new EstimateReader({{1, 8}, {2, 2}, {5, 4}, {8, 4}, {10, 2}}, 4));
+    readers.emplace_back(new MockReader<int, int>({{5, 10}, {9, 10}}));
+    WandReader<int, int> unknown_reader(std::move(readers));
+    CPPUNIT_ASSERT(!unknown_reader.estimate_kth_weight(2, score));
+  }
+
+  void test_read_topn_static() {
+    // the same as reading through the virtual calls
+    auto expected_reader = create_case_1();
+    auto expected = read_topn(*expected_reader, 3);
+    auto reader = create_case_1();
+    std::vector<std::pair<int, int>> results;
+    bool stopped = true;
+    PostingListReader<int, int>& base_reader = *reader;
+    CPPUNIT_ASSERT(base_reader.read_topn_static(3, 0, [] { return false; }, stopped, results));
+    CPPUNIT_ASSERT(!stopped);
+    CPPUNIT_ASSERT_EQUAL(3, (int)results.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      CPPUNIT_ASSERT_EQUAL(expected[i].first, results[i].first);
+      CPPUNIT_ASSERT_EQUAL(expected[i].second, results[i].second);
+    }
+    // 22, 20, 10
+    CPPUNIT_ASSERT_EQUAL(9, results[0].first);
+    CPPUNIT_ASSERT_EQUAL(10, results[2].second);
+
+    // not supported by the other readers
+    MockReader<int, int> mock_reader({{1, 1}});
+    CPPUNIT_ASSERT(!mock_reader.read_topn_static(3, 0, [] { return false; }, stopped, results));
+  }
+
+  void test_typed_terms() {
+    // the terms are read by their concrete type
+    std::vector<std::unique_ptr<MockReader<int, int>>> readers;
+    readers.emplace_back(new MockReader<int, int>({{1, 8}, {2, 2}, {5, 4}, {8, 4}, {10, 2}}));
+    readers.emplace_back(new MockReader<int, int>({{1, 2}, {3, 1}, {5, 1}, {7, 2}, {8, 1}, {9, 2}}));
+    readers.emplace_back(new MockReader<int, int>({{3, 1}, {5, 5}, {9, 10}, {10, 5}}));
+    readers.emplace_back(new MockReader<int, int>({{5, 10}, {9, 10}}));
+    WandReader<int, int, MockReader<int, int>> reader(std::move(readers));
+    CPPUNIT_ASSERT_EQUAL(30, reader.upper_bound());
+
+    auto expected_reader = create_case_1();
+    std::vector<std::pair<int, int>> results = read_all(reader);
+    std::vector<std::pair<int, int>> expected = read_all(*expected_reader);
+    CPPUNIT_ASSERT_EQUAL(expected.size(), results.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      CPPUNIT_ASSERT_EQUAL(expected[i].first, results[i].first);
+      CPPUNIT_ASSERT_EQUAL(expected[i].second, results[i].second);
+    }
+  }
+
+  void test_priors() {
+    std::vector<std::unique_ptr<PostingListReader<int, int>>> readers;
+    readers.emplace_back(new MockReader<int, int>({{1, 8}, {2, 2}, {5, 4}, {8, 4}, {10, 2}}));
+    readers.emplace_back(new MockReader<int, int>({{3, 1}, {5, 5}, {9, 10}, {10, 5}}));
+    std::vector<std::unique_ptr<PostingListReader<int, int>>> priors;
+    // every document but 3 and 9, which is never read as a term
+    priors.emplace_back(new MockReader<int, int>({{1, 1}, {2, 3}, {4, 20}, {5, 2}, {6, 1}, {7, 1}, {8, 6},
+      {10, 1}}));
+    priors.emplace_back(new MockReader<int, int>({{2, 1}, {5, 1}}));
+    WandReader<int, int> reader(std::move(readers), std::move(priors));
+    CPPUNIT_ASSERT_EQUAL(39, reader.upper_bound());
+
+    // only the documents of the terms, scored by the terms and the priors
+    std::vector<std::pair<int, int>> results = read_all(reader);
+    std::vector<std::pair<int, int>> expected = {{1, 9}, {2, 6}, {3, 1}, {5, 12}, {8, 10}, {9, 10}, {10, 8}};
+    CPPUNIT_ASSERT_EQUAL(expected.size(), results.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      CPPUNIT_ASSERT_EQUAL(expected[i].first, results[i].first);
+      CPPUNIT_ASSERT_EQUAL(expected[i].second, results[i].second);
+    }
+
+    // the terms are skipped by the threshold lowered by the priors
+    readers.clear();
+    readers.emplace_back(new MockReader<int, int>({{1, 8}, {2, 2}, {5, 4}, {8, 4}, {10, 2}}));
+    readers.emplace_back(new MockReader<int, int>({{3, 1}, {5, 5}, {9, 10}, {10, 5}}));
+    priors.clear();
+    priors.emplace_back(new MockReader<int, int>({{1, 1}, {2, 3}, {4, 20}, {5, 2}, {8, 6}}));
+    WandReader<int, int> top_reader(std::move(readers), std::move(priors));
+    auto top = read_topn(top_reader, 2);
+    CPPUNIT_ASSERT_EQUAL(2, (int)top.size());
+    CPPUNIT_ASSERT_EQUAL(5, top[0].first);
+    CPPUNIT_ASSERT_EQUAL(11, top[0].second);
+    CPPUNIT_ASSERT_EQUAL(8, top[1].first);
+    CPPUNIT_ASSERT_EQUAL(10, top[1].second);
+  }
+
 private:
+  // estimates a fixed weight for k not greater than the size
+  class EstimateReader: public MockReader<int, int> {
+  public:
+    EstimateReader(const PostingVec& posting, int estimate)
+    : MockReader<int, int>(posting), estimate_(estimate) {
+    }
+
+    virtual bool estimate_kth_weight(size_t k, int& weight) {
+      if (k > size()) {
+        return false;
+      }
+      weight = estimate_;
+      return true;
+    }
+
+  private:
+    int estimate_;
+  };
+
   std::unique_ptr<WandReader<int, int>> create_case_1() {
     std::vector<std::unique_ptr<PostingListReader<int, int>>> readers;
     readers.emplace_back(new MockReader<int, int>({ // upper bound: 8
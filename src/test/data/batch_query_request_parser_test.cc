@@ -0,0 +1,110 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "data/batch_query_request.h"
+#include "data/batch_query_request_parser.h"
+#include "data/feature_space.h"
+#include "data/feature_space_manager.h"
+#include "data/query_request.h"
+
+using namespace std;
+
+namespace redgiant {
+class BatchQueryRequestParserTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(BatchQueryRequestParserTest);
+  CPPUNIT_TEST(test_parse);
+  CPPUNIT_TEST(test_parse_error);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  BatchQueryRequestParserTest() = default;
+  virtual ~BatchQueryRequestParserTest() = default;
+
+protected:
+  void test_parse() {
+    auto feature_spaces = create_feature_spaces();
+    auto parser = BatchQueryRequestParserFactory(feature_spaces).create_parser();
+
+    string json = R"({
+      "features": { "category": { "1": 1.0, "2": 2.0 } },
+      "queries": [
+        { "id": "a", "model": "m1", "count": 5 },
+        { "model": "m2", "features": { "publisher": "cnn" } },
+        { "id": "c" }
+      ]
+    })";
+
+    BatchQueryRequest request("batch", StopWatch(), true);
+    CPPUNIT_ASSERT_EQUAL(0, parser->parse(json.c_str(), json.size(), request));
+
+    auto& queries = request.get_queries();
+    CPPUNIT_ASSERT_EQUAL(3, (int)queries.size());
+
+    CPPUNIT_ASSERT_EQUAL(string("a"), queries[0].get_request_id());
+    CPPUNIT_ASSERT_EQUAL(string("m1"), queries[0].get_model_name());
+    CPPUNIT_ASSERT_EQUAL(5, (int)queries[0].get_query_count());
+    CPPUNIT_ASSERT_EQUAL(2, (int)queries[0].get_terms().size());
+    CPPUNIT_ASSERT(queries[0].is_debug());
+
+    // own features, id defaults to the index
+    CPPUNIT_ASSERT_EQUAL(string("1"), queries[1].get_request_id());
+    CPPUNIT_ASSERT_EQUAL(string("m2"), queries[1].get_model_name());
+    CPPUNIT_ASSERT_EQUAL(10, (int)queries[1].get_query_count());
+    CPPUNIT_ASSERT_EQUAL(1, (int)queries[1].get_terms().size());
+    CPPUNIT_ASSERT(queries[1].get_terms()[0].first != queries[0].get_terms()[0].first);
+
+    // shared features
+    CPPUNIT_ASSERT_EQUAL(string("c"), queries[2].get_request_id());
+    CPPUNIT_ASSERT_EQUAL(string(""), queries[2].get_model_name());
+    CPPUNIT_ASSERT(queries[0].get_terms() == queries[2].get_terms());
+    CPPUNIT_ASSERT_EQUAL(1, (int)queries[2].get_feature_vectors().size());
+  }
+
+  void test_parse_error() {
+    auto feature_spaces = create_feature_spaces();
+    BatchQueryRequestParser parser(feature_spaces);
+
+    vector<string> jsons = {
+      R"({ "features": { "category": "1" } })",
+      R"({ "features": { "category": "1" }, "queries": [] })",
+      R"({ "features": { "category": "1" }, "queries": [ 1 ] })",
+      R"({ "features": { "category": "1" }, "queries": [ { "count": 0 } ] })",
+      R"({ "features": { "category": "1" }, "queries": [ { "count": "x" } ] })",
+      R"({ "queries": [ { "id": "no_features" } ] })",
+    };
+    for (auto& json: jsons) {
+      BatchQueryRequest request("batch");
+      CPPUNIT_ASSERT_EQUAL(-1, parser.parse(json.c_str(), json.size(), request));
+    }
+
+    // too many queries
+    string json = R"({ "features": { "category": "1" }, "queries": [ {})";
+    for (size_t i = 0; i < BatchQueryRequestParser::kMaxQueries; ++i) {
+      json += ", {}";
+    }
+    json += "] }";
+    BatchQueryRequest request("batch");
+    CPPUNIT_ASSERT_EQUAL(-1, parser.parse(json.c_str(), json.size(), request));
+
+    // but not too many for bulk queries
+    BatchQueryRequestParser bulk_parser(feature_spaces, BatchQueryRequestParser::kMaxBulkQueries);
+    BatchQueryRequest bulk_request("bulk");
+    CPPUNIT_ASSERT_EQUAL(0, bulk_parser.parse(json.c_str(), json.size(), bulk_request));
+    CPPUNIT_ASSERT_EQUAL(BatchQueryRequestParser::kMaxQueries + 1, bulk_request.get_queries().size());
+  }
+
+  std::shared_ptr<FeatureSpaceManager> create_feature_spaces() {
+    auto feature_spaces = std::make_shared<FeatureSpaceManager>();
+    feature_spaces->create_space("publisher", 2, FeatureSpace::SpaceType::kString);
+    feature_spaces->create_space("category", 4, FeatureSpace::SpaceType::kInteger);
+    return feature_spaces;
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BatchQueryRequestParserTest);
+
+} /* namespace redgiant */
@@ -0,0 +1,149 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "data/binary_format.h"
+#include "data/binary_parser.h"
+#include "data/document.h"
+#include "data/document_id.h"
+#include "data/query_request.h"
+
+using namespace std;
+
+namespace redgiant {
+class BinaryParserTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(BinaryParserTest);
+  CPPUNIT_TEST(test_document);
+  CPPUNIT_TEST(test_document_error);
+  CPPUNIT_TEST(test_multiple_documents);
+  CPPUNIT_TEST(test_query);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  BinaryParserTest() = default;
+  virtual ~BinaryParserTest() = default;
+
+protected:
+  void test_document() {
+#if defined(REDGIANT_NUMERIC_DOC_IDS)
+    // the high 64 bits of the numeric ids are zero
+    string id = "abcd1234-9876-1234-0000-000000000000";
+#else
+    string id = "abcd1234-9876-1234-ffff-001122ddeeff";
+#endif
+    string s = create_document(id,
+        {{0x0100000000000001ULL, 1.0f}, {0x02000000abcdef12ULL, 0.5f}});
+
+    BinaryDocumentParser parser;
+    Document doc;
+    int ret = parser.parse(s.data(), s.size(), doc);
+    CPPUNIT_ASSERT_EQUAL(0, ret);
+    CPPUNIT_ASSERT_EQUAL(Document::DocId(id).to_string(), doc.get_id().to_string());
+
+    const auto& terms = doc.get_terms();
+    CPPUNIT_ASSERT_EQUAL(2, (int)terms.size());
+    CPPUNIT_ASSERT_EQUAL((uint64_t)0x0100000000000001ULL, (uint64_t)terms[0].first);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, terms[0].second, 0.0001);
+    CPPUNIT_ASSERT_EQUAL((uint64_t)0x02000000abcdef12ULL, (uint64_t)terms[1].first);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, terms[1].second, 0.0001);
+  }
+
+  void test_document_error() {
+    BinaryDocumentParser parser;
+    string s = create_document("abcd1234-9876-1234-ffff-001122ddeeff", {{1, 1.0f}, {2, 1.0f}});
+
+    // truncated
+    Document doc1;
+    CPPUNIT_ASSERT_EQUAL(-1, parser.parse(s.data(), s.size() - 1, doc1));
+
+    // feature count does not match length
+    string s2 = s;
+    s2[BinaryFormat::kLengthSize + BinaryFormat::kDocIdSize] = 3;
+    Document doc2;
+    CPPUNIT_ASSERT_EQUAL(-1, parser.parse(s2.data(), s2.size(), doc2));
+
+    // no document id
+    string s3 = create_document("", {{1, 1.0f}});
+    Document doc3;
+    CPPUNIT_ASSERT_EQUAL(-1, parser.parse(s3.data(), s3.size(), doc3));
+
+#if defined(REDGIANT_NUMERIC_DOC_IDS)
+    // the high 64 bits are set
+    Document doc4;
+    CPPUNIT_ASSERT_EQUAL(-1, parser.parse(s.data(), s.size(), doc4));
+#endif
+  }
+
+  void test_multiple_documents() {
+    string s = create_document("00000000-0001-0000-0000-000000000000", {{1, 1.0f}})
+        + create_document("00000000-0002-0000-0000-000000000000", {})
+        + create_document("00000000-0003-0000-0000-000000000000", {{1, 1.0f}, {2, 2.0f}, {3, 3.0f}});
+
+    BinaryDocumentParser parser;
+    vector<int> sizes;
+    const char* data = s.data();
+    size_t len = s.size();
+    while (len > 0) {
+      size_t record_size = BinaryFormat::get_record_size(data, len);
+      CPPUNIT_ASSERT(record_size > 0);
+      Document doc;
+      CPPUNIT_ASSERT_EQUAL(0, parser.parse(data, record_size, doc));
+      sizes.push_back(doc.get_terms().size());
+      data += record_size;
+      len -= record_size;
+    }
+    CPPUNIT_ASSERT_EQUAL(3, (int)sizes.size());
+    CPPUNIT_ASSERT_EQUAL(1, sizes[0]);
+    CPPUNIT_ASSERT_EQUAL(0, sizes[1]);
+    CPPUNIT_ASSERT_EQUAL(3, sizes[2]);
+
+    // the record is incomplete
+    CPPUNIT_ASSERT_EQUAL(0, (int)BinaryFormat::get_record_size(s.data(), 10));
+    CPPUNIT_ASSERT_EQUAL(0, (int)BinaryFormat::get_record_size(s.data(), 2));
+  }
+
+  void test_query() {
+    string s;
+    BinaryFormat::write_uint32(BinaryFormat::kCountSize + 2 * BinaryFormat::kFeatureSize, s);
+    BinaryFormat::write_uint32(2, s);
+    BinaryFormat::write_uint64(0x0400000000000003ULL, s);
+    BinaryFormat::write_float(3.0f, s);
+    BinaryFormat::write_uint64(0x0600000012345678ULL, s);
+    BinaryFormat::write_float(0.25f, s);
+
+    BinaryQueryRequestParser parser;
+    QueryRequest request("0001", 10, "");
+    CPPUNIT_ASSERT_EQUAL(0, parser.parse(s.data(), s.size(), request));
+    const auto& terms = request.get_terms();
+    CPPUNIT_ASSERT_EQUAL(2, (int)terms.size());
+    CPPUNIT_ASSERT_EQUAL((uint64_t)0x0400000000000003ULL, (uint64_t)terms[0].first);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, terms[0].second, 0.0001);
+    CPPUNIT_ASSERT_EQUAL((uint64_t)0x0600000012345678ULL, (uint64_t)terms[1].first);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.25, terms[1].second, 0.0001);
+
+    QueryRequest request2("0002", 10, "");
+    CPPUNIT_ASSERT_EQUAL(-1, parser.parse(s.data(), s.size() - 4, request2));
+  }
+
+private:
+  string create_document(const string& uuid, const vector<pair<uint64_t, float>>& features) {
+    string s;
+    BinaryFormat::write_uint32(BinaryFormat::kDocIdSize + BinaryFormat::kCountSize
+        + features.size() * BinaryFormat::kFeatureSize, s);
+    char raw[DocumentId::kRawSize];
+    DocumentId(uuid).to_raw(raw);
+    s.append(raw, sizeof(raw));
+    BinaryFormat::write_uint32(features.size(), s);
+    for (const auto& f: features) {
+      BinaryFormat::write_uint64(f.first, s);
+      BinaryFormat::write_float(f.second, s);
+    }
+    return s;
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BinaryParserTest);
+} /* namespace redgiant */
@@ -1,6 +1,7 @@
 #include "data/document_id.h"
 
 #include <iostream>
+#include <vector>
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
 
@@ -12,6 +13,7 @@ class DocumentIdTest: public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(DocumentIdTest);
   CPPUNIT_TEST(test_doc_id_constructor);
   CPPUNIT_TEST(test_doc_id_operation);
+  CPPUNIT_TEST(test_count_not_greater);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -75,6 +77,26 @@ protected:
     -- document_id_10;
     CPPUNIT_ASSERT_EQUAL(document_id_10, DocumentId(0xffffffffffffffff));
   }
+
+  void test_count_not_greater() {
+    // the ids differ in both halves, and the low halves have the highest bits set
+    std::vector<DocumentId> ids = {
+      DocumentId(1, 0), DocumentId(0x8000000000000000, 0), DocumentId(0xffffffffffffffff, 0),
+      DocumentId(0, 1), DocumentId(0x8000000000000001, 1), DocumentId(0, 0x8000000000000000),
+      DocumentId(5, 0x8000000000000000), DocumentId(0, 0xffffffffffffffff),
+    };
+    for (size_t n = 0; n <= ids.size(); ++n) {
+      for (const auto& current: ids) {
+        size_t expected = 0;
+        while (expected < n && !(current < ids[expected])) {
+          ++expected;
+        }
+        CPPUNIT_ASSERT_EQUAL(expected, count_not_greater(ids.data(), n, current));
+      }
+      CPPUNIT_ASSERT_EQUAL((size_t)0, count_not_greater(ids.data(), n, DocumentId()));
+      CPPUNIT_ASSERT_EQUAL(n < 5 ? n : 5, count_not_greater(ids.data(), n, DocumentId(0, 2)));
+    }
+  }
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(DocumentIdTest);
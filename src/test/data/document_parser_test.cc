@@ -19,6 +19,7 @@ namespace redgiant {
 class DocumentParserTest: public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(DocumentParserTest);
   CPPUNIT_TEST(test_parser);
+  CPPUNIT_TEST(test_parser_terms);
   CPPUNIT_TEST(test_parser_withoutuuid);
   CPPUNIT_TEST_SUITE_END();
 
@@ -29,7 +30,7 @@ public:
 protected:
   void test_parser() {
     auto feature_spaces = create_feature_spaces();
-    auto parser = create_parser(feature_spaces);
+    auto parser = create_parser(feature_spaces, true);
 
     string s =
       R"({
@@ -50,7 +51,9 @@ protected:
     CPPUNIT_ASSERT_EQUAL(0, ret);
     // check doc meta
     CPPUNIT_ASSERT_EQUAL(string("abcd1234-9876-1234-ffff-001122ddeeff"), doc.get_id_str());
+#if !defined(REDGIANT_NUMERIC_DOC_IDS)
     CPPUNIT_ASSERT_EQUAL(string("abcd1234-9876-1234-ffff-001122ddeeff"), doc.get_id().to_string());
+#endif
 
     const auto& vecs = doc.get_feature_vectors();
     CPPUNIT_ASSERT_EQUAL(5, (int)vecs.size());
@@ -114,6 +117,51 @@ protected:
     CPPUNIT_ASSERT_DOUBLES_EQUAL((double)0.3, f->second, 0.0001);
   }
 
+  void test_parser_terms() {
+    auto feature_spaces = create_feature_spaces();
+    auto parser = create_parser(feature_spaces, false);
+
+    string s =
+      R"({
+        "uuid": "abcd1234-9876-1234-ffff-001122ddeeff",
+        "features": {
+          "publisher": "publisher_id_test",
+          "score": 2.34,
+          "category": ["1", "2", "x"],
+          "entity": {"ent_1":0.1, "ent_2":0.2},
+          "unknown": "abc"
+        }
+      })";
+
+    Document doc;
+    int ret = parser->parse(s.c_str(), s.length(), doc);
+    CPPUNIT_ASSERT_EQUAL(0, ret);
+    CPPUNIT_ASSERT_EQUAL(string("abcd1234-9876-1234-ffff-001122ddeeff"), doc.get_id_str());
+    // invalid integer key "x" is ignored
+    const auto& terms = doc.get_terms();
+    CPPUNIT_ASSERT_EQUAL(6, (int)terms.size());
+    auto publisher = feature_spaces->get_space("publisher");
+    auto score = feature_spaces->get_space("score");
+    auto category = feature_spaces->get_space("category");
+    auto entity = feature_spaces->get_space("entity");
+    CPPUNIT_ASSERT_EQUAL(publisher->calculate_feature_id("publisher_id_test"), terms[0].first);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, terms[0].second, 0.0001);
+    CPPUNIT_ASSERT_EQUAL(score->calculate_feature_id("0"), terms[1].first);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.34, terms[1].second, 0.0001);
+    CPPUNIT_ASSERT_EQUAL(category->calculate_feature_id("1"), terms[2].first);
+    CPPUNIT_ASSERT_EQUAL(category->calculate_feature_id("2"), terms[3].first);
+    CPPUNIT_ASSERT_EQUAL(entity->calculate_feature_id("ent_1"), terms[4].first);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.1, terms[4].second, 0.0001);
+    CPPUNIT_ASSERT_EQUAL(entity->calculate_feature_id("ent_2"), terms[5].first);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.2, terms[5].second, 0.0001);
+
+    // reuse the document
+    doc.clear();
+    ret = parser->parse(s.c_str(), s.length(), doc);
+    CPPUNIT_ASSERT_EQUAL(0, ret);
+    CPPUNIT_ASSERT_EQUAL(6, (int)doc.get_terms().size());
+  }
+
   void test_parser_withoutuuid() {
     auto feature_spaces = create_feature_spaces();
     auto parser = create_parser(feature_spaces);
@@ -145,8 +193,9 @@ private:
     return feature_spaces;
   };
 
-  std::unique_ptr<DocumentParser> create_parser(std::shared_ptr<FeatureSpaceManager> feature_spaces) {
-    return std::unique_ptr<DocumentParser>(new DocumentParser(std::move(feature_spaces)));
+  std::unique_ptr<DocumentParser> create_parser(std::shared_ptr<FeatureSpaceManager> feature_spaces,
+      bool keep_keys = false) {
+    return std::unique_ptr<DocumentParser>(new DocumentParser(std::move(feature_spaces), keep_keys));
   };
 };
 
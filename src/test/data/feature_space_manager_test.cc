@@ -54,7 +54,7 @@ protected:
     char j[] = R"([
       {"id": 1, "name": "category",  "type": "integer"},
       {"id": 2, "name": "entity",    "type": "string"},
-      {"id": 3, "name": "publisher", "type": "string"}
+      {"id": 3, "name": "publisher", "type": "string", "posting_list": "sequential"}
     ])";
     rapidjson::MemoryStream ms(j, sizeof(j)/sizeof(j[0]));
     rapidjson::Document conf;
@@ -67,6 +67,9 @@ protected:
     CPPUNIT_ASSERT(feature_spaces->get_space("category"));
     CPPUNIT_ASSERT(feature_spaces->get_space("entity"));
     CPPUNIT_ASSERT(feature_spaces->get_space("publisher"));
+    CPPUNIT_ASSERT_EQUAL(string(""), feature_spaces->get_space("entity")->get_posting_list());
+    CPPUNIT_ASSERT_EQUAL(string("sequential"), feature_spaces->get_space("publisher")->get_posting_list());
+    CPPUNIT_ASSERT_EQUAL(3, (int)feature_spaces->get_spaces().size());
   }
 };
 
@@ -0,0 +1,112 @@
+#include "data/numeric_document_id.h"
+
+#include <iostream>
+#include <unordered_set>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace std;
+
+namespace redgiant {
+class NumericDocumentIdTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(NumericDocumentIdTest);
+  CPPUNIT_TEST(test_doc_id_constructor);
+  CPPUNIT_TEST(test_doc_id_guid);
+  CPPUNIT_TEST(test_doc_id_operation);
+  CPPUNIT_TEST(test_hash);
+  CPPUNIT_TEST(test_count_not_greater);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  NumericDocumentIdTest() = default;
+  virtual ~NumericDocumentIdTest() = default;
+
+protected:
+  void test_doc_id_constructor() {
+    string id = "1234567890123";
+    NumericDocumentId document_id(id);
+    CPPUNIT_ASSERT_EQUAL((uint64_t)1234567890123ULL, document_id.get_id());
+    CPPUNIT_ASSERT_EQUAL(id, document_id.to_string());
+
+    CPPUNIT_ASSERT_EQUAL(string("0"), NumericDocumentId().to_string());
+    CPPUNIT_ASSERT_EQUAL(string("18446744073709551615"), NumericDocumentId(UINT64_MAX).to_string());
+    CPPUNIT_ASSERT_EQUAL((uint64_t)UINT64_MAX, NumericDocumentId("18446744073709551615").get_id());
+
+    // invalid ids
+    CPPUNIT_ASSERT(!NumericDocumentId(""));
+    CPPUNIT_ASSERT(!NumericDocumentId("12a"));
+    CPPUNIT_ASSERT(!NumericDocumentId("-12"));
+    CPPUNIT_ASSERT(!NumericDocumentId("18446744073709551616"));
+    CPPUNIT_ASSERT(!NumericDocumentId("123456789012345678901"));
+  }
+
+  void test_doc_id_guid() {
+    // the GUID form of DocumentId(12)
+    CPPUNIT_ASSERT_EQUAL((uint64_t)12, NumericDocumentId("0000000c-0000-0000-0000-000000000000").get_id());
+    // does not fit in 64 bits
+    CPPUNIT_ASSERT(!NumericDocumentId("0000000c-0000-0000-2200-000000000000"));
+
+    char raw[NumericDocumentId::kRawSize];
+    NumericDocumentId(0x1234567890ULL).to_raw(raw);
+    CPPUNIT_ASSERT(DocumentId::from_raw(raw) == DocumentId(0x1234567890ULL));
+    CPPUNIT_ASSERT_EQUAL((uint64_t)0x1234567890ULL, NumericDocumentId::from_raw(raw).get_id());
+    DocumentId(1, 1).to_raw(raw);
+    CPPUNIT_ASSERT(!NumericDocumentId::from_raw(raw));
+  }
+
+  void test_doc_id_operation() {
+    NumericDocumentId document_id_1(0x12);
+    NumericDocumentId document_id_2(0x12);
+    CPPUNIT_ASSERT(document_id_1 == document_id_2);
+    CPPUNIT_ASSERT(document_id_1 <= document_id_2);
+    CPPUNIT_ASSERT(document_id_1 >= document_id_2);
+    CPPUNIT_ASSERT(!(document_id_1 != document_id_2));
+
+    NumericDocumentId document_id_3(0x13);
+    CPPUNIT_ASSERT(document_id_1 < document_id_3);
+    CPPUNIT_ASSERT(document_id_3 > document_id_1);
+
+    CPPUNIT_ASSERT(!NumericDocumentId());
+    CPPUNIT_ASSERT(NumericDocumentId(1));
+
+    ++document_id_1;
+    CPPUNIT_ASSERT_EQUAL(document_id_3, document_id_1);
+    --document_id_1;
+    CPPUNIT_ASSERT_EQUAL(document_id_2, document_id_1);
+  }
+
+  void test_hash() {
+    // the sequential ids are spread over the low bits
+    NumericDocumentId::Hash hash;
+    std::unordered_set<size_t> buckets;
+    for (uint64_t i = 0; i < 1024; ++i) {
+      buckets.insert(hash(NumericDocumentId(i << 16)) & 1023);
+    }
+    CPPUNIT_ASSERT(buckets.size() > 512);
+  }
+
+  void test_count_not_greater() {
+    // the ids with the highest bit set are compared as unsigned
+    std::vector<NumericDocumentId> ids = {
+      NumericDocumentId(1), NumericDocumentId(2), NumericDocumentId(0x7fffffffffffffff),
+      NumericDocumentId(0x8000000000000000), NumericDocumentId(0x8000000000000001),
+      NumericDocumentId(0xfffffffffffffffe), NumericDocumentId(0xffffffffffffffff),
+    };
+    for (size_t n = 0; n <= ids.size(); ++n) {
+      for (const auto& current: ids) {
+        size_t expected = 0;
+        while (expected < n && !(current < ids[expected])) {
+          ++expected;
+        }
+        CPPUNIT_ASSERT_EQUAL(expected, count_not_greater(ids.data(), n, current));
+      }
+      CPPUNIT_ASSERT_EQUAL((size_t)0, count_not_greater(ids.data(), n, NumericDocumentId()));
+      CPPUNIT_ASSERT_EQUAL(n < 3 ? n : 3, count_not_greater(ids.data(), n, NumericDocumentId(0x7fffffffffffffff)));
+    }
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(NumericDocumentIdTest);
+}
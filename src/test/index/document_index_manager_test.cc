@@ -7,6 +7,7 @@
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
 
+#include "core/reader/reader_utils.h"
 #include "index/document_query.h"
 #include "index/document_index.h"
 #include "index/document_index_manager.h"
@@ -26,9 +27,18 @@ class DocumentIndexManagerTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(test_peek);
   CPPUNIT_TEST(test_exist_query);
   CPPUNIT_TEST(test_noexist_query);
+  CPPUNIT_TEST(test_parallel_query);
+  CPPUNIT_TEST(test_static_query);
+  CPPUNIT_TEST(test_sequential_query);
+  CPPUNIT_TEST(test_space_lists);
+  CPPUNIT_TEST(test_constant_lists);
+  CPPUNIT_TEST(test_small_lists);
+  CPPUNIT_TEST(test_prior_lists);
   CPPUNIT_TEST_SUITE_END();
 
 public:
+  typedef DocumentIndexManager::DocId DocId;
+
   void test_peek() {
     auto index = create_index();
 
@@ -37,21 +47,21 @@ public:
     auto reader = index->peek_term(space_cat->create_feature("3")->get_id());
     //print_document_id(reader.get());
 
-    auto cur_id = DocumentId(0);
+    auto cur_id = DocId(0);
     cur_id = reader->next(cur_id);
-    CPPUNIT_ASSERT_EQUAL(string("00000000-0001-0000-0000-000000000000"), cur_id.to_string());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0001-0000-0000-000000000000").to_string(), cur_id.to_string());
     CPPUNIT_ASSERT_DOUBLES_EQUAL(3.3, reader->read(), 0.0001);
 
     cur_id = reader->next(cur_id);
-    CPPUNIT_ASSERT_EQUAL(string("00000000-0002-0000-0000-000000000000"), cur_id.to_string());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0002-0000-0000-000000000000").to_string(), cur_id.to_string());
     CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, reader->read(), 0.0001);
 
     cur_id = reader->next(cur_id);
-    CPPUNIT_ASSERT_EQUAL(string("00000000-0003-0000-0000-000000000000"), cur_id.to_string());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0003-0000-0000-000000000000").to_string(), cur_id.to_string());
     CPPUNIT_ASSERT_DOUBLES_EQUAL(0.2, reader->read(), 0.0001);
 
     cur_id = reader->next(cur_id);
-    CPPUNIT_ASSERT_EQUAL(DocumentId(0).to_string(), cur_id.to_string());
+    CPPUNIT_ASSERT_EQUAL(DocId(0).to_string(), cur_id.to_string());
   }
 
   void test_exist_query() {
@@ -63,26 +73,29 @@ public:
         {space_ent->calculate_feature_id("zzz"), 5.0},
     }));
 
-    auto reader = index->query(request, query);
-    auto cur_id = DocumentId(0);
+    QueryPlanner::Plan plan = QueryPlanner::kPlanEmpty;
+    auto reader = index->query(request, query, &plan);
+    // a few short posting lists are accumulated
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanTaat, (int)plan);
+    auto cur_id = DocId(0);
     cur_id = reader->next(cur_id);
-    CPPUNIT_ASSERT_EQUAL(string("00000000-0001-0000-0000-000000000000"), cur_id.to_string());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0001-0000-0000-000000000000").to_string(), cur_id.to_string());
     CPPUNIT_ASSERT_DOUBLES_EQUAL(6.7, reader->read(), 0.00001);
 
     cur_id = reader->next(cur_id);
-    CPPUNIT_ASSERT_EQUAL(string("00000000-0002-0000-0000-000000000000"), cur_id.to_string());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0002-0000-0000-000000000000").to_string(), cur_id.to_string());
     CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, reader->read(), 0.00001);
 
     cur_id = reader->next(cur_id);
-    CPPUNIT_ASSERT_EQUAL(string("00000000-0003-0000-0000-000000000000"), cur_id.to_string());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0003-0000-0000-000000000000").to_string(), cur_id.to_string());
     CPPUNIT_ASSERT_DOUBLES_EQUAL(1.4, reader->read(), 0.00001);
 
     cur_id = reader->next(cur_id);
-    CPPUNIT_ASSERT_EQUAL(string("00000000-0005-0000-0000-000000000000"), cur_id.to_string());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0005-0000-0000-000000000000").to_string(), cur_id.to_string());
     CPPUNIT_ASSERT_DOUBLES_EQUAL(2.5, reader->read(), 0.00001);
 
     cur_id = reader->next(cur_id);
-    CPPUNIT_ASSERT_EQUAL(DocumentId(0).to_string(), cur_id.to_string());
+    CPPUNIT_ASSERT_EQUAL(DocId(0).to_string(), cur_id.to_string());
   }
 
   void test_noexist_query() {
@@ -93,11 +106,298 @@ public:
         {space_ent->calculate_feature_id("ooo"), 1.0},
     }));
 
-    auto reader = index->query(request, query);
+    QueryPlanner::Plan plan = QueryPlanner::kPlanTaat;
+    auto reader = index->query(request, query, &plan);
     CPPUNIT_ASSERT(!reader);
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanEmpty, (int)plan);
+  }
+
+  void test_parallel_query() {
+    auto index = create_index();
+    index->set_planner(QueryPlanner(0, 1, 4));
+    // no count, so that the postings are not accumulated
+    QueryRequest request("0001", 0, "", StopWatch(), true);
+    DocumentQuery query(request, IntermQuery({
+        {space_cat->calculate_feature_id("3"), 2.0},
+        {space_ent->calculate_feature_id("AA"), 1.0},
+        {space_ent->calculate_feature_id("zzz"), 5.0},
+    }));
+
+    QueryPlanner::Plan plan = QueryPlanner::kPlanEmpty;
+    auto reader = index->query(request, query, &plan);
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanParallel, (int)plan);
+    auto& partitions = static_cast<DocumentIndexManager::ParallelReader&>(*reader).get_partitions();
+    CPPUNIT_ASSERT_EQUAL(4, (int)partitions.size());
+
+    // iterated as a reader, the same documents as reading sequentially
+    auto cur_id = DocId(0);
+    cur_id = reader->next(cur_id);
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0001-0000-0000-000000000000").to_string(), cur_id.to_string());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6.7, reader->read(), 0.00001);
+    cur_id = reader->next(cur_id);
+    cur_id = reader->next(cur_id);
+    cur_id = reader->next(cur_id);
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0005-0000-0000-000000000000").to_string(), cur_id.to_string());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.5, reader->read(), 0.00001);
+    cur_id = reader->next(cur_id);
+    CPPUNIT_ASSERT_EQUAL(DocId(0).to_string(), cur_id.to_string());
+  }
+
+  void test_static_query() {
+    auto index = create_index();
+    index->set_planner(QueryPlanner(0));
+    QueryRequest request("0001", 0, "", StopWatch(), true);
+    DocumentQuery query(request, IntermQuery({
+        {space_cat->calculate_feature_id("3"), 2.0},
+        {space_ent->calculate_feature_id("AA"), 1.0},
+        {space_ent->calculate_feature_id("zzz"), 5.0},
+    }));
+
+    QueryPlanner::Plan plan = QueryPlanner::kPlanEmpty;
+    auto reader = index->query(request, query, &plan);
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanWand, (int)plan);
+    // all terms are read from btree posting lists
+    CPPUNIT_ASSERT(dynamic_cast<DocumentIndexManager::StaticWandReader<DocumentIndexManager::BTreeReader>*>(
+        reader.get()));
+
+    std::vector<std::pair<DocId, double>> results;
+    bool stopped = true;
+    CPPUNIT_ASSERT(reader->read_topn_static(2, 0.0, [] { return false; }, stopped, results));
+    CPPUNIT_ASSERT(!stopped);
+    CPPUNIT_ASSERT_EQUAL(2, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0001-0000-0000-000000000000").to_string(), results[0].first.to_string());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6.7, results[0].second, 0.00001);
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0002-0000-0000-000000000000").to_string(), results[1].first.to_string());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, results[1].second, 0.00001);
+  }
+
+  void test_sequential_query() {
+    auto index = create_index(DocumentIndexManager::kSequentialList);
+    index->set_planner(QueryPlanner(0));
+    QueryRequest request("0001", 0, "", StopWatch(), true);
+    DocumentQuery query(request, IntermQuery({
+        {space_cat->calculate_feature_id("3"), 2.0},
+        {space_ent->calculate_feature_id("AA"), 1.0},
+        {space_ent->calculate_feature_id("zzz"), 5.0},
+    }));
+
+    QueryPlanner::Plan plan = QueryPlanner::kPlanEmpty;
+    auto reader = index->query(request, query, &plan);
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanWand, (int)plan);
+    // all terms are read from sequential posting lists
+    CPPUNIT_ASSERT(dynamic_cast<DocumentIndexManager::StaticWandReader<DocumentIndexManager::SequentialReader>*>(
+        reader.get()));
+
+    std::vector<std::pair<DocId, double>> results;
+    bool stopped = true;
+    CPPUNIT_ASSERT(reader->read_topn_static(2, 0.0, [] { return false; }, stopped, results));
+    CPPUNIT_ASSERT_EQUAL(2, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0001-0000-0000-000000000000").to_string(), results[0].first.to_string());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6.7, results[0].second, 0.00001);
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0002-0000-0000-000000000000").to_string(), results[1].first.to_string());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, results[1].second, 0.00001);
+
+    // changed again after frozen
+    index->remove(DocId("00000000-0001-0000-0000-000000000000"));
+    index->do_maintain(0);
+    reader = index->query(request, query, &plan);
+    results.clear();
+    CPPUNIT_ASSERT(reader->read_topn_static(2, 0.0, [] { return false; }, stopped, results));
+    CPPUNIT_ASSERT_EQUAL(2, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0002-0000-0000-000000000000").to_string(), results[0].first.to_string());
+  }
+
+  void test_space_lists() {
+    CPPUNIT_ASSERT(DocumentIndexManager::create_list_factory(DocumentIndexManager::kTieredList));
+    CPPUNIT_ASSERT(DocumentIndexManager::create_list_factory(DocumentIndexManager::kQuantized8List));
+    CPPUNIT_ASSERT(!DocumentIndexManager::create_list_factory("unknown"));
+
+    // sequential posting lists for the entities, and btree ones for the others
+    auto index = create_index(DocumentIndexManager::kBTreeList,
+        {{space_ent->get_id(), DocumentIndexManager::kSequentialList}});
+    index->set_planner(QueryPlanner(0));
+    QueryRequest request("0001", 0, "", StopWatch(), true);
+    DocumentQuery query(request, IntermQuery({
+        {space_cat->calculate_feature_id("3"), 2.0},
+        {space_ent->calculate_feature_id("AA"), 1.0},
+        {space_ent->calculate_feature_id("zzz"), 5.0},
+    }));
+    auto reader = index->query(request, query);
+    // the terms are read from posting lists of different types
+    CPPUNIT_ASSERT(!dynamic_cast<DocumentIndexManager::StaticWandReader<DocumentIndexManager::BTreeReader>*>(
+        reader.get()));
+    CPPUNIT_ASSERT(!dynamic_cast<DocumentIndexManager::StaticWandReader<DocumentIndexManager::SequentialReader>*>(
+        reader.get()));
+    auto results = read_topn(*reader, 2);
+    CPPUNIT_ASSERT_EQUAL(2, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0001-0000-0000-000000000000").to_string(), results[0].first.to_string());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6.7, results[0].second, 0.00001);
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0002-0000-0000-000000000000").to_string(), results[1].first.to_string());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, results[1].second, 0.00001);
+
+    // only the entities are read statically
+    DocumentQuery entity_query(request, IntermQuery({
+        {space_ent->calculate_feature_id("AA"), 1.0},
+        {space_ent->calculate_feature_id("zzz"), 5.0},
+    }));
+    reader = index->query(request, entity_query);
+    CPPUNIT_ASSERT(dynamic_cast<DocumentIndexManager::StaticWandReader<DocumentIndexManager::SequentialReader>*>(
+        reader.get()));
+  }
+
+  void test_constant_lists() {
+    // the entities are weighted, so they are kept as sequential posting lists
+    auto index = create_index(DocumentIndexManager::kConstantList);
+    index->update(create_document(
+        "00000000-0006-0000-0000-000000000000",
+        {
+          { space_cat, {{"1001", 1.0}, {"3", 1.0}}},
+        }), 1);
+    index->do_maintain(0);
+    index->set_planner(QueryPlanner(0));
+    QueryRequest request("0001", 0, "", StopWatch(), true);
+    DocumentQuery query(request, IntermQuery({
+        {space_cat->calculate_feature_id("1001"), 2.0},
+        {space_cat->calculate_feature_id("1003"), 1.0},
+    }));
+    auto reader = index->query(request, query);
+    // both categories have constant weights
+    CPPUNIT_ASSERT(dynamic_cast<DocumentIndexManager::StaticWandReader<DocumentIndexManager::ConstantReader>*>(
+        reader.get()));
+    auto results = read_topn(*reader, 3);
+    CPPUNIT_ASSERT_EQUAL(3, (int)results.size());
+    // documents 4 and 6 tie
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, results[0].second, 0.00001);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, results[1].second, 0.00001);
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0005-0000-0000-000000000000").to_string(), results[2].first.to_string());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.3, results[2].second, 0.00001);
+
+    // weighted differently
+    DocumentQuery weighted_query(request, IntermQuery({
+        {space_cat->calculate_feature_id("3"), 1.0},
+        {space_ent->calculate_feature_id("AA"), 1.0},
+    }));
+    reader = index->query(request, weighted_query);
+    CPPUNIT_ASSERT(dynamic_cast<DocumentIndexManager::StaticWandReader<DocumentIndexManager::SequentialReader>*>(
+        reader.get()));
+  }
+
+  void test_small_lists() {
+    // the posting lists are all short enough
+    auto index = create_index(DocumentIndexManager::kSequentialList, DocumentIndexManager::SpaceLists(), true);
+    index->set_planner(QueryPlanner(0));
+    QueryRequest request("0001", 0, "", StopWatch(), true);
+    DocumentQuery query(request, IntermQuery({
+        {space_cat->calculate_feature_id("3"), 2.0},
+        {space_ent->calculate_feature_id("AA"), 1.0},
+        {space_ent->calculate_feature_id("zzz"), 5.0},
+    }));
+    auto reader = index->query(request, query);
+    CPPUNIT_ASSERT(dynamic_cast<DocumentIndexManager::StaticWandReader<DocumentIndexManager::SmallReader>*>(
+        reader.get()));
+    auto results = read_topn(*reader, 2);
+    CPPUNIT_ASSERT_EQUAL(2, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0001-0000-0000-000000000000").to_string(), results[0].first.to_string());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6.7, results[0].second, 0.00001);
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0002-0000-0000-000000000000").to_string(), results[1].first.to_string());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, results[1].second, 0.00001);
+
+    // grown larger than small posting lists
+    for (int i = 10; i < 20; ++i) {
+      index->update(create_document("00000000-00" + std::to_string(i) + "-0000-0000-000000000000",
+          {{ space_ent, {{"zzz", 0.1}}}}), 1);
+    }
+    index->do_maintain(0);
+    reader = index->query(request, query);
+    CPPUNIT_ASSERT(!dynamic_cast<DocumentIndexManager::StaticWandReader<DocumentIndexManager::SmallReader>*>(
+        reader.get()));
+    // still composed statically, the small posting lists are read with the sequential ones
+    CPPUNIT_ASSERT(dynamic_cast<DocumentIndexManager::StaticWandReader<
+        DocumentIndexManager::SmallOrSequentialReader>*>(reader.get()));
+    results = read_topn(*reader, 20);
+    CPPUNIT_ASSERT_EQUAL(14, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0001-0000-0000-000000000000").to_string(), results[0].first.to_string());
+  }
+
+  void test_prior_lists() {
+    auto index = create_index(DocumentIndexManager::kBTreeList,
+        {{space_pop->get_id(), DocumentIndexManager::kPriorList}});
+    index->update(create_document("00000000-0006-0000-0000-000000000000",
+        {{ space_cat, {{"3", 1.0}}}, { space_pop, {{"0", 5.0}}}}), 1);
+    index->update(create_document("00000000-0007-0000-0000-000000000000",
+        {{ space_pop, {{"0", 100.0}}}}), 1);
+    index->update(create_document("00000000-0008-0000-0000-000000000000",
+        {{ space_cat, {{"3", 0.5}}}, { space_pop, {{"0", 1.0}}}}), 1);
+    index->do_maintain(0);
+    index->set_planner(QueryPlanner(0));
+    QueryRequest request("0001", 0, "", StopWatch(), true);
+    DocumentQuery query(request, IntermQuery({
+        {space_cat->calculate_feature_id("3"), 1.0},
+        {space_pop->calculate_feature_id("0"), 1.0},
+    }));
+
+    // a single term with the prior is read by WAND
+    QueryPlanner::Plan plan = QueryPlanner::kPlanEmpty;
+    auto reader = index->query(request, query, &plan);
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanWand, (int)plan);
+    CPPUNIT_ASSERT(dynamic_cast<DocumentIndexManager::StaticWandReader<DocumentIndexManager::BTreeReader>*>(
+        reader.get()));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(103.3, reader->upper_bound(), 0.00001);
+    // only the documents of the category, document 7 is not found
+    auto results = read_topn(*reader, 10);
+    CPPUNIT_ASSERT_EQUAL(5, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0006-0000-0000-000000000000").to_string(), results[0].first.to_string());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0, results[0].second, 0.00001);
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0001-0000-0000-000000000000").to_string(), results[1].first.to_string());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.3, results[1].second, 0.00001);
+    // documents 2 and 8 tie
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, results[2].second, 0.00001);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.5, results[3].second, 0.00001);
+
+    // the same by the parallel partitions
+    index->set_planner(QueryPlanner(0, 1, 4));
+    DocumentQuery parallel_query(request, IntermQuery({
+        {space_cat->calculate_feature_id("3"), 1.0},
+        {space_cat->calculate_feature_id("1001"), 1.0},
+        {space_pop->calculate_feature_id("0"), 1.0},
+    }));
+    reader = index->query(request, parallel_query, &plan);
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanParallel, (int)plan);
+    results = read_topn(*reader, 10);
+    CPPUNIT_ASSERT_EQUAL(6, (int)results.size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0, results[0].second, 0.00001);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, results[4].second, 0.00001);
+
+    // the most popular documents, read as a term
+    DocumentQuery pop_query(request, IntermQuery({{space_pop->calculate_feature_id("0"), 1.0}}));
+    reader = index->query(request, pop_query);
+    results = read_topn(*reader, 1);
+    CPPUNIT_ASSERT_EQUAL(1, (int)results.size());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0007-0000-0000-000000000000").to_string(), results[0].first.to_string());
+
+    // the same by a batch
+    IntermQuery interm_query({
+        {space_cat->calculate_feature_id("3"), 1.0},
+        {space_pop->calculate_feature_id("0"), 1.0},
+    });
+    IntermQuery pop_interm_query({{space_pop->calculate_feature_id("0"), 1.0}});
+    bool stopped = true;
+    auto batch_results = index->batch_search({&interm_query, &pop_interm_query}, {10, 1}, {0, 0},
+        [] { return false; }, stopped);
+    CPPUNIT_ASSERT(!stopped);
+    CPPUNIT_ASSERT_EQUAL(5, (int)batch_results[0].size());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0006-0000-0000-000000000000").to_string(),
+        batch_results[0][0].first.to_string());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0, batch_results[0][0].second, 0.00001);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.3, batch_results[0][1].second, 0.00001);
+    CPPUNIT_ASSERT_EQUAL(1, (int)batch_results[1].size());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0007-0000-0000-000000000000").to_string(),
+        batch_results[1][0].first.to_string());
   }
 
 private:
+  std::shared_ptr<FeatureSpace> space_pop =
+      std::make_shared<FeatureSpace>("popularity", 20, FeatureSpace::SpaceType::kInteger);
   std::shared_ptr<FeatureSpace> space_cat =
       std::make_shared<FeatureSpace>("category", 1, FeatureSpace::SpaceType::kInteger);
   std::shared_ptr<FeatureSpace> space_ent =
@@ -116,8 +416,11 @@ private:
     return doc;
   }
 
-  std::unique_ptr<DocumentIndexManager> create_index() {
-    auto index = std::unique_ptr<DocumentIndexManager>(new DocumentIndexManager(1000, 1000));
+  std::unique_ptr<DocumentIndexManager> create_index(const std::string& default_list = DocumentIndexManager::kBTreeList,
+      const DocumentIndexManager::SpaceLists& space_lists = DocumentIndexManager::SpaceLists(),
+      bool small_lists = false) {
+    auto index = std::unique_ptr<DocumentIndexManager>(new DocumentIndexManager(1000, 1000,
+        space_lists, default_list, small_lists));
     // create document vectors
     index->update(create_document(
         "00000000-0001-0000-0000-000000000000",
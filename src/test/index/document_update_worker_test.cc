@@ -0,0 +1,149 @@
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "data/binary_format.h"
+#include "data/document_parser.h"
+#include "data/document_update_request.h"
+#include "data/feature_space_manager.h"
+#include "index/document_index_manager.h"
+#include "index/document_update_worker.h"
+#include "utils/stats.h"
+
+using namespace std;
+
+namespace redgiant {
+class DocumentUpdateWorkerTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(DocumentUpdateWorkerTest);
+  CPPUNIT_TEST(test_parsed_document);
+  CPPUNIT_TEST(test_raw_content);
+  CPPUNIT_TEST(test_parse_error);
+  CPPUNIT_TEST(test_binary_content);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void test_parsed_document() {
+    DocumentIndexManager index(1000, 1000);
+    auto worker = create_worker(&index);
+
+    auto doc = make_shared<Document>("00000000-0001-0000-0000-000000000000");
+    FeatureVector vec(feature_spaces->get_space("entity"));
+    vec.add_feature("aa", 1.0);
+    doc->add_feature_vector(move(vec));
+    DocumentUpdateRequest job(doc, 1);
+    worker->execute(job);
+    index.do_maintain(0);
+
+    CPPUNIT_ASSERT_EQUAL(1, (int)index.get_index().get_term_count());
+    CPPUNIT_ASSERT_EQUAL(0, (int)parse_errors);
+  }
+
+  void test_raw_content() {
+    DocumentIndexManager index(1000, 1000);
+    auto worker = create_worker(&index);
+
+    string content = R"({"features": {"category": ["1", "2"], "entity": {"aa": 0.5}}})";
+    DocumentUpdateRequest job("00000000-0001-0000-0000-000000000000", content, 1);
+    worker->execute(job);
+    index.do_maintain(0);
+
+    CPPUNIT_ASSERT_EQUAL(3, (int)index.get_index().get_term_count());
+    auto reader = index.peek_term(feature_spaces->get_space("entity")->calculate_feature_id("aa"));
+    DocumentIndexManager::DocId doc_id = reader->next(DocumentIndexManager::DocId(0));
+    CPPUNIT_ASSERT_EQUAL(DocumentIndexManager::DocId("00000000-0001-0000-0000-000000000000").to_string(), doc_id.to_string());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, reader->read(), 0.0001);
+    CPPUNIT_ASSERT_EQUAL(0, (int)parse_errors);
+  }
+
+  void test_parse_error() {
+    DocumentIndexManager index(1000, 1000);
+    auto worker = create_worker(&index);
+
+    DocumentUpdateRequest job_bad_json("", R"({"features": )", 1);
+    worker->execute(job_bad_json);
+    // no uuid given in either request or content
+    DocumentUpdateRequest job_no_uuid("", R"({"features": {"category": "1"}})", 1);
+    worker->execute(job_no_uuid);
+    index.do_maintain(0);
+
+    CPPUNIT_ASSERT_EQUAL(0, (int)index.get_index().get_term_count());
+    CPPUNIT_ASSERT_EQUAL(2, (int)parse_errors);
+  }
+
+  void test_binary_content() {
+    DocumentIndexManager index(1000, 1000);
+    auto worker = create_worker(&index);
+
+    auto entity = feature_spaces->get_space("entity");
+    string content;
+    append_binary_document(content, "00000000-0001-0000-0000-000000000000",
+        {{entity->calculate_feature_id("aa"), 0.5f}});
+    append_binary_document(content, "00000000-0002-0000-0000-000000000000",
+        {{entity->calculate_feature_id("aa"), 1.0f}, {entity->calculate_feature_id("bb"), 1.0f}});
+    DocumentUpdateRequest job("", content, 1, true);
+    worker->execute(job);
+    index.do_maintain(0);
+
+    CPPUNIT_ASSERT_EQUAL(2, (int)index.get_index().get_term_count());
+    auto reader = index.peek_term(entity->calculate_feature_id("aa"));
+    DocumentIndexManager::DocId doc_id = reader->next(DocumentIndexManager::DocId(0));
+    CPPUNIT_ASSERT_EQUAL(DocumentIndexManager::DocId("00000000-0001-0000-0000-000000000000").to_string(), doc_id.to_string());
+    doc_id = reader->next(doc_id);
+    CPPUNIT_ASSERT_EQUAL(DocumentIndexManager::DocId("00000000-0002-0000-0000-000000000000").to_string(), doc_id.to_string());
+
+    // the trailing broken record is dropped
+    DocumentUpdateRequest job_bad("", content.substr(0, content.size() - 1), 1, true);
+    worker->execute(job_bad);
+    CPPUNIT_ASSERT_EQUAL(1, (int)parse_errors);
+
+    // none of the records is updated if any of them is broken
+    string content_bad;
+    append_binary_document(content_bad, "00000000-0003-0000-0000-000000000000",
+        {{entity->calculate_feature_id("cc"), 1.0f}});
+    content_bad += content.substr(0, content.size() - 1);
+    DocumentUpdateRequest job_partial("", content_bad, 1, true);
+    worker->execute(job_partial);
+    index.do_maintain(0);
+    CPPUNIT_ASSERT_EQUAL(2, (int)parse_errors);
+    CPPUNIT_ASSERT_EQUAL(2, (int)index.get_index().get_term_count());
+    CPPUNIT_ASSERT(!index.peek_term(entity->calculate_feature_id("cc")));
+  }
+
+  void setUp() {
+    feature_spaces = make_shared<FeatureSpaceManager>();
+    feature_spaces->create_space("category", 1, FeatureSpace::SpaceType::kInteger);
+    feature_spaces->create_space("entity", 2, FeatureSpace::SpaceType::kString);
+    parse_errors = 0;
+  }
+
+private:
+  void append_binary_document(string& out, const string& uuid, const vector<pair<uint64_t, float>>& features) {
+    BinaryFormat::write_uint32(BinaryFormat::kDocIdSize + BinaryFormat::kCountSize
+        + features.size() * BinaryFormat::kFeatureSize, out);
+    char raw[DocumentId::kRawSize];
+    DocumentId(uuid).to_raw(raw);
+    out.append(raw, sizeof(raw));
+    BinaryFormat::write_uint32(features.size(), out);
+    for (const auto& f: features) {
+      BinaryFormat::write_uint64(f.first, out);
+      BinaryFormat::write_float(f.second, out);
+    }
+  }
+
+  unique_ptr<DocumentUpdateWorker> create_worker(DocumentIndexManager* index) {
+    FeedDocumentWorkerFactory factory(index,
+        make_shared<DocumentParserFactory>(feature_spaces), &parse_errors);
+    return factory.create();
+  }
+
+  shared_ptr<FeatureSpaceManager> feature_spaces;
+  Stats::Counter parse_errors;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DocumentUpdateWorkerTest);
+}
@@ -0,0 +1,90 @@
+#include <string>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "index/query_planner.h"
+
+namespace redgiant {
+class QueryPlannerTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(QueryPlannerTest);
+  CPPUNIT_TEST(test_empty_single);
+  CPPUNIT_TEST(test_taat);
+  CPPUNIT_TEST(test_wand);
+  CPPUNIT_TEST(test_max_score);
+  CPPUNIT_TEST(test_parallel);
+  CPPUNIT_TEST(test_plan_name);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  QueryPlannerTest() = default;
+  virtual ~QueryPlannerTest() = default;
+
+protected:
+  void test_empty_single() {
+    QueryPlanner planner;
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanEmpty, (int)planner.plan({}, 10));
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanSingle, (int)planner.plan({{100000, 1.0}}, 10));
+  }
+
+  void test_taat() {
+    QueryPlanner planner(1000);
+    // short posting lists
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanTaat, (int)planner.plan({{500, 1.0}, {500, 1.0}}, 10));
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanWand, (int)planner.plan({{500, 1.0}, {501, 1.0}}, 10));
+    // asking for a large part of the postings
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanTaat, (int)planner.plan({{5000, 1.0}, {5000, 1.0}}, 1000));
+  }
+
+  void test_wand() {
+    QueryPlanner planner(1000);
+    std::vector<QueryPlanner::TermStats> terms(3, {10000, 1.0});
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanWand, (int)planner.plan(terms, 10));
+    // many terms of even upper bounds
+    terms.assign(10, {10000, 1.0});
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanWand, (int)planner.plan(terms, 10));
+  }
+
+  void test_max_score() {
+    QueryPlanner planner(1000);
+    // many terms, the lower half could not beat the greatest one
+    std::vector<QueryPlanner::TermStats> terms(10, {10000, 0.1});
+    terms[0].upper_bound = 1.0;
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanMaxScore, (int)planner.plan(terms, 10));
+    // not enough terms
+    terms.resize(4);
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanWand, (int)planner.plan(terms, 10));
+  }
+
+  void test_parallel() {
+    // disabled by default
+    QueryPlanner disabled(1000);
+    std::vector<QueryPlanner::TermStats> terms(3, {100000, 1.0});
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanWand, (int)disabled.plan(terms, 10));
+
+    QueryPlanner planner(1000, 300000, 4);
+    CPPUNIT_ASSERT_EQUAL((size_t)4, planner.get_parallel_partitions());
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanParallel, (int)planner.plan(terms, 10));
+    // also for skewed upper bounds
+    terms.assign(10, {100000, 0.1});
+    terms[0].upper_bound = 1.0;
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanParallel, (int)planner.plan(terms, 10));
+    // not enough postings
+    terms.assign(2, {100000, 1.0});
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanWand, (int)planner.plan(terms, 10));
+    // short posting lists are still accumulated
+    terms.assign(2, {500, 1.0});
+    CPPUNIT_ASSERT_EQUAL((int)QueryPlanner::kPlanTaat, (int)planner.plan(terms, 10));
+  }
+
+  void test_plan_name() {
+    CPPUNIT_ASSERT_EQUAL(std::string("taat"), std::string(QueryPlanner::get_plan_name(QueryPlanner::kPlanTaat)));
+    CPPUNIT_ASSERT_EQUAL(std::string("max_score"),
+        std::string(QueryPlanner::get_plan_name(QueryPlanner::kPlanMaxScore)));
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(QueryPlannerTest);
+
+} /* namespace redgiant */
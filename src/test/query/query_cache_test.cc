@@ -0,0 +1,107 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "data/interm_query.h"
+#include "query/query_cache.h"
+#include "utils/stats.h"
+
+using namespace std;
+
+namespace redgiant {
+class QueryCacheTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(QueryCacheTest);
+  CPPUNIT_TEST(test_key);
+  CPPUNIT_TEST(test_get_put);
+  CPPUNIT_TEST(test_evict);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  QueryCacheTest() = default;
+  virtual ~QueryCacheTest() = default;
+
+protected:
+  void test_key() {
+    QueryCache::Key key1(IntermQuery({{1, 1.0}, {2, 0.5}}), 10);
+    // order does not matter
+    QueryCache::Key key2(IntermQuery({{2, 0.5}, {1, 1.0}}), 10);
+    // weights quantized
+    QueryCache::Key key3(IntermQuery({{2, 0.5000001}, {1, 1.0}}), 10);
+    // different count
+    QueryCache::Key key4(IntermQuery({{1, 1.0}, {2, 0.5}}), 20);
+    // different weight
+    QueryCache::Key key5(IntermQuery({{1, 1.0}, {2, 0.6}}), 10);
+    // different feature
+    QueryCache::Key key6(IntermQuery({{1, 1.0}, {3, 0.5}}), 10);
+
+    CPPUNIT_ASSERT(key1 == key2);
+    CPPUNIT_ASSERT_EQUAL(key1.get_hash(), key2.get_hash());
+    CPPUNIT_ASSERT(key1 == key3);
+    CPPUNIT_ASSERT(!(key1 == key4));
+    CPPUNIT_ASSERT(!(key1 == key5));
+    CPPUNIT_ASSERT(!(key1 == key6));
+  }
+
+  void test_get_put() {
+    Stats stats;
+    QueryCache cache(10, 2, &stats);
+    QueryCache::Key key(IntermQuery({{1, 1.0}}), 10);
+
+    CPPUNIT_ASSERT(!cache.get(key, 1));
+    cache.put(key, 1, create_results({"a", "b"}));
+    auto results = cache.get(key, 1);
+    CPPUNIT_ASSERT(!!results);
+    CPPUNIT_ASSERT_EQUAL(2, (int)results->size());
+    CPPUNIT_ASSERT_EQUAL(string("a"), (*results)[0].first);
+
+    // index changed
+    CPPUNIT_ASSERT(!cache.get(key, 2));
+    CPPUNIT_ASSERT_EQUAL(0, (int)cache.size());
+
+    CPPUNIT_ASSERT_EQUAL(1, (int)stats.get_counter("query_cache.hit")->load());
+    CPPUNIT_ASSERT_EQUAL(2, (int)stats.get_counter("query_cache.miss")->load());
+    CPPUNIT_ASSERT_EQUAL(1, (int)stats.get_counter("query_cache.stale")->load());
+  }
+
+  void test_evict() {
+    Stats stats;
+    // a single shard, to test the order of eviction
+    QueryCache cache(3, 1, &stats);
+    vector<QueryCache::Key> keys;
+    for (int i = 0; i < 4; ++i) {
+      keys.emplace_back(IntermQuery({{(IntermQuery::FeatureId)i, 1.0}}), 10);
+    }
+    cache.put(keys[0], 1, create_results({"0"}));
+    cache.put(keys[1], 1, create_results({"1"}));
+    cache.put(keys[2], 1, create_results({"2"}));
+    // 0 is used recently, 1 will be evicted
+    CPPUNIT_ASSERT(!!cache.get(keys[0], 1));
+    cache.put(keys[3], 1, create_results({"3"}));
+
+    CPPUNIT_ASSERT_EQUAL(3, (int)cache.size());
+    CPPUNIT_ASSERT_EQUAL(1, (int)stats.get_counter("query_cache.evict")->load());
+    CPPUNIT_ASSERT(!!cache.get(keys[0], 1));
+    CPPUNIT_ASSERT(!cache.get(keys[1], 1));
+    CPPUNIT_ASSERT(!!cache.get(keys[2], 1));
+    CPPUNIT_ASSERT(!!cache.get(keys[3], 1));
+  }
+
+private:
+  std::shared_ptr<const QueryCache::Results> create_results(const vector<string>& ids) {
+    auto results = std::make_shared<QueryCache::Results>();
+    double score = 10.0;
+    for (auto& id: ids) {
+      results->emplace_back(id, score);
+      score -= 1.0;
+    }
+    return results;
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(QueryCacheTest);
+
+} /* namespace redgiant */
@@ -0,0 +1,150 @@
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "data/interm_query.h"
+#include "query/query_coalescer.h"
+#include "utils/stats.h"
+
+using namespace std;
+
+namespace redgiant {
+class QueryCoalescerTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(QueryCoalescerTest);
+  CPPUNIT_TEST(test_single);
+  CPPUNIT_TEST(test_coalesce);
+  CPPUNIT_TEST(test_wait_timeout);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  QueryCoalescerTest() = default;
+  virtual ~QueryCoalescerTest() = default;
+
+protected:
+  void test_single() {
+    QueryCoalescer coalescer(4);
+    QueryCache::Key key(IntermQuery({{1, 1.0}}), 10);
+    bool leader = false;
+    auto results = coalescer.execute(key, 1, [] { return create_results("a"); }, &leader);
+    CPPUNIT_ASSERT(leader);
+    CPPUNIT_ASSERT_EQUAL(string("a"), (*results)[0].first);
+    // not in flight any more
+    CPPUNIT_ASSERT_EQUAL(0, (int)coalescer.size());
+    results = coalescer.execute(key, 1, [] { return create_results("b"); }, &leader);
+    CPPUNIT_ASSERT(leader);
+    CPPUNIT_ASSERT_EQUAL(string("b"), (*results)[0].first);
+  }
+
+  void test_coalesce() {
+    Stats stats;
+    QueryCoalescer coalescer(4, &stats);
+    QueryCache::Key key(IntermQuery({{1, 1.0}, {2, 2.0}}), 10);
+    QueryCache::Key other_key(IntermQuery({{1, 1.0}}), 10);
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<int> executed { 0 };
+
+    // the leader blocks until released
+    std::thread leader_thread([&] {
+      bool leader = false;
+      auto results = coalescer.execute(key, 1, [&] {
+        executed++;
+        released.wait();
+        return create_results("leader");
+      }, &leader);
+      CPPUNIT_ASSERT(leader);
+      CPPUNIT_ASSERT_EQUAL(string("leader"), (*results)[0].first);
+    });
+    while (coalescer.size() == 0) {
+      std::this_thread::yield();
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<std::string> shared_results(4);
+    for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([&, i] {
+        bool leader = true;
+        auto results = coalescer.execute(key, 1, [&] {
+          executed++;
+          return create_results("follower");
+        }, &leader);
+        CPPUNIT_ASSERT(!leader);
+        shared_results[i] = (*results)[0].first;
+      });
+    }
+
+    // different queries and generations are not blocked
+    bool leader = false;
+    auto results = coalescer.execute(other_key, 1, [] { return create_results("other"); }, &leader);
+    CPPUNIT_ASSERT(leader);
+    results = coalescer.execute(key, 2, [] { return create_results("newer"); }, &leader);
+    CPPUNIT_ASSERT(leader);
+    CPPUNIT_ASSERT_EQUAL(string("newer"), (*results)[0].first);
+
+    // let the followers wait for the leader
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    release.set_value();
+    leader_thread.join();
+    for (auto& thread: threads) {
+      thread.join();
+    }
+
+    CPPUNIT_ASSERT_EQUAL(1, executed.load());
+    for (auto& r: shared_results) {
+      CPPUNIT_ASSERT_EQUAL(string("leader"), r);
+    }
+    CPPUNIT_ASSERT_EQUAL(4, (int)stats.get_counter("query_coalescer.shared")->load());
+    CPPUNIT_ASSERT_EQUAL(0, (int)coalescer.size());
+  }
+
+  void test_wait_timeout() {
+    Stats stats;
+    QueryCoalescer coalescer(4, &stats);
+    QueryCache::Key key(IntermQuery({{1, 1.0}}), 10);
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::thread leader_thread([&] {
+      coalescer.execute(key, 1, [&] {
+        released.wait();
+        return create_results("leader");
+      });
+    });
+    while (coalescer.size() == 0) {
+      std::this_thread::yield();
+    }
+
+    // the leader takes longer than the budget of the follower, which searches by itself
+    bool leader = false;
+    auto results = coalescer.execute(key, 1, [] { return create_results("follower"); }, &leader, 10000);
+    CPPUNIT_ASSERT(leader);
+    CPPUNIT_ASSERT_EQUAL(string("follower"), (*results)[0].first);
+    CPPUNIT_ASSERT_EQUAL(1, (int)stats.get_counter("query_coalescer.wait_timeout")->load());
+    CPPUNIT_ASSERT_EQUAL(0, (int)stats.get_counter("query_coalescer.shared")->load());
+    // still in flight
+    CPPUNIT_ASSERT_EQUAL(1, (int)coalescer.size());
+
+    release.set_value();
+    leader_thread.join();
+    CPPUNIT_ASSERT_EQUAL(0, (int)coalescer.size());
+  }
+
+private:
+  static std::shared_ptr<const QueryCoalescer::Results> create_results(const string& id) {
+    auto results = std::make_shared<QueryCoalescer::Results>();
+    results->emplace_back(id, 1.0);
+    return results;
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(QueryCoalescerTest);
+
+} /* namespace redgiant */
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "data/query_request.h"
+#include "data/query_result.h"
+#include "query/query_executor.h"
+#include "query/query_job.h"
+#include "query/query_pipeline.h"
+
+using namespace std;
+
+namespace redgiant {
+class QueryPipelineTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(QueryPipelineTest);
+  CPPUNIT_TEST(test_execute);
+  CPPUNIT_TEST(test_execute_batch);
+  CPPUNIT_TEST(test_try_schedule);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  QueryPipelineTest() = default;
+  virtual ~QueryPipelineTest() = default;
+
+  // returns the request id as the only result, with the executing thread counted.
+  class MockExecutor: public QueryExecutor {
+  public:
+    virtual std::unique_ptr<QueryResult> execute(const QueryRequest& request) {
+      auto result = request.create_result();
+      result->get_results().emplace_back(request.get_request_id(), (double)request.get_query_count());
+      return result;
+    }
+  };
+
+  class MockExecutorFactory: public QueryExecutorFactory {
+  public:
+    std::atomic<int> created { 0 };
+
+    virtual std::unique_ptr<QueryExecutor> create_executor() {
+      created++;
+      return std::unique_ptr<QueryExecutor>(new MockExecutor());
+    }
+  };
+
+  // blocks until released, after counting the queries started.
+  class BlockingExecutor: public MockExecutor {
+  public:
+    BlockingExecutor(std::shared_future<void> released, std::atomic<int>* started)
+    : released_(std::move(released)), started_(started) {
+    }
+
+    virtual std::unique_ptr<QueryResult> execute(const QueryRequest& request) {
+      (*started_)++;
+      released_.wait();
+      return MockExecutor::execute(request);
+    }
+
+  private:
+    std::shared_future<void> released_;
+    std::atomic<int>* started_;
+  };
+
+  class BlockingExecutorFactory: public QueryExecutorFactory {
+  public:
+    std::promise<void> release;
+    std::atomic<int> started { 0 };
+
+    virtual std::unique_ptr<QueryExecutor> create_executor() {
+      return std::unique_ptr<QueryExecutor>(new BlockingExecutor(released_, &started));
+    }
+
+  private:
+    std::shared_future<void> released_ = release.get_future().share();
+  };
+
+protected:
+  void test_execute() {
+    auto factory = std::make_shared<MockExecutorFactory>();
+    QueryPipeline pipeline(2, 16, factory);
+    pipeline.start();
+    // one executor per worker
+    CPPUNIT_ASSERT_EQUAL(2, factory->created.load());
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<std::pair<std::string, double>> results;
+    std::vector<std::thread::id> threads;
+    int count = 10;
+    for (int i = 0; i < count; ++i) {
+      QueryRequest request("q" + std::to_string(i), i + 1, "");
+      pipeline.schedule(std::make_shared<QueryJob>(std::move(request),
+          [&] (const QueryRequest& request, std::unique_ptr<QueryResult> result) {
+            std::lock_guard<std::mutex> lock(mutex);
+            CPPUNIT_ASSERT(!!result);
+            CPPUNIT_ASSERT_EQUAL(request.get_request_id(), result->get_request_id());
+            results.push_back(result->get_results()[0]);
+            threads.push_back(std::this_thread::get_id());
+            cond.notify_one();
+          }));
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cond.wait(lock, [&] { return (int)results.size() == count; });
+    }
+    pipeline.stop();
+
+    std::sort(results.begin(), results.end(),
+        [] (const std::pair<std::string, double>& a, const std::pair<std::string, double>& b) {
+          return a.second < b.second;
+        });
+    for (int i = 0; i < count; ++i) {
+      CPPUNIT_ASSERT_EQUAL("q" + std::to_string(i), results[i].first);
+    }
+    // executed in the worker threads
+    for (auto& thread_id: threads) {
+      CPPUNIT_ASSERT(thread_id != std::this_thread::get_id());
+    }
+  }
+
+  void test_execute_batch() {
+    auto factory = std::make_shared<MockExecutorFactory>();
+    QueryPipeline pipeline(2, 16, factory);
+    pipeline.start();
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<std::unique_ptr<QueryResult>> results;
+    std::thread::id thread;
+    bool done = false;
+    std::vector<QueryRequest> requests;
+    for (int i = 0; i < 3; ++i) {
+      requests.emplace_back("q" + std::to_string(i), i + 1, "");
+    }
+    auto job = std::make_shared<QueryJob>(std::move(requests),
+        [&] (std::vector<std::unique_ptr<QueryResult>> batch_results) {
+          std::lock_guard<std::mutex> lock(mutex);
+          results = std::move(batch_results);
+          thread = std::this_thread::get_id();
+          done = true;
+          cond.notify_one();
+        });
+    CPPUNIT_ASSERT(job->is_batch());
+    pipeline.schedule(job);
+
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cond.wait(lock, [&] { return done; });
+    }
+    pipeline.stop();
+
+    // all the queries are executed in one worker thread, in order
+    CPPUNIT_ASSERT_EQUAL((size_t)3, results.size());
+    for (int i = 0; i < 3; ++i) {
+      CPPUNIT_ASSERT(!!results[i]);
+      CPPUNIT_ASSERT_EQUAL("q" + std::to_string(i), results[i]->get_results()[0].first);
+    }
+    CPPUNIT_ASSERT(thread != std::this_thread::get_id());
+  }
+
+  void test_try_schedule() {
+    auto factory = std::make_shared<BlockingExecutorFactory>();
+    QueryPipeline pipeline(1, 1, factory);
+    pipeline.start();
+
+    std::atomic<int> done { 0 };
+    auto create_job = [&done] (const std::string& id) {
+      return std::make_shared<QueryJob>(QueryRequest(id, 1, ""),
+          [&done] (const QueryRequest& request, std::unique_ptr<QueryResult> result) {
+            (void) request;
+            (void) result;
+            done++;
+          });
+    };
+    // the only worker is busy with the first one, and the second one fills the queue
+    CPPUNIT_ASSERT(pipeline.try_schedule(create_job("q0")));
+    while (factory->started.load() == 0) {
+      std::this_thread::yield();
+    }
+    CPPUNIT_ASSERT(pipeline.try_schedule(create_job("q1")));
+    // rejected at once instead of waiting
+    CPPUNIT_ASSERT(!pipeline.try_schedule(create_job("q2")));
+
+    factory->release.set_value();
+    while (done.load() < 2) {
+      std::this_thread::yield();
+    }
+    pipeline.stop();
+    CPPUNIT_ASSERT_EQUAL(2, done.load());
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(QueryPipelineTest);
+
+} /* namespace redgiant */
@@ -12,9 +12,11 @@
 #include "data/feature_vector.h"
 #include "data/feature_space_manager.h"
 #include "index/document_index_manager.h"
+#include "query/query_cache.h"
 #include "query/simple_query_executor.h"
 #include "ranking/direct_model.h"
 #include "utils/logger.h"
+#include "utils/stats.h"
 
 using namespace std;
 
@@ -25,9 +27,14 @@ class SimpleQueryExecutorTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(test_execute_1);
   CPPUNIT_TEST(test_execute_2);
   CPPUNIT_TEST(test_execute_3);
+  CPPUNIT_TEST(test_execute_cached);
+  CPPUNIT_TEST(test_execute_batch);
+  CPPUNIT_TEST(test_execute_min_score);
   CPPUNIT_TEST_SUITE_END();
 
 public:
+  typedef DocumentIndexManager::DocId DocId;
+
   SimpleQueryExecutorTest() = default;
   virtual ~SimpleQueryExecutorTest() = default;
 
@@ -56,16 +63,16 @@ protected:
     auto ids = result->get_results();
     CPPUNIT_ASSERT_EQUAL(4, (int)ids.size());
 
-    CPPUNIT_ASSERT_EQUAL(string("00000000-0001-0000-0000-000000000000"), ids[0].first);
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0001-0000-0000-000000000000").to_string(), ids[0].first);
     CPPUNIT_ASSERT_DOUBLES_EQUAL(6.7, ids[0].second, 0.00001);
 
-    CPPUNIT_ASSERT_EQUAL(string("00000000-0002-0000-0000-000000000000"), ids[1].first);
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0002-0000-0000-000000000000").to_string(), ids[1].first);
     CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, ids[1].second, 0.00001);
 
-    CPPUNIT_ASSERT_EQUAL(string("00000000-0005-0000-0000-000000000000"), ids[2].first);
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0005-0000-0000-000000000000").to_string(), ids[2].first);
     CPPUNIT_ASSERT_DOUBLES_EQUAL(2.5, ids[2].second, 0.00001);
 
-    CPPUNIT_ASSERT_EQUAL(string("00000000-0003-0000-0000-000000000000"), ids[3].first);
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0003-0000-0000-000000000000").to_string(), ids[3].first);
     CPPUNIT_ASSERT_DOUBLES_EQUAL(1.4, ids[3].second, 0.00001);
   }
 
@@ -83,10 +90,10 @@ protected:
     auto ids = result->get_results();
     CPPUNIT_ASSERT_EQUAL(2, (int)ids.size());
 
-    CPPUNIT_ASSERT_EQUAL(string("00000000-0001-0000-0000-000000000000"), ids[0].first);
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0001-0000-0000-000000000000").to_string(), ids[0].first);
     CPPUNIT_ASSERT_DOUBLES_EQUAL(6.6, ids[0].second, 0.00001);
 
-    CPPUNIT_ASSERT_EQUAL(string("00000000-0002-0000-0000-000000000000"), ids[1].first);
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0002-0000-0000-000000000000").to_string(), ids[1].first);
     CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, ids[1].second, 0.00001);
   }
 
@@ -105,6 +112,114 @@ protected:
     CPPUNIT_ASSERT_EQUAL(0, (int)ids.size());
   }
 
+  void test_execute_cached() {
+    auto feature_spaces = create_feature_spaces();
+    auto model = create_model();
+    auto index = create_index(*feature_spaces);
+    Stats stats;
+    QueryCache cache(100, 4, &stats);
+    auto executor = SimpleQueryExecutorFactory(index.get(), model.get(), &cache).create_executor();
+
+    auto request = std::make_shared<QueryRequest>("0004", 2, "");
+    request->add_feature_vector(FeatureVector(feature_spaces->get_space("category"), {{"3", 2.0}}));
+
+    auto result = executor->execute(*request);
+    CPPUNIT_ASSERT_EQUAL(2, (int)result->get_results().size());
+    CPPUNIT_ASSERT_EQUAL(0, (int)stats.get_counter("query_cache.hit")->load());
+    CPPUNIT_ASSERT_EQUAL(1, (int)stats.get_counter("query_cache.miss")->load());
+    CPPUNIT_ASSERT_EQUAL(1, (int)cache.size());
+
+    // the same results from cache
+    auto result2 = executor->execute(*request);
+    CPPUNIT_ASSERT(result->get_results() == result2->get_results());
+    CPPUNIT_ASSERT_EQUAL(1, (int)stats.get_counter("query_cache.hit")->load());
+
+    // debug requests skip the cache
+    auto request_debug = create_request_2(*feature_spaces);
+    executor->execute(*request_debug);
+    CPPUNIT_ASSERT_EQUAL(1, (int)stats.get_counter("query_cache.hit")->load());
+    CPPUNIT_ASSERT_EQUAL(1, (int)stats.get_counter("query_cache.miss")->load());
+
+    // pending updates are not visible, cache still valid
+    index->update(create_document("00000000-0009-0000-0000-000000000000",
+        {{ feature_spaces->get_space("category"), {{"3", 10.0}}}}), 1);
+    executor->execute(*request);
+    CPPUNIT_ASSERT_EQUAL(2, (int)stats.get_counter("query_cache.hit")->load());
+
+    // applied, cache invalidated
+    index->do_maintain(0);
+    auto result3 = executor->execute(*request);
+    CPPUNIT_ASSERT_EQUAL(1, (int)stats.get_counter("query_cache.stale")->load());
+    CPPUNIT_ASSERT_EQUAL(DocId("00000000-0009-0000-0000-000000000000").to_string(), result3->get_results()[0].first);
+  }
+
+  void test_execute_batch() {
+    auto feature_spaces = create_feature_spaces();
+    auto model = create_model();
+    auto index = create_index(*feature_spaces);
+    Stats stats;
+    auto executor = SimpleQueryExecutorFactory(index.get(), model.get(), nullptr, nullptr, &stats).create_executor();
+
+    std::vector<QueryRequest> requests;
+    std::vector<std::shared_ptr<QueryRequest>> sources = {create_request_1(*feature_spaces),
+        create_request_2(*feature_spaces), create_request_3(*feature_spaces)};
+    for (auto& source: sources) {
+      requests.emplace_back(source->get_request_id(), source->get_query_count(), "");
+      requests.back().copy_features(*source);
+    }
+    auto results = executor->execute_batch(requests);
+    CPPUNIT_ASSERT_EQUAL(3, (int)results.size());
+
+    // the same results as executed one by one
+    for (size_t i = 0; i < 3; ++i) {
+      auto expected = executor->execute(requests[i]);
+      CPPUNIT_ASSERT_EQUAL(expected->get_results().size(), results[i]->get_results().size());
+      for (size_t j = 0; j < expected->get_results().size(); ++j) {
+        CPPUNIT_ASSERT_EQUAL(expected->get_results()[j].first, results[i]->get_results()[j].first);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expected->get_results()[j].second, results[i]->get_results()[j].second,
+            0.00001);
+      }
+      CPPUNIT_ASSERT(!results[i]->is_error_status());
+    }
+    CPPUNIT_ASSERT_EQUAL(3, (int)stats.get_counter("query.batch_searched")->load());
+
+    // the min score of each query
+    requests[0].set_min_score(2.6);
+    auto filtered = executor->execute_batch(requests);
+    CPPUNIT_ASSERT_EQUAL(2, (int)filtered[0]->get_results().size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, filtered[0]->get_results()[1].second, 0.00001);
+    CPPUNIT_ASSERT_EQUAL(results[1]->get_results().size(), filtered[1]->get_results().size());
+  }
+
+  void test_execute_min_score() {
+    auto feature_spaces = create_feature_spaces();
+    auto model = create_model();
+    auto index = create_index(*feature_spaces);
+    Stats stats;
+    auto executor = SimpleQueryExecutorFactory(index.get(), model.get(), nullptr, nullptr, &stats).create_executor();
+
+    // accumulated term-at-a-time
+    auto request = create_request_1(*feature_spaces);
+    request->set_min_score(2.6);
+    auto result = executor->execute(*request);
+    CPPUNIT_ASSERT_EQUAL(1, (int)stats.get_counter("query.plan.taat")->load());
+    CPPUNIT_ASSERT_EQUAL(2, (int)result->get_results().size());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, result->get_results()[1].second, 0.00001);
+
+    // read from the head of a single term
+    auto single = std::make_shared<QueryRequest>("0004", 10, "");
+    single->add_feature_vector(FeatureVector(feature_spaces->get_space("category"), {{"3", 2.0}}));
+    auto unfiltered = executor->execute(*single)->get_results();
+    CPPUNIT_ASSERT(unfiltered.size() > 1);
+    single->set_min_score(unfiltered.back().second);
+    auto filtered = executor->execute(*single)->get_results();
+    CPPUNIT_ASSERT_EQUAL(2, (int)stats.get_counter("query.plan.single")->load());
+    CPPUNIT_ASSERT(filtered.size() < unfiltered.size());
+    for (auto& r: filtered) {
+      CPPUNIT_ASSERT(r.second > unfiltered.back().second);
+    }
+  }
+
 private:
   std::shared_ptr<FeatureSpaceManager> create_feature_spaces() {
     char j[] = R"([
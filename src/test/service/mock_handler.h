@@ -3,7 +3,9 @@
 
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 #include "service/request_context.h"
 #include "service/request_handler.h"
 #include "service/response_writer.h"
@@ -26,6 +28,38 @@ public:
   }
 };
 
+// replies from another thread if the response could be deferred
+class MockDeferredHandler: public RequestHandler {
+public:
+  std::string message_;
+  std::vector<std::thread> threads_;
+
+  MockDeferredHandler(std::string message)
+  : message_(std::move(message)) {
+  }
+
+  virtual ~MockDeferredHandler() {
+    for (auto& thread: threads_) {
+      thread.join();
+    }
+  }
+
+  virtual void handle_request(const RequestContext* request, ResponseWriter* response) {
+    (void) request;
+    std::shared_ptr<ResponseWriter> deferred = response->defer();
+    if (!deferred) {
+      response->add_body("not deferred");
+      response->send(200, NULL);
+      return;
+    }
+    std::string message = message_;
+    threads_.emplace_back([deferred, message] {
+      deferred->add_body(message);
+      deferred->send(200, NULL);
+    });
+  }
+};
+
 class MockHandlerFactory: public RequestHandlerFactory {
 public:
   std::string message_;
@@ -40,6 +74,21 @@ public:
     return std::unique_ptr<RequestHandler>(new MockHandler(message_));
   }
 };
+
+class MockDeferredHandlerFactory: public RequestHandlerFactory {
+public:
+  std::string message_;
+
+  MockDeferredHandlerFactory(std::string message)
+  : message_(std::move(message)) {
+  }
+
+  virtual ~MockDeferredHandlerFactory() = default;
+
+  virtual std::unique_ptr<RequestHandler> create_handler() {
+    return std::unique_ptr<RequestHandler>(new MockDeferredHandler(message_));
+  }
+};
 } /* namespace redgiant */
 
 #endif /* SRC_TEST_SERVICE_MOCK_HANDLER_H_ */
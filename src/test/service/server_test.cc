@@ -17,6 +17,8 @@ namespace redgiant {
 class ServerTest: public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(ServerTest);
   CPPUNIT_TEST(test_server);
+  CPPUNIT_TEST(test_deferred);
+  CPPUNIT_TEST(test_reuse_port);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -80,6 +82,55 @@ protected:
     CPPUNIT_ASSERT_EQUAL(ret, 0);
   }
 
+  void test_deferred() {
+    Server server(port_, 2, 0);
+    server.bind("/test", std::make_shared<MockHandlerFactory>(message_));
+    server.bind("/deferred", std::make_shared<MockDeferredHandlerFactory>("deferred!"));
+
+    CPPUNIT_ASSERT_EQUAL(0, server.initialize());
+    server.start();
+    ScopeGuard server_guard([&server] { server.stop(); });
+
+    for (int i = 0; i < 10; ++i) {
+      TestClient client;
+      client.request("127.0.0.1", port_, EVHTTP_REQ_GET, "/deferred");
+      CPPUNIT_ASSERT_EQUAL(std::string("deferred!"), client.response());
+    }
+
+    // other requests still work
+    TestClient client;
+    client.request("127.0.0.1", port_, EVHTTP_REQ_GET, "/test");
+    CPPUNIT_ASSERT_EQUAL(message_, client.response());
+  }
+
+  void test_reuse_port() {
+    Server server(port_, 2, 0, true, true);
+    server.bind("/test", std::make_shared<MockHandlerFactory>(message_));
+
+    CPPUNIT_ASSERT_EQUAL(0, server.initialize());
+    // one socket per instance
+    CPPUNIT_ASSERT(server.fd_ > 0);
+    CPPUNIT_ASSERT_EQUAL(1, (int)server.reuse_fds_.size());
+    CPPUNIT_ASSERT(server.instances_[0]->fd_ == server.fd_);
+    CPPUNIT_ASSERT(server.instances_[1]->fd_ == server.reuse_fds_[0]);
+
+    // a server without reuse_port could not share the port
+    Server server2(port_, 1, 0);
+    CPPUNIT_ASSERT_EQUAL(-1, server2.initialize());
+
+    server.start();
+    {
+      ScopeGuard server_guard([&server] { server.stop(); });
+      for (int i = 0; i < 10; ++i) {
+        TestClient client;
+        client.request("127.0.0.1", port_, EVHTTP_REQ_GET, "/test");
+        CPPUNIT_ASSERT_EQUAL(message_, client.response());
+      }
+    }
+    CPPUNIT_ASSERT(server.fd_ < 0);
+    CPPUNIT_ASSERT(server.reuse_fds_.empty());
+  }
+
 protected:
   std::string message_ = "done!";
   int port_ = 49988;
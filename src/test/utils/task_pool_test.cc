@@ -0,0 +1,71 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "utils/concurrency/task_pool.h"
+
+namespace redgiant {
+
+class TaskPoolTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TaskPoolTest);
+  CPPUNIT_TEST(test_run);
+  CPPUNIT_TEST(test_no_threads);
+  CPPUNIT_TEST(test_concurrent_callers);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  TaskPoolTest() = default;
+  virtual ~TaskPoolTest() = default;
+
+protected:
+  void test_run() {
+    TaskPool pool(4);
+    pool.start();
+    for (int round = 0; round < 100; ++round) {
+      std::vector<int> done(32, 0);
+      pool.run(done.size(), [&done] (size_t i) { ++done[i]; });
+      // every task is run exactly once, and completed before returning
+      for (int d: done) {
+        CPPUNIT_ASSERT_EQUAL(1, d);
+      }
+    }
+    pool.stop();
+  }
+
+  void test_no_threads() {
+    // the tasks are run by the caller itself
+    TaskPool pool(0);
+    pool.start();
+    std::vector<std::thread::id> threads(8);
+    pool.run(threads.size(), [&threads] (size_t i) { threads[i] = std::this_thread::get_id(); });
+    for (auto& id: threads) {
+      CPPUNIT_ASSERT(id == std::this_thread::get_id());
+    }
+    pool.stop();
+  }
+
+  void test_concurrent_callers() {
+    TaskPool pool(2);
+    pool.start();
+    std::atomic<int> sum(0);
+    std::vector<std::thread> callers;
+    for (int c = 0; c < 4; ++c) {
+      callers.emplace_back([&pool, &sum] {
+        for (int round = 0; round < 50; ++round) {
+          pool.run(10, [&sum] (size_t i) { sum += (int)i; });
+        }
+      });
+    }
+    for (auto& caller: callers) {
+      caller.join();
+    }
+    CPPUNIT_ASSERT_EQUAL(4 * 50 * 45, sum.load());
+    pool.stop();
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TaskPoolTest);
+
+} /* namespace redgiant */